@@ -71,6 +71,7 @@ typedef struct Refresh_RenderPass Refresh_RenderPass;
 typedef struct Refresh_ComputePipeline Refresh_ComputePipeline;
 typedef struct Refresh_GraphicsPipeline Refresh_GraphicsPipeline;
 typedef struct Refresh_CommandBuffer Refresh_CommandBuffer;
+typedef struct Refresh_BufferReadback Refresh_BufferReadback;
 
 typedef enum Refresh_PresentMode
 {
@@ -180,11 +181,21 @@ typedef enum Refresh_BufferUsageFlagBits
 {
 	REFRESH_BUFFERUSAGE_VERTEX_BIT 	=	0x00000001,
 	REFRESH_BUFFERUSAGE_INDEX_BIT  	=	0x00000002,
-	REFRESH_BUFFERUSAGE_COMPUTE_BIT =	0x00000004
+	REFRESH_BUFFERUSAGE_COMPUTE_BIT =	0x00000004,
+	REFRESH_BUFFERUSAGE_STATIC_BIT  =	0x00000008, /* device local, see Refresh_SetBufferData */
+	REFRESH_BUFFERUSAGE_READBACK_BIT =	0x00000010, /* host cached, see Refresh_GetBufferData */
+	REFRESH_BUFFERUSAGE_INDIRECT_BIT =	0x00000020 /* draw/dispatch arguments, see Refresh_DrawPrimitivesIndirect */
 } Refresh_BufferUsageFlagBits;
 
 typedef uint32_t Refresh_BufferUsageFlags;
 
+typedef enum Refresh_SetDataOptions
+{
+	REFRESH_SETDATAOPTIONS_NONE,
+	REFRESH_SETDATAOPTIONS_DISCARD,
+	REFRESH_SETDATAOPTIONS_NOOVERWRITE
+} Refresh_SetDataOptions;
+
 typedef enum Refresh_VertexElementFormat
 {
 	REFRESH_VERTEXELEMENTFORMAT_SINGLE,
@@ -317,7 +328,8 @@ typedef uint32_t Refresh_ColorComponentFlags;
 typedef enum Refresh_ShaderStageType
 {
 	REFRESH_SHADERSTAGE_VERTEX,
-	REFRESH_SHADERSTAGE_FRAGMENT
+	REFRESH_SHADERSTAGE_FRAGMENT,
+	REFRESH_SHADERSTAGE_COMPUTE
 } Refresh_ShaderStageType;
 
 typedef enum Refresh_Filter
@@ -352,6 +364,12 @@ typedef enum Refresh_BorderColor
     REFRESH_BORDERCOLOR_INT_OPAQUE_WHITE = 5
 } Refresh_BorderColor;
 
+typedef enum Refresh_MemoryPlacementPolicy
+{
+    REFRESH_MEMORYPLACEMENTPOLICY_BESTFIT,
+    REFRESH_MEMORYPLACEMENTPOLICY_GOODFIT
+} Refresh_MemoryPlacementPolicy;
+
 /* Structures */
 
 typedef struct Refresh_DepthStencilValue
@@ -395,12 +413,91 @@ typedef struct Refresh_TextureSlice
 	uint32_t level;
 } Refresh_TextureSlice;
 
+typedef struct Refresh_BufferCopy
+{
+	uint32_t srcOffset;
+	uint32_t dstOffset;
+	uint32_t size;
+} Refresh_BufferCopy;
+
+/* Argument layouts read by the indirect draw and dispatch commands. */
+
+typedef struct Refresh_IndirectDrawCommand
+{
+	uint32_t vertexCount;
+	uint32_t instanceCount;
+	uint32_t firstVertex;
+	uint32_t firstInstance;
+} Refresh_IndirectDrawCommand;
+
+typedef struct Refresh_IndexedIndirectDrawCommand
+{
+	uint32_t indexCount;
+	uint32_t instanceCount;
+	uint32_t firstIndex;
+	int32_t vertexOffset;
+	uint32_t firstInstance;
+} Refresh_IndexedIndirectDrawCommand;
+
+typedef struct Refresh_IndirectDispatchCommand
+{
+	uint32_t groupCountX;
+	uint32_t groupCountY;
+	uint32_t groupCountZ;
+} Refresh_IndirectDispatchCommand;
+
+typedef struct Refresh_IndexedDraw
+{
+	uint32_t baseVertex;
+	uint32_t startIndex;
+	uint32_t primitiveCount;
+	uint32_t instanceCount;
+	uint32_t vertexParamOffset; /* returned by Refresh_PushVertexShaderUniforms */
+	uint32_t fragmentParamOffset; /* returned by Refresh_PushFragmentShaderUniforms */
+} Refresh_IndexedDraw;
+
 typedef struct Refresh_PresentationParameters
 {
 	void* deviceWindowHandle;
 	Refresh_PresentMode presentMode;
+	uint32_t framesInFlight; /* 2 to 4, 0 for the default of 2 */
+	uint8_t bindless; /* Request the global texture/sampler arrays */
 } Refresh_PresentationParameters;
 
+/* Returned by the bindless index queries when a resource has no index */
+#define REFRESH_BINDLESS_INDEX_NONE 0xFFFFFFFF
+
+typedef struct Refresh_MemoryFragmentationStats
+{
+	uint32_t memoryTypeIndex;
+	uint32_t blockCount;
+	uint64_t totalBlockBytes;
+	uint64_t totalFreeBytes;
+	uint64_t largestFreeBlock;
+	uint32_t freeRegionCount;
+	float externalFragmentation; /* 1 - largestFreeBlock / totalFreeBytes */
+} Refresh_MemoryFragmentationStats;
+
+typedef struct Refresh_MemoryHeapStats
+{
+	uint32_t heapIndex;
+	uint8_t deviceLocal;
+	uint64_t budget; /* from the driver if supported, else the heap size */
+	uint64_t usage; /* from the driver if supported, else allocatedBytes */
+	uint32_t blockCount;
+	uint64_t allocatedBytes; /* device memory allocated by Refresh */
+	uint64_t textureBytes;
+	uint64_t bufferBytes;
+} Refresh_MemoryHeapStats;
+
+typedef struct Refresh_CommandBufferStats
+{
+	uint32_t pipelineBindsElided;
+	uint32_t vertexBufferBindsElided; /* per binding */
+	uint32_t indexBufferBindsElided;
+	uint32_t descriptorSetBindsElided; /* per set */
+} Refresh_CommandBufferStats;
+
 /* State structures */
 
 typedef struct Refresh_SamplerStateCreateInfo
@@ -471,12 +568,15 @@ typedef struct Refresh_ComputePipelineLayoutCreateInfo
 {
 	uint32_t bufferBindingCount;
 	uint32_t imageBindingCount;
+	uint32_t pushConstantSize; /* in bytes, multiple of 4, 0 if unused */
 } Refresh_ComputePipelineLayoutCreateInfo;
 
 typedef struct Refresh_GraphicsPipelineLayoutCreateInfo
 {
 	uint32_t vertexSamplerBindingCount;
 	uint32_t fragmentSamplerBindingCount;
+	uint32_t vertexPushConstantSize; /* in bytes, multiple of 4, 0 if unused */
+	uint32_t fragmentPushConstantSize; /* in bytes, multiple of 4, 0 if unused */
 } Refresh_GraphicsPipelineLayoutCreateInfo;
 
 typedef struct Refresh_ColorTargetDescription
@@ -700,6 +800,12 @@ REFRESHAPI void Refresh_HookLogFunctions(
  *
  * presentationParameters:
  * 		If the windowHandle is NULL, Refresh will run in headless mode.
+ * 		framesInFlight is how many submissions the CPU may queue ahead
+ * 		of the GPU. More frames absorb frame time spikes at the cost
+ * 		of latency and per-frame memory.
+ * 		If bindless is set and the device supports descriptor indexing,
+ * 		every sampled texture and every sampler is also written into a
+ * 		global array. See Refresh_GetTextureBindlessIndex.
  * debugMode: Enable debug mode properties.
  */
 REFRESHAPI Refresh_Device* Refresh_CreateDevice(
@@ -754,8 +860,8 @@ REFRESHAPI void Refresh_Clear(
  * startIndex:			The starting offset to read from the index buffer.
  * primitiveCount:		The number of primitives to draw.
  * instanceCount:		The number of instances that will be drawn.
- * vertexParamOffset:	The offset of the vertex shader param data.
- * fragmentParamOffset:	The offset of the fragment shader param data.
+ * vertexParamOffset:	Returned by Refresh_PushVertexShaderUniforms.
+ * fragmentParamOffset:	Returned by Refresh_PushFragmentShaderUniforms.
  */
 REFRESHAPI void Refresh_DrawInstancedPrimitives(
 	Refresh_Device *device,
@@ -773,8 +879,8 @@ REFRESHAPI void Refresh_DrawInstancedPrimitives(
  * baseVertex:			The starting offset to read from the vertex buffer.
  * startIndex:			The starting offset to read from the index buffer.
  * primitiveCount:		The number of primitives to draw.
- * vertexParamOffset:	The offset of the vertex shader param data.
- * fragmentParamOffset:	The offset of the fragment shader param data.
+ * vertexParamOffset:	Returned by Refresh_PushVertexShaderUniforms.
+ * fragmentParamOffset:	Returned by Refresh_PushFragmentShaderUniforms.
  */
 REFRESHAPI void Refresh_DrawIndexedPrimitives(
 	Refresh_Device *device,
@@ -786,12 +892,30 @@ REFRESHAPI void Refresh_DrawIndexedPrimitives(
 	uint32_t fragmentParamOffset
 );
 
+/* Draws a list of indexed draws from the bound vertex/index buffers.
+ * Equivalent to calling Refresh_DrawInstancedPrimitives for each element,
+ * with less overhead per draw.
+ *
+ * draws:		The draws to execute, in order.
+ * drawCount:	The number of elements in draws.
+ *
+ * NOTE:
+ * 		Consecutive draws sharing uniform offsets and instance count
+ * 		are submitted together when the device supports it.
+ */
+REFRESHAPI void Refresh_DrawIndexedPrimitivesBatch(
+	Refresh_Device *device,
+	Refresh_CommandBuffer *commandBuffer,
+	const Refresh_IndexedDraw *draws,
+	uint32_t drawCount
+);
+
 /* Draws data from vertex buffers.
  *
  * vertexStart:				The starting offset to read from the vertex buffer.
  * primitiveCount:			The number of primitives to draw.
- * vertexParamOffset:		The offset of the vertex shader param data.
- * fragmentParamOffset:		The offset of the fragment shader param data.
+ * vertexParamOffset:		Returned by Refresh_PushVertexShaderUniforms.
+ * fragmentParamOffset:		Returned by Refresh_PushFragmentShaderUniforms.
  */
 REFRESHAPI void Refresh_DrawPrimitives(
 	Refresh_Device *device,
@@ -802,12 +926,64 @@ REFRESHAPI void Refresh_DrawPrimitives(
 	uint32_t fragmentParamOffset
 );
 
+/* Draws data from vertex/index buffers, reading the draw parameters
+ * from a buffer of Refresh_IndexedIndirectDrawCommand structures.
+ *
+ * buffer:				The buffer containing the draw parameters.
+ * offsetInBytes:		The offset of the first command in the buffer.
+ * drawCount:			The number of draws to execute.
+ * stride:				The byte stride between commands.
+ * vertexParamOffset:	Returned by Refresh_PushVertexShaderUniforms.
+ * fragmentParamOffset:	Returned by Refresh_PushFragmentShaderUniforms.
+ *
+ * NOTE:
+ * 		The buffer must be created with REFRESH_BUFFERUSAGE_INDIRECT_BIT.
+ * 		offsetInBytes and stride must be multiples of 4, and stride must
+ * 		be at least the size of the command structure.
+ * 		Arguments written on the GPU must be written before the
+ * 		render pass begins.
+ */
+REFRESHAPI void Refresh_DrawIndexedPrimitivesIndirect(
+	Refresh_Device *device,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_Buffer *buffer,
+	uint32_t offsetInBytes,
+	uint32_t drawCount,
+	uint32_t stride,
+	uint32_t vertexParamOffset,
+	uint32_t fragmentParamOffset
+);
+
+/* Draws data from vertex buffers, reading the draw parameters
+ * from a buffer of Refresh_IndirectDrawCommand structures.
+ *
+ * buffer:				The buffer containing the draw parameters.
+ * offsetInBytes:		The offset of the first command in the buffer.
+ * drawCount:			The number of draws to execute.
+ * stride:				The byte stride between commands.
+ * vertexParamOffset:	Returned by Refresh_PushVertexShaderUniforms.
+ * fragmentParamOffset:	Returned by Refresh_PushFragmentShaderUniforms.
+ *
+ * NOTE:
+ * 		Same requirements as Refresh_DrawIndexedPrimitivesIndirect.
+ */
+REFRESHAPI void Refresh_DrawPrimitivesIndirect(
+	Refresh_Device *device,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_Buffer *buffer,
+	uint32_t offsetInBytes,
+	uint32_t drawCount,
+	uint32_t stride,
+	uint32_t vertexParamOffset,
+	uint32_t fragmentParamOffset
+);
+
 /* Dispatches work compute items.
  *
  * groupCountX:			Number of local workgroups to dispatch in the X dimension.
  * groupCountY:			Number of local workgroups to dispatch in the Y dimension.
  * groupCountZ:			Number of local workgroups to dispatch in the Z dimension.
- * computeParamOffset:	The offset of the compute shader param data.
+ * computeParamOffset:	Returned by Refresh_PushComputeShaderUniforms.
  */
 REFRESHAPI void Refresh_DispatchCompute(
 	Refresh_Device *device,
@@ -818,6 +994,25 @@ REFRESHAPI void Refresh_DispatchCompute(
 	uint32_t computeParamOffset
 );
 
+/* Dispatches work compute items, reading the group counts
+ * from a Refresh_IndirectDispatchCommand in a buffer.
+ *
+ * buffer:				The buffer containing the dispatch parameters.
+ * offsetInBytes:		The offset of the command in the buffer.
+ * computeParamOffset:	Returned by Refresh_PushComputeShaderUniforms.
+ *
+ * NOTE:
+ * 		The buffer must be created with REFRESH_BUFFERUSAGE_INDIRECT_BIT.
+ * 		offsetInBytes must be a multiple of 4.
+ */
+REFRESHAPI void Refresh_DispatchComputeIndirect(
+	Refresh_Device *device,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_Buffer *buffer,
+	uint32_t offsetInBytes,
+	uint32_t computeParamOffset
+);
+
 /* State Creation */
 
 /* Returns an allocated RenderPass* object. */
@@ -956,12 +1151,61 @@ REFRESHAPI void Refresh_CopyTextureToBuffer(
 	Refresh_Buffer *buffer
 );
 
+/* Copies regions of one buffer into another on the GPU.
+ *
+ * NOTE:
+ * 	Cannot be called during a render pass.
+ * 	Regions must be non-empty and lie within both buffers.
+ * 	If source and destination are the same buffer, no source
+ * 	range may overlap any destination range; such copies are
+ * 	rejected.
+ *
+ * source:		The buffer being copied from.
+ * destination:	The buffer being copied to.
+ * pRegions:	An array of byte ranges to copy.
+ * regionCount:	The number of elements in pRegions.
+ */
+REFRESHAPI void Refresh_CopyBufferToBuffer(
+	Refresh_Device *device,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_Buffer *source,
+	Refresh_Buffer *destination,
+	Refresh_BufferCopy *pRegions,
+	uint32_t regionCount
+);
+
+/* Fills a range of a buffer with a repeated 32-bit value on the GPU.
+ *
+ * NOTE:
+ * 	Cannot be called during a render pass.
+ * 	offsetInBytes and sizeInBytes must be multiples of 4,
+ * 	and sizeInBytes must not be zero.
+ *
+ * buffer:			The buffer being filled.
+ * offsetInBytes:	The starting offset of the range.
+ * sizeInBytes:		The length of the range.
+ * data:			The value written to each 4 bytes of the range.
+ */
+REFRESHAPI void Refresh_FillBuffer(
+	Refresh_Device *device,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_Buffer *buffer,
+	uint32_t offsetInBytes,
+	uint32_t sizeInBytes,
+	uint32_t data
+);
+
 /* Sets a region of the buffer with client data.
  *
  * NOTE:
  * 		Calling this function on a buffer after the buffer
  * 		has been bound without calling Submit first is an error.
  *
+ * 		Buffers created with REFRESH_BUFFERUSAGE_STATIC_BIT live in
+ * 		device local memory. The data is staged and copied on the GPU
+ * 		before the next submitted commands, which is cheaper to draw
+ * 		from but more expensive to update than the default.
+ *
  * buffer:			The vertex buffer to be updated.
  * offsetInBytes:	The starting offset of the buffer to write into.
  * data:			The client data to write into the buffer.
@@ -975,8 +1219,63 @@ REFRESHAPI void Refresh_SetBufferData(
 	uint32_t dataLength
 );
 
+/* Sets a region of the buffer with client data, allowing writes to a
+ * buffer that has been bound since the last Submit.
+ *
+ * options:
+ * 		NONE:		Same as Refresh_SetBufferData.
+ * 		DISCARD:	The previous contents are no longer needed. Writes
+ * 				go to a fresh copy of the buffer, and commands that
+ * 				are already recorded keep reading the old one. The
+ * 				pool of copies grows as needed and copies are reused
+ * 				once the GPU is done with them.
+ * 		NOOVERWRITE:	The client guarantees it is not writing over data
+ * 				that recorded commands may still read, e.g. when
+ * 				appending. No copy is made.
+ *
+ * NOTE:
+ * 		Static buffers can't be renamed, so after binding they
+ * 		only accept NOOVERWRITE.
+ */
+REFRESHAPI void Refresh_SetBufferDataWithOptions(
+	Refresh_Device *device,
+	Refresh_Buffer *buffer,
+	uint32_t offsetInBytes,
+	void* data,
+	uint32_t dataLength,
+	Refresh_SetDataOptions options
+);
+
+/* Returns a pointer to the buffer memory so the client can write into it
+ * directly, e.g. to generate vertices without an intermediate copy.
+ * Returns NULL on failure.
+ *
+ * options:	Same meaning as in Refresh_SetBufferDataWithOptions.
+ * 		DISCARD returns a pointer to a fresh copy of the buffer
+ * 		with undefined contents.
+ *
+ * NOTE:
+ * 		Static buffers can't be mapped.
+ * 		The pointer is only valid until Refresh_UnmapBuffer is called.
+ * 		The buffer must be unmapped before Refresh_Submit.
+ * 		Devices created in debug mode log an error otherwise.
+ */
+REFRESHAPI void* Refresh_MapBuffer(
+	Refresh_Device *device,
+	Refresh_Buffer *buffer,
+	Refresh_SetDataOptions options
+);
+
+/* Ends a write started with Refresh_MapBuffer. */
+REFRESHAPI void Refresh_UnmapBuffer(
+	Refresh_Device *device,
+	Refresh_Buffer *buffer
+);
+
 /* Pushes vertex shader params to the device.
- * Returns a starting offset value to be used with draw calls.
+ * Returns an opaque value to pass as the vertex param offset of the
+ * draw calls that read these params. It identifies the memory the params
+ * were written to and must not be used in arithmetic.
  *
  * NOTE:
  * 		A pipeline must be bound.
@@ -993,7 +1292,9 @@ REFRESHAPI uint32_t Refresh_PushVertexShaderUniforms(
 );
 
 /* Pushes fragment shader params to the device.
- * Returns a starting offset value to be used with draw calls.
+ * Returns an opaque value to pass as the fragment param offset of the
+ * draw calls that read these params. It identifies the memory the params
+ * were written to and must not be used in arithmetic.
  *
  * NOTE:
  * 		A graphics pipeline must be bound.
@@ -1010,7 +1311,9 @@ REFRESHAPI uint32_t Refresh_PushFragmentShaderUniforms(
 );
 
 /* Pushes compute shader params to the device.
- * Returns a starting offset value to be used with draw calls.
+ * Returns an opaque value to pass as the compute param offset of the
+ * dispatch calls that read these params. It identifies the memory the params
+ * were written to and must not be used in arithmetic.
  *
  * NOTE:
  * 	A compute pipeline must be bound.
@@ -1026,11 +1329,42 @@ REFRESHAPI uint32_t Refresh_PushComputeShaderUniforms(
 	uint32_t dataLengthInBytes
 );
 
+/* Records push constant data directly into the command buffer.
+ * Unlike the Push*ShaderUniforms functions, this takes no lock and
+ * does not touch the uniform buffers, so it is the fastest way to
+ * update small per-draw data.
+ *
+ * NOTE:
+ * 		A pipeline for the given stage must be bound.
+ * 		The pipeline layout must declare a push constant block for
+ * 		the stage, and the data must fit in it.
+ * 		In GLSL the fragment block starts at an offset equal to
+ * 		vertexPushConstantSize, the vertex and compute blocks at 0.
+ * 		The total push constant size of a pipeline is limited by the
+ * 		device, 128 bytes is always guaranteed.
+ *
+ * stage:				The shader stage whose push constant block to update.
+ * data:				The client data to record.
+ * dataLengthInBytes:	The length of the data, a nonzero multiple of 4.
+ */
+REFRESHAPI void Refresh_PushConstants(
+	Refresh_Device *device,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_ShaderStageType stage,
+	void *data,
+	uint32_t dataLengthInBytes
+);
+
 /* Getters */
 
 /* Synchronously copies data from a buffer to a pointer.
  * You probably want to wait for a sync point to call this.
  *
+ * NOTE:
+ * 		Buffers created with REFRESH_BUFFERUSAGE_READBACK_BIT live in
+ * 		host cached memory, which is much faster to read from but
+ * 		slower for the GPU to access.
+ *
  * buffer: 				The buffer to copy data from.
  * data:				The pointer to copy data to.
  * dataLengthInBytes:	The length of data to copy.
@@ -1042,6 +1376,42 @@ REFRESHAPI void Refresh_GetBufferData(
 	uint32_t dataLengthInBytes
 );
 
+/* Records a copy of buffer data into host memory without stalling.
+ * The copy executes in command order, so it sees the results of earlier
+ * commands such as compute dispatches.
+ * Returns a readback handle, or NULL on failure.
+ *
+ * NOTE:
+ * 		Cannot be called during a render pass.
+ * 		The handle must be passed to Refresh_QueryBufferReadback
+ * 		until it completes, which releases it.
+ *
+ * commandBuffer:		The command buffer to record the copy into.
+ * buffer:				The buffer to copy data from.
+ * offsetInBytes:		The starting offset of the data in the buffer.
+ * dataLengthInBytes:	The length of data to copy. Must not be zero.
+ */
+REFRESHAPI Refresh_BufferReadback* Refresh_GetBufferDataAsync(
+	Refresh_Device *device,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_Buffer *buffer,
+	uint32_t offsetInBytes,
+	uint32_t dataLengthInBytes
+);
+
+/* Checks whether the GPU has finished a readback, without blocking.
+ * Returns 1 and copies the data if it has, after which the handle is
+ * invalid. Returns 0 if the readback is still in flight.
+ *
+ * readback:	A handle from Refresh_GetBufferDataAsync.
+ * data:		The pointer to copy data to.
+ */
+REFRESHAPI uint8_t Refresh_QueryBufferReadback(
+	Refresh_Device *device,
+	Refresh_BufferReadback *readback,
+	void *data
+);
+
 /* Disposal */
 
 /* Sends a texture to be destroyed by the renderer. Note that we call it
@@ -1296,6 +1666,19 @@ REFRESHAPI Refresh_CommandBuffer* Refresh_AcquireCommandBuffer(
 	uint8_t fixed
 );
 
+/* Reports how many binds were skipped because the same state was
+ * already bound in this command buffer. Counters start at zero when
+ * the command buffer is acquired.
+ *
+ * NOTE:
+ * 		Must be called before the command buffer is submitted.
+ */
+REFRESHAPI void Refresh_GetCommandBufferStats(
+	Refresh_Device *device,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_CommandBufferStats *stats
+);
+
 /* Queues an image to be presented to the screen.
  * The image will be presented upon the next Refresh_Submit call.
  *
@@ -1326,13 +1709,129 @@ REFRESHAPI void Refresh_Wait(
 	Refresh_Device *device
 );
 
-/* Export handles to be consumed by another API */
+/* Export handles to be consumed by another API.
+ *
+ * NOTE:
+ * 	Once exported, the texture is never moved by memory defragmentation,
+ * 	so the handles stay valid for the lifetime of the texture.
+ */
 REFRESHAPI void Refresh_GetTextureHandles(
 	Refresh_Device* device,
 	Refresh_Texture* texture,
 	Refresh_TextureHandles* handles
 );
 
+/* Bindless */
+
+/* Returns the index of a texture in the global texture array, or
+ * REFRESH_BINDLESS_INDEX_NONE if the device was created without bindless
+ * support, the texture was not created with REFRESH_TEXTUREUSAGE_SAMPLER_BIT,
+ * or the array was full. The index is stable for the lifetime of the texture.
+ *
+ * NOTE:
+ * 		The global arrays are bound after every other descriptor set,
+ * 		at set 4 for graphics pipelines and set 3 for compute pipelines.
+ * 		Binding 0 is an array of sampled images and binding 1 is an
+ * 		array of samplers. Pass indices to shaders through push constants
+ * 		or uniforms, and use nonuniformEXT when an index may diverge.
+ *
+ * 		The texture must be in a sampled state whenever a shader reads it,
+ * 		exactly as if it had been bound with Refresh_BindFragmentSamplers.
+ */
+REFRESHAPI uint32_t Refresh_GetTextureBindlessIndex(
+	Refresh_Device *device,
+	Refresh_Texture *texture
+);
+
+/* Returns the index of a sampler in the global sampler array, or
+ * REFRESH_BINDLESS_INDEX_NONE if the device was created without bindless
+ * support or the array was full. The index is stable for the lifetime of
+ * the sampler.
+ */
+REFRESHAPI uint32_t Refresh_GetSamplerBindlessIndex(
+	Refresh_Device *device,
+	Refresh_Sampler *sampler
+);
+
+/* Memory Management */
+
+/* Selects how device memory allocations are placed into existing blocks.
+ *
+ * BESTFIT:	Uses the smallest free region that fits. Keeps large
+ * 		holes intact for large resources at a small search cost.
+ * GOODFIT:	Uses the first region of a large enough size class.
+ * 		Constant time, but may split holes that are larger than needed.
+ *
+ * The default is BESTFIT.
+ */
+REFRESHAPI void Refresh_SetMemoryPlacementPolicy(
+	Refresh_Device *device,
+	Refresh_MemoryPlacementPolicy policy
+);
+
+/* Enables or disables incremental memory defragmentation.
+ *
+ * When enabled, each Refresh_Submit moves a bounded amount of resources
+ * out of sparsely used memory blocks so the blocks can be released.
+ * Moving a resource replaces its underlying handles and costs GPU copy
+ * time in the following frame.
+ *
+ * The default is disabled.
+ */
+REFRESHAPI void Refresh_SetMemoryDefragmentation(
+	Refresh_Device *device,
+	uint8_t enabled
+);
+
+/* Reports fragmentation of device memory blocks, one entry per memory type
+ * that has at least one block.
+ *
+ * pStats:	An array to fill, or NULL to only query the entry count.
+ * pCount:	On input, the capacity of pStats. On output, the number of
+ * 		entries written, or the number available if pStats is NULL.
+ */
+REFRESHAPI void Refresh_GetMemoryFragmentationStats(
+	Refresh_Device *device,
+	Refresh_MemoryFragmentationStats *pStats,
+	uint32_t *pCount
+);
+
+/* Reports budget and usage of each memory heap. When VK_EXT_memory_budget
+ * is available the driver's numbers are used, which include memory held
+ * by other processes and by the driver itself.
+ *
+ * pStats:	An array to fill, or NULL to only query the heap count.
+ * pCount:	On input, the capacity of pStats. On output, the number of
+ * 		entries written, or the number of heaps if pStats is NULL.
+ */
+REFRESHAPI void Refresh_GetMemoryStats(
+	Refresh_Device *device,
+	Refresh_MemoryHeapStats *pStats,
+	uint32_t *pCount
+);
+
+typedef void (REFRESHCALL * Refresh_MemoryBudgetFunc)(
+	void *userdata,
+	uint32_t heapIndex,
+	uint64_t usage,
+	uint64_t budget
+);
+
+/* Registers a function that is called from Refresh_Submit when a heap's
+ * usage rises above a fraction of its budget. It fires once per crossing
+ * and is armed again after usage drops back under the threshold.
+ *
+ * threshold:	Fraction of the budget, e.g. 0.9f.
+ * callback:	The function to call, or NULL to disable.
+ * userdata:	Passed through to the callback.
+ */
+REFRESHAPI void Refresh_SetMemoryBudgetCallback(
+	Refresh_Device *device,
+	float threshold,
+	Refresh_MemoryBudgetFunc callback,
+	void *userdata
+);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
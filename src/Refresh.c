@@ -232,6 +232,21 @@ void Refresh_DrawInstancedPrimitives(
     );
 }
 
+void Refresh_DrawIndexedPrimitivesBatch(
+	Refresh_Device *device,
+	Refresh_CommandBuffer *commandBuffer,
+	const Refresh_IndexedDraw *draws,
+	uint32_t drawCount
+) {
+    NULL_RETURN(device);
+    device->DrawIndexedPrimitivesBatch(
+        device->driverData,
+        commandBuffer,
+        draws,
+        drawCount
+    );
+}
+
 void Refresh_DrawPrimitives(
 	Refresh_Device *device,
     Refresh_CommandBuffer *commandBuffer,
@@ -251,6 +266,52 @@ void Refresh_DrawPrimitives(
     );
 }
 
+void Refresh_DrawIndexedPrimitivesIndirect(
+	Refresh_Device *device,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_Buffer *buffer,
+	uint32_t offsetInBytes,
+	uint32_t drawCount,
+	uint32_t stride,
+	uint32_t vertexParamOffset,
+	uint32_t fragmentParamOffset
+) {
+    NULL_RETURN(device);
+    device->DrawIndexedPrimitivesIndirect(
+        device->driverData,
+        commandBuffer,
+        buffer,
+        offsetInBytes,
+        drawCount,
+        stride,
+        vertexParamOffset,
+        fragmentParamOffset
+    );
+}
+
+void Refresh_DrawPrimitivesIndirect(
+	Refresh_Device *device,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_Buffer *buffer,
+	uint32_t offsetInBytes,
+	uint32_t drawCount,
+	uint32_t stride,
+	uint32_t vertexParamOffset,
+	uint32_t fragmentParamOffset
+) {
+    NULL_RETURN(device);
+    device->DrawPrimitivesIndirect(
+        device->driverData,
+        commandBuffer,
+        buffer,
+        offsetInBytes,
+        drawCount,
+        stride,
+        vertexParamOffset,
+        fragmentParamOffset
+    );
+}
+
 void Refresh_DispatchCompute(
     Refresh_Device *device,
     Refresh_CommandBuffer *commandBuffer,
@@ -270,6 +331,23 @@ void Refresh_DispatchCompute(
     );
 }
 
+void Refresh_DispatchComputeIndirect(
+	Refresh_Device *device,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_Buffer *buffer,
+	uint32_t offsetInBytes,
+	uint32_t computeParamOffset
+) {
+    NULL_RETURN(device);
+    device->DispatchComputeIndirect(
+        device->driverData,
+        commandBuffer,
+        buffer,
+        offsetInBytes,
+        computeParamOffset
+    );
+}
+
 Refresh_RenderPass* Refresh_CreateRenderPass(
 	Refresh_Device *device,
 	Refresh_RenderPassCreateInfo *renderPassCreateInfo
@@ -447,6 +525,44 @@ void Refresh_CopyTextureToBuffer(
     );
 }
 
+void Refresh_CopyBufferToBuffer(
+	Refresh_Device *device,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_Buffer *source,
+	Refresh_Buffer *destination,
+	Refresh_BufferCopy *pRegions,
+	uint32_t regionCount
+) {
+    NULL_RETURN(device);
+    device->CopyBufferToBuffer(
+        device->driverData,
+        commandBuffer,
+        source,
+        destination,
+        pRegions,
+        regionCount
+    );
+}
+
+void Refresh_FillBuffer(
+	Refresh_Device *device,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_Buffer *buffer,
+	uint32_t offsetInBytes,
+	uint32_t sizeInBytes,
+	uint32_t data
+) {
+    NULL_RETURN(device);
+    device->FillBuffer(
+        device->driverData,
+        commandBuffer,
+        buffer,
+        offsetInBytes,
+        sizeInBytes,
+        data
+    );
+}
+
 void Refresh_SetBufferData(
 	Refresh_Device *device,
 	Refresh_Buffer *buffer,
@@ -464,6 +580,49 @@ void Refresh_SetBufferData(
     );
 }
 
+void Refresh_SetBufferDataWithOptions(
+	Refresh_Device *device,
+	Refresh_Buffer *buffer,
+	uint32_t offsetInBytes,
+	void* data,
+	uint32_t dataLength,
+	Refresh_SetDataOptions options
+) {
+    NULL_RETURN(device);
+    device->SetBufferDataWithOptions(
+        device->driverData,
+        buffer,
+        offsetInBytes,
+        data,
+        dataLength,
+        options
+    );
+}
+
+void* Refresh_MapBuffer(
+	Refresh_Device *device,
+	Refresh_Buffer *buffer,
+	Refresh_SetDataOptions options
+) {
+    NULL_RETURN_NULL(device);
+    return device->MapBuffer(
+        device->driverData,
+        buffer,
+        options
+    );
+}
+
+void Refresh_UnmapBuffer(
+	Refresh_Device *device,
+	Refresh_Buffer *buffer
+) {
+    NULL_RETURN(device);
+    device->UnmapBuffer(
+        device->driverData,
+        buffer
+    );
+}
+
 uint32_t Refresh_PushVertexShaderUniforms(
 	Refresh_Device *device,
     Refresh_GraphicsPipeline *pipeline,
@@ -509,6 +668,23 @@ uint32_t Refresh_PushComputeShaderUniforms(
     );
 }
 
+void Refresh_PushConstants(
+	Refresh_Device *device,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_ShaderStageType stage,
+	void *data,
+	uint32_t dataLengthInBytes
+) {
+    NULL_RETURN(device);
+    device->PushConstants(
+        device->driverData,
+        commandBuffer,
+        stage,
+        data,
+        dataLengthInBytes
+    );
+}
+
 void Refresh_BindVertexSamplers(
 	Refresh_Device *device,
     Refresh_CommandBuffer *commandBuffer,
@@ -554,6 +730,36 @@ void Refresh_GetBufferData(
     );
 }
 
+Refresh_BufferReadback* Refresh_GetBufferDataAsync(
+    Refresh_Device *device,
+    Refresh_CommandBuffer *commandBuffer,
+    Refresh_Buffer *buffer,
+    uint32_t offsetInBytes,
+    uint32_t dataLengthInBytes
+) {
+    NULL_RETURN_NULL(device);
+    return device->GetBufferDataAsync(
+        device->driverData,
+        commandBuffer,
+        buffer,
+        offsetInBytes,
+        dataLengthInBytes
+    );
+}
+
+uint8_t Refresh_QueryBufferReadback(
+    Refresh_Device *device,
+    Refresh_BufferReadback *readback,
+    void *data
+) {
+    if (device == NULL) { return 0; }
+    return device->QueryBufferReadback(
+        device->driverData,
+        readback,
+        data
+    );
+}
+
 void Refresh_QueueDestroyTexture(
 	Refresh_Device *device,
 	Refresh_Texture *texture
@@ -786,6 +992,19 @@ Refresh_CommandBuffer* Refresh_AcquireCommandBuffer(
     );
 }
 
+void Refresh_GetCommandBufferStats(
+    Refresh_Device *device,
+    Refresh_CommandBuffer *commandBuffer,
+    Refresh_CommandBufferStats *stats
+) {
+    NULL_RETURN(device);
+    device->GetCommandBufferStats(
+        device->driverData,
+        commandBuffer,
+        stats
+    );
+}
+
 void Refresh_QueuePresent(
     Refresh_Device *device,
     Refresh_CommandBuffer *commandBuffer,
@@ -838,4 +1057,89 @@ void Refresh_GetTextureHandles(
     );
 }
 
+uint32_t Refresh_GetTextureBindlessIndex(
+    Refresh_Device *device,
+    Refresh_Texture *texture
+) {
+    if (device == NULL) { return REFRESH_BINDLESS_INDEX_NONE; }
+    return device->GetTextureBindlessIndex(
+        device->driverData,
+        texture
+    );
+}
+
+uint32_t Refresh_GetSamplerBindlessIndex(
+    Refresh_Device *device,
+    Refresh_Sampler *sampler
+) {
+    if (device == NULL) { return REFRESH_BINDLESS_INDEX_NONE; }
+    return device->GetSamplerBindlessIndex(
+        device->driverData,
+        sampler
+    );
+}
+
+void Refresh_SetMemoryPlacementPolicy(
+    Refresh_Device *device,
+    Refresh_MemoryPlacementPolicy policy
+) {
+    NULL_RETURN(device);
+    device->SetMemoryPlacementPolicy(
+        device->driverData,
+        policy
+    );
+}
+
+void Refresh_SetMemoryDefragmentation(
+    Refresh_Device *device,
+    uint8_t enabled
+) {
+    NULL_RETURN(device);
+    device->SetMemoryDefragmentation(
+        device->driverData,
+        enabled
+    );
+}
+
+void Refresh_GetMemoryFragmentationStats(
+    Refresh_Device *device,
+    Refresh_MemoryFragmentationStats *pStats,
+    uint32_t *pCount
+) {
+    NULL_RETURN(device);
+    device->GetMemoryFragmentationStats(
+        device->driverData,
+        pStats,
+        pCount
+    );
+}
+
+void Refresh_GetMemoryStats(
+    Refresh_Device *device,
+    Refresh_MemoryHeapStats *pStats,
+    uint32_t *pCount
+) {
+    NULL_RETURN(device);
+    device->GetMemoryStats(
+        device->driverData,
+        pStats,
+        pCount
+    );
+}
+
+void Refresh_SetMemoryBudgetCallback(
+    Refresh_Device *device,
+    float threshold,
+    Refresh_MemoryBudgetFunc callback,
+    void *userdata
+) {
+    NULL_RETURN(device);
+    device->SetMemoryBudgetCallback(
+        device->driverData,
+        threshold,
+        callback,
+        userdata
+    );
+}
+
 /* vim: set noexpandtab shiftwidth=8 tabstop=8: */
@@ -198,6 +198,13 @@ struct Refresh_Device
         uint32_t fragmentParamOffset
 	);
 
+    void (*DrawIndexedPrimitivesBatch)(
+        Refresh_Renderer *driverData,
+        Refresh_CommandBuffer *commandBuffer,
+        const Refresh_IndexedDraw *draws,
+        uint32_t drawCount
+    );
+
 	void (*DrawPrimitives)(
 	    Refresh_Renderer *driverData,
         Refresh_CommandBuffer *commandBuffer,
@@ -207,6 +214,28 @@ struct Refresh_Device
         uint32_t fragmentParamOffset
 	);
 
+    void (*DrawIndexedPrimitivesIndirect)(
+        Refresh_Renderer *driverData,
+        Refresh_CommandBuffer *commandBuffer,
+        Refresh_Buffer *buffer,
+        uint32_t offsetInBytes,
+        uint32_t drawCount,
+        uint32_t stride,
+        uint32_t vertexParamOffset,
+        uint32_t fragmentParamOffset
+    );
+
+    void (*DrawPrimitivesIndirect)(
+        Refresh_Renderer *driverData,
+        Refresh_CommandBuffer *commandBuffer,
+        Refresh_Buffer *buffer,
+        uint32_t offsetInBytes,
+        uint32_t drawCount,
+        uint32_t stride,
+        uint32_t vertexParamOffset,
+        uint32_t fragmentParamOffset
+    );
+
     void (*DispatchCompute)(
         Refresh_Renderer *device,
         Refresh_CommandBuffer *commandBuffer,
@@ -216,6 +245,14 @@ struct Refresh_Device
         uint32_t computeParamOffset
     );
 
+    void (*DispatchComputeIndirect)(
+        Refresh_Renderer *driverData,
+        Refresh_CommandBuffer *commandBuffer,
+        Refresh_Buffer *buffer,
+        uint32_t offsetInBytes,
+        uint32_t computeParamOffset
+    );
+
     /* State Creation */
 
     Refresh_RenderPass* (*CreateRenderPass)(
@@ -302,6 +339,24 @@ struct Refresh_Device
         Refresh_Buffer *buffer
     );
 
+    void(*CopyBufferToBuffer)(
+        Refresh_Renderer *driverData,
+        Refresh_CommandBuffer *commandBuffer,
+        Refresh_Buffer *source,
+        Refresh_Buffer *destination,
+        Refresh_BufferCopy *pRegions,
+        uint32_t regionCount
+    );
+
+    void(*FillBuffer)(
+        Refresh_Renderer *driverData,
+        Refresh_CommandBuffer *commandBuffer,
+        Refresh_Buffer *buffer,
+        uint32_t offsetInBytes,
+        uint32_t sizeInBytes,
+        uint32_t data
+    );
+
     void(*SetBufferData)(
         Refresh_Renderer *driverData,
         Refresh_Buffer *buffer,
@@ -310,6 +365,26 @@ struct Refresh_Device
         uint32_t dataLength
     );
 
+    void(*SetBufferDataWithOptions)(
+        Refresh_Renderer *driverData,
+        Refresh_Buffer *buffer,
+        uint32_t offsetInBytes,
+        void* data,
+        uint32_t dataLength,
+        Refresh_SetDataOptions options
+    );
+
+    void*(*MapBuffer)(
+        Refresh_Renderer *driverData,
+        Refresh_Buffer *buffer,
+        Refresh_SetDataOptions options
+    );
+
+    void(*UnmapBuffer)(
+        Refresh_Renderer *driverData,
+        Refresh_Buffer *buffer
+    );
+
     uint32_t(*PushVertexShaderUniforms)(
         Refresh_Renderer *driverData,
         Refresh_GraphicsPipeline* pipeline,
@@ -331,6 +406,14 @@ struct Refresh_Device
         uint32_t dataLengthInBytes
     );
 
+    void(*PushConstants)(
+        Refresh_Renderer *driverData,
+        Refresh_CommandBuffer *commandBuffer,
+        Refresh_ShaderStageType stage,
+        void *data,
+        uint32_t dataLengthInBytes
+    );
+
     void(*BindVertexSamplers)(
         Refresh_Renderer *driverData,
         Refresh_CommandBuffer *commandBuffer,
@@ -354,6 +437,20 @@ struct Refresh_Device
         uint32_t dataLengthInBytes
     );
 
+    Refresh_BufferReadback*(*GetBufferDataAsync)(
+        Refresh_Renderer *driverData,
+        Refresh_CommandBuffer *commandBuffer,
+        Refresh_Buffer *buffer,
+        uint32_t offsetInBytes,
+        uint32_t dataLengthInBytes
+    );
+
+    uint8_t(*QueryBufferReadback)(
+        Refresh_Renderer *driverData,
+        Refresh_BufferReadback *readback,
+        void *data
+    );
+
     /* Disposal */
 
     void(*QueueDestroyTexture)(
@@ -465,6 +562,12 @@ struct Refresh_Device
         uint8_t fixed
     );
 
+    void(*GetCommandBufferStats)(
+        Refresh_Renderer *driverData,
+        Refresh_CommandBuffer *commandBuffer,
+        Refresh_CommandBufferStats *stats
+    );
+
     void(*QueuePresent)(
         Refresh_Renderer *driverData,
         Refresh_CommandBuffer *commandBuffer,
@@ -489,6 +592,45 @@ struct Refresh_Device
         Refresh_TextureHandles *handles
     );
 
+    uint32_t(*GetTextureBindlessIndex)(
+        Refresh_Renderer *driverData,
+        Refresh_Texture *texture
+    );
+
+    uint32_t(*GetSamplerBindlessIndex)(
+        Refresh_Renderer *driverData,
+        Refresh_Sampler *sampler
+    );
+
+    void(*SetMemoryPlacementPolicy)(
+        Refresh_Renderer *driverData,
+        Refresh_MemoryPlacementPolicy policy
+    );
+
+    void(*SetMemoryDefragmentation)(
+        Refresh_Renderer *driverData,
+        uint8_t enabled
+    );
+
+    void(*GetMemoryFragmentationStats)(
+        Refresh_Renderer *driverData,
+        Refresh_MemoryFragmentationStats *pStats,
+        uint32_t *pCount
+    );
+
+    void(*GetMemoryStats)(
+        Refresh_Renderer *driverData,
+        Refresh_MemoryHeapStats *pStats,
+        uint32_t *pCount
+    );
+
+    void(*SetMemoryBudgetCallback)(
+        Refresh_Renderer *driverData,
+        float threshold,
+        Refresh_MemoryBudgetFunc callback,
+        void *userdata
+    );
+
 	/* Opaque pointer for the Driver */
 	Refresh_Renderer *driverData;
 };
@@ -500,8 +642,12 @@ struct Refresh_Device
 	ASSIGN_DRIVER_FUNC(Clear, name) \
 	ASSIGN_DRIVER_FUNC(DrawIndexedPrimitives, name) \
 	ASSIGN_DRIVER_FUNC(DrawInstancedPrimitives, name) \
+	ASSIGN_DRIVER_FUNC(DrawIndexedPrimitivesBatch, name) \
 	ASSIGN_DRIVER_FUNC(DrawPrimitives, name) \
+	ASSIGN_DRIVER_FUNC(DrawIndexedPrimitivesIndirect, name) \
+	ASSIGN_DRIVER_FUNC(DrawPrimitivesIndirect, name) \
     ASSIGN_DRIVER_FUNC(DispatchCompute, name) \
+    ASSIGN_DRIVER_FUNC(DispatchComputeIndirect, name) \
     ASSIGN_DRIVER_FUNC(CreateRenderPass, name) \
     ASSIGN_DRIVER_FUNC(CreateComputePipeline, name) \
     ASSIGN_DRIVER_FUNC(CreateGraphicsPipeline, name) \
@@ -515,13 +661,21 @@ struct Refresh_Device
     ASSIGN_DRIVER_FUNC(SetTextureDataYUV, name) \
     ASSIGN_DRIVER_FUNC(CopyTextureToTexture, name) \
     ASSIGN_DRIVER_FUNC(CopyTextureToBuffer, name) \
+    ASSIGN_DRIVER_FUNC(CopyBufferToBuffer, name) \
+    ASSIGN_DRIVER_FUNC(FillBuffer, name) \
     ASSIGN_DRIVER_FUNC(SetBufferData, name) \
+    ASSIGN_DRIVER_FUNC(SetBufferDataWithOptions, name) \
+    ASSIGN_DRIVER_FUNC(MapBuffer, name) \
+    ASSIGN_DRIVER_FUNC(UnmapBuffer, name) \
     ASSIGN_DRIVER_FUNC(PushVertexShaderUniforms, name) \
     ASSIGN_DRIVER_FUNC(PushFragmentShaderUniforms, name) \
     ASSIGN_DRIVER_FUNC(PushComputeShaderUniforms, name) \
+    ASSIGN_DRIVER_FUNC(PushConstants, name) \
     ASSIGN_DRIVER_FUNC(BindVertexSamplers, name) \
     ASSIGN_DRIVER_FUNC(BindFragmentSamplers, name) \
     ASSIGN_DRIVER_FUNC(GetBufferData, name) \
+    ASSIGN_DRIVER_FUNC(GetBufferDataAsync, name) \
+    ASSIGN_DRIVER_FUNC(QueryBufferReadback, name) \
     ASSIGN_DRIVER_FUNC(QueueDestroyTexture, name) \
     ASSIGN_DRIVER_FUNC(QueueDestroySampler, name) \
     ASSIGN_DRIVER_FUNC(QueueDestroyBuffer, name) \
@@ -540,10 +694,18 @@ struct Refresh_Device
     ASSIGN_DRIVER_FUNC(BindComputeBuffers, name) \
     ASSIGN_DRIVER_FUNC(BindComputeTextures, name) \
     ASSIGN_DRIVER_FUNC(AcquireCommandBuffer, name) \
+    ASSIGN_DRIVER_FUNC(GetCommandBufferStats, name) \
     ASSIGN_DRIVER_FUNC(QueuePresent, name) \
     ASSIGN_DRIVER_FUNC(Submit, name) \
     ASSIGN_DRIVER_FUNC(Wait, name) \
-    ASSIGN_DRIVER_FUNC(GetTextureHandles, name)
+    ASSIGN_DRIVER_FUNC(GetTextureHandles, name) \
+    ASSIGN_DRIVER_FUNC(GetTextureBindlessIndex, name) \
+    ASSIGN_DRIVER_FUNC(GetSamplerBindlessIndex, name) \
+    ASSIGN_DRIVER_FUNC(SetMemoryPlacementPolicy, name) \
+    ASSIGN_DRIVER_FUNC(SetMemoryDefragmentation, name) \
+    ASSIGN_DRIVER_FUNC(GetMemoryFragmentationStats, name) \
+    ASSIGN_DRIVER_FUNC(GetMemoryStats, name) \
+    ASSIGN_DRIVER_FUNC(SetMemoryBudgetCallback, name)
 
 typedef struct Refresh_Driver
 {
@@ -60,6 +60,7 @@ static const char* deviceExtensionNames[] =
 	VK_KHR_MAINTENANCE1_EXTENSION_NAME,
 	VK_KHR_DEDICATED_ALLOCATION_EXTENSION_NAME,
 	VK_KHR_GET_MEMORY_REQUIREMENTS_2_EXTENSION_NAME,
+	VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME,
 	/* Core since 1.2 */
 	VK_KHR_DRIVER_PROPERTIES_EXTENSION_NAME,
 	/* EXT, probably not going to be Core */
@@ -73,11 +74,44 @@ static uint32_t deviceExtensionCount = SDL_arraysize(deviceExtensionNames);
 #define MAX_ALLOCATION_SIZE 256000000 			/* 256MB */
 #define TEXTURE_STAGING_SIZE 8000000 			/* 8MB */
 #define UBO_BUFFER_SIZE 8000000 				/* 8MB */
-#define UBO_ACTUAL_SIZE (UBO_BUFFER_SIZE * 2)
+#define UBO_BLOCK_RELEASE_FRAMES 120 			/* counted per frame slot */
+#define UBO_CHUNK_SIZE 65536 					/* 64KB, reserved per thread */
+#define UBO_OFFSET_BITS 23 					/* UBO_BUFFER_SIZE fits below this */
+#define UBO_BLOCK_INDEX_BITS 7 				/* frame slot is stored above this */
+#define UBO_MAX_BLOCKS (1 << UBO_BLOCK_INDEX_BITS) 	/* per frame slot */
 #define DESCRIPTOR_POOL_STARTING_SIZE 128
-#define UBO_POOL_SIZE 1000
-#define SUB_BUFFER_COUNT 2
+#define MAX_FRAMES_IN_FLIGHT 4
+#define DEFAULT_FRAMES_IN_FLIGHT 2
 #define DESCRIPTOR_SET_DEACTIVATE_FRAMES 10
+#define EMPTY_ALLOCATION_RELEASE_FRAMES 60
+#define DEFRAGMENT_BYTES_PER_FRAME 16000000
+#define DEFRAGMENT_BACKOFF_FRAMES 8 			/* after a pass that moved nothing */
+#define DEFRAGMENT_MAX_BACKOFF_FRAMES 512 		/* doubled per failed pass up to this */
+#define MEMORY_REGION_POOL_CHUNK_SIZE 256
+#define BUFFER_ARENA_SIZE 4000000 				/* 4MB */
+#define BUFFER_ARENA_MAX_SUBALLOCATION_SIZE 65536
+#define BUFFER_ARENA_USAGE ( \
+	VK_BUFFER_USAGE_TRANSFER_SRC_BIT | \
+	VK_BUFFER_USAGE_TRANSFER_DST_BIT | \
+	VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | \
+	VK_BUFFER_USAGE_INDEX_BUFFER_BIT | \
+	VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | \
+	VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT \
+)
+#define READBACK_BUFFER_MIN_SIZE 65536
+#define READBACK_POOL_STARTING_SIZE 16
+#define MULTI_DRAW_BATCH_SIZE 64 /* well under the 1024 maxMultiDrawCount minimum */
+#define BINDLESS_TEXTURE_COUNT 65536
+#define BINDLESS_SAMPLER_COUNT 2048
+#define BINDLESS_FREE_INDEX_STARTING_SIZE 64
+
+/* Two-level segregated fit parameters, see VulkanMemorySubAllocator */
+#define TLSF_SL_INDEX_COUNT_LOG2 4
+#define TLSF_SL_INDEX_COUNT (1 << TLSF_SL_INDEX_COUNT_LOG2)
+#define TLSF_FL_INDEX_SHIFT (TLSF_SL_INDEX_COUNT_LOG2 + 4)
+#define TLSF_FL_INDEX_MAX 40 /* 1TB */
+#define TLSF_FL_INDEX_COUNT (TLSF_FL_INDEX_MAX - TLSF_FL_INDEX_SHIFT + 1)
+#define TLSF_SMALL_BLOCK_SIZE (1 << TLSF_FL_INDEX_SHIFT)
 
 #define IDENTITY_SWIZZLE \
 { \
@@ -134,6 +168,7 @@ typedef enum VulkanResourceAccessType
 	RESOURCE_ACCESS_NONE, /* For initialization */
 	RESOURCE_ACCESS_INDEX_BUFFER,
 	RESOURCE_ACCESS_VERTEX_BUFFER,
+	RESOURCE_ACCESS_INDIRECT_BUFFER,
 	RESOURCE_ACCESS_VERTEX_SHADER_READ_UNIFORM_BUFFER,
 	RESOURCE_ACCESS_VERTEX_SHADER_READ_SAMPLED_IMAGE,
 	RESOURCE_ACCESS_FRAGMENT_SHADER_READ_UNIFORM_BUFFER,
@@ -143,6 +178,7 @@ typedef enum VulkanResourceAccessType
 	RESOURCE_ACCESS_COMPUTE_SHADER_READ_UNIFORM_BUFFER,
 	RESOURCE_ACCESS_COMPUTE_SHADER_READ_OTHER,
 	RESOURCE_ACCESS_ANY_SHADER_READ_SAMPLED_IMAGE,
+	RESOURCE_ACCESS_ANY_BUFFER_READ,
 	RESOURCE_ACCESS_COLOR_ATTACHMENT_READ,
 	RESOURCE_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ,
 	RESOURCE_ACCESS_TRANSFER_READ,
@@ -161,6 +197,7 @@ typedef enum VulkanResourceAccessType
 	/* Read-Writes */
 	RESOURCE_ACCESS_COLOR_ATTACHMENT_READ_WRITE,
 	RESOURCE_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_WRITE,
+	RESOURCE_ACCESS_COMPUTE_SHADER_BUFFER_READ_WRITE,
 	RESOURCE_ACCESS_MEMORY_TRANSFER_READ_WRITE,
 	RESOURCE_ACCESS_GENERAL,
 
@@ -407,24 +444,59 @@ static VkBorderColor RefreshToVK_BorderColor[] =
 /* Memory Allocation */
 
 typedef struct VulkanMemoryAllocation VulkanMemoryAllocation;
+typedef struct VulkanMemoryRegion VulkanMemoryRegion;
 
-typedef struct VulkanMemoryFreeRegion
+/*
+ * A region covers a contiguous range of an allocation, free or used.
+ * Regions are linked in address order so frees can coalesce in O(1).
+ */
+struct VulkanMemoryRegion
 {
 	VulkanMemoryAllocation *allocation;
 	VkDeviceSize offset;
 	VkDeviceSize size;
-	uint32_t allocationIndex;
-	uint32_t sortedIndex;
-} VulkanMemoryFreeRegion;
+	uint8_t isFree;
+
+	VulkanMemoryRegion *prevPhysical;
+	VulkanMemoryRegion *nextPhysical;
+
+	/* Segregated free list links, also used by the region pool */
+	VulkanMemoryRegion *prevFree;
+	VulkanMemoryRegion *nextFree;
 
+	/* Owner of a used region the defragmenter may relocate, else NULL */
+	struct VulkanTexture *texture;
+	struct VulkanBuffer *buffer;
+	uint32_t subBufferIndex;
+};
+
+/*
+ * Free regions are kept in a two-level segregated fit (TLSF) structure:
+ * the first level splits sizes by power of two, the second level splits
+ * each power of two linearly. Bitmaps make finding a list O(1).
+ */
 typedef struct VulkanMemorySubAllocator
 {
 	VkDeviceSize nextAllocationSize;
 	VulkanMemoryAllocation **allocations;
 	uint32_t allocationCount;
-	VulkanMemoryFreeRegion **sortedFreeRegions;
-	uint32_t sortedFreeRegionCount;
-	uint32_t sortedFreeRegionCapacity;
+	uint64_t firstLevelBitmap;
+	uint32_t secondLevelBitmaps[TLSF_FL_INDEX_COUNT];
+	VulkanMemoryRegion *freeLists[TLSF_FL_INDEX_COUNT][TLSF_SL_INDEX_COUNT];
+	VkDeviceSize totalFreeBytes;
+	uint32_t freeRegionCount;
+
+	/* Device memory accounting, dedicated allocations included */
+	VkDeviceSize allocatedBytes;
+	uint32_t dedicatedAllocationCount;
+	VkDeviceSize textureBytes;
+	VkDeviceSize bufferBytes;
+
+	/* Defragmentation state, kept between submissions */
+	VulkanMemoryAllocation *defragmentSource; /* NULL if no block qualifies */
+	uint8_t defragmentSourceDirty; /* block usage changed since the source was chosen */
+	uint32_t defragmentBackoff; /* submissions left to skip */
+	uint32_t defragmentBackoffLength; /* doubled by each pass in a row that moved nothing */
 } VulkanMemorySubAllocator;
 
 struct VulkanMemoryAllocation
@@ -432,17 +504,28 @@ struct VulkanMemoryAllocation
 	VulkanMemorySubAllocator *allocator;
 	VkDeviceMemory memory;
 	VkDeviceSize size;
-	VulkanMemoryFreeRegion **freeRegions;
-	uint32_t freeRegionCount;
-	uint32_t freeRegionCapacity;
 	uint8_t dedicated;
 	uint8_t *mapPointer;
+	uint8_t nonCoherent; /* host writes and reads need explicit flush/invalidate */
 	SDL_mutex *memoryLock;
+
+	VulkanMemoryRegion *firstRegion; /* lowest offset, regions follow via nextPhysical */
+	VkDeviceSize usedBytes;
+	uint32_t usedRegionCount;
+	uint32_t emptyFrameCount;
 };
 
 typedef struct VulkanMemoryAllocator
 {
 	VulkanMemorySubAllocator subAllocators[VK_MAX_MEMORY_TYPES];
+	VulkanMemorySubAllocator bufferArenas; /* blocks are VulkanBufferArenas */
+	Refresh_MemoryPlacementPolicy placementPolicy;
+	uint8_t defragmentationEnabled;
+
+	/* Region nodes are pooled so splits and frees don't hit the heap */
+	VulkanMemoryRegion *regionPool;
+	VulkanMemoryRegion **regionPoolChunks;
+	uint32_t regionPoolChunkCount;
 } VulkanMemoryAllocator;
 
 /* Memory Barriers */
@@ -477,6 +560,13 @@ static const VulkanResourceAccessInfo AccessMap[RESOURCE_ACCESS_TYPES_COUNT] =
 		VK_IMAGE_LAYOUT_UNDEFINED
 	},
 
+	/* RESOURCE_ACCESS_INDIRECT_BUFFER */
+	{
+		VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+		VK_ACCESS_INDIRECT_COMMAND_READ_BIT,
+		VK_IMAGE_LAYOUT_UNDEFINED
+	},
+
 	/* RESOURCE_ACCESS_VERTEX_SHADER_READ_UNIFORM_BUFFER */
 	{
 		VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
@@ -540,6 +630,13 @@ static const VulkanResourceAccessInfo AccessMap[RESOURCE_ACCESS_TYPES_COUNT] =
 		VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
 	},
 
+	/* RESOURCE_ACCESS_ANY_BUFFER_READ */
+	{
+		VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+		VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_SHADER_READ_BIT,
+		VK_IMAGE_LAYOUT_UNDEFINED
+	},
+
 	/* RESOURCE_ACCESS_COLOR_ATTACHMENT_READ */
 	{
 		VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
@@ -638,6 +735,13 @@ static const VulkanResourceAccessInfo AccessMap[RESOURCE_ACCESS_TYPES_COUNT] =
 		VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL
 	},
 
+	/* RESOURCE_ACCESS_COMPUTE_SHADER_BUFFER_READ_WRITE */
+	{
+		VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+		VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+		VK_IMAGE_LAYOUT_UNDEFINED
+	},
+
 	/* RESOURCE_ACCESS_MEMORY_TRANSFER_READ_WRITE */
 	{
 		VK_PIPELINE_STAGE_TRANSFER_BIT,
@@ -655,14 +759,23 @@ static const VulkanResourceAccessInfo AccessMap[RESOURCE_ACCESS_TYPES_COUNT] =
 
 /* Memory structures */
 
+typedef enum VulkanBufferMemoryUsage
+{
+	VULKAN_BUFFER_MEMORY_HOST, /* host visible and coherent, written by the CPU */
+	VULKAN_BUFFER_MEMORY_DEVICE, /* device local, written through the transfer queue */
+	VULKAN_BUFFER_MEMORY_READBACK /* host visible, cached if possible, read by the CPU */
+} VulkanBufferMemoryUsage;
+
 typedef struct VulkanBuffer VulkanBuffer;
 
 typedef struct VulkanSubBuffer
 {
 	VulkanMemoryAllocation *allocation;
+	VulkanMemoryRegion *usedRegion; /* NULL for dedicated allocations */
 	VkBuffer buffer;
 	VkDeviceSize offset;
 	VkDeviceSize size;
+	VkDeviceSize bufferOffset; /* start within buffer, non-zero in arenas */
 	VulkanResourceAccessType resourceAccessType;
 	int8_t bound;
 } VulkanSubBuffer;
@@ -681,9 +794,22 @@ struct VulkanBuffer /* cast from FNA3D_Buffer */
 	VulkanResourceAccessType resourceAccessType;
 	VkBufferUsageFlags usage;
 	uint8_t bound;
-	uint8_t boundSubmitted;
+	uint8_t boundSubmitted; /* number of in-flight frames using this buffer */
+	VulkanBufferMemoryUsage memoryUsage; /* DEVICE buffers have one sub-buffer */
+	uint8_t mapped; /* between Refresh_MapBuffer and Refresh_UnmapBuffer */
 };
 
+/*
+ * Small buffers are carved out of shared VkBuffers. An arena is a block of
+ * the bufferArenas sub-allocator whose regions are offsets into the arena's
+ * VkBuffer, so the same TLSF code manages arena space.
+ */
+typedef struct VulkanBufferArena
+{
+	VulkanMemoryAllocation block; /* must be first, regions point here */
+	VulkanBuffer *backing; /* owns the VkBuffer and its memory */
+} VulkanBufferArena;
+
 /* Renderer Structure */
 
 typedef struct QueueFamilyIndices
@@ -706,11 +832,26 @@ typedef struct SwapChainSupportDetails
 typedef struct BufferDescriptorSetCache BufferDescriptorSetCache;
 typedef struct ImageDescriptorSetCache ImageDescriptorSetCache;
 
+/* Shared description of one descriptor set of a pipeline layout.
+ * The caches holding the sets themselves are per thread, indexed by id
+ * in each VulkanCommandPool.
+ */
+typedef struct DescriptorSetCacheInfo
+{
+	uint32_t id; /* unique among infos of the same cache type */
+	VkDescriptorSetLayout descriptorSetLayout;
+	uint32_t bindingCount;
+	VkDescriptorType descriptorType;
+	VkDescriptorUpdateTemplateKHR descriptorUpdateTemplate;
+} DescriptorSetCacheInfo;
+
 typedef struct VulkanGraphicsPipelineLayout
 {
 	VkPipelineLayout pipelineLayout;
-	ImageDescriptorSetCache *vertexSamplerDescriptorSetCache;
-	ImageDescriptorSetCache *fragmentSamplerDescriptorSetCache;
+	DescriptorSetCacheInfo *vertexSamplerDescriptorSetCacheInfo;
+	DescriptorSetCacheInfo *fragmentSamplerDescriptorSetCacheInfo;
+	uint32_t vertexPushConstantSize;
+	uint32_t fragmentPushConstantSize;
 } VulkanGraphicsPipelineLayout;
 
 typedef struct VulkanGraphicsPipeline
@@ -718,11 +859,7 @@ typedef struct VulkanGraphicsPipeline
 	VkPipeline pipeline;
 	VulkanGraphicsPipelineLayout *pipelineLayout;
 	Refresh_PrimitiveType primitiveType;
-	VkDescriptorSet vertexSamplerDescriptorSet; /* updated by BindVertexSamplers */
-	VkDescriptorSet fragmentSamplerDescriptorSet; /* updated by BindFragmentSamplers */
 
-	VkDescriptorSet vertexUBODescriptorSet; /* permanently set in Create function */
-	VkDescriptorSet fragmentUBODescriptorSet; /* permanently set in Create function */
 	VkDeviceSize vertexUBOBlockSize; /* permanently set in Create function */
 	VkDeviceSize fragmentUBOBlockSize; /* permantenly set in Create function */
 } VulkanGraphicsPipeline;
@@ -730,24 +867,23 @@ typedef struct VulkanGraphicsPipeline
 typedef struct VulkanComputePipelineLayout
 {
 	VkPipelineLayout pipelineLayout;
-	BufferDescriptorSetCache *bufferDescriptorSetCache;
-	ImageDescriptorSetCache *imageDescriptorSetCache;
+	DescriptorSetCacheInfo *bufferDescriptorSetCacheInfo;
+	DescriptorSetCacheInfo *imageDescriptorSetCacheInfo;
+	uint32_t pushConstantSize;
 } VulkanComputePipelineLayout;
 
 typedef struct VulkanComputePipeline
 {
 	VkPipeline pipeline;
 	VulkanComputePipelineLayout *pipelineLayout;
-	VkDescriptorSet bufferDescriptorSet; /* updated by BindComputeBuffers */
-	VkDescriptorSet imageDescriptorSet; /* updated by BindComputeTextures */
 
-	VkDescriptorSet computeUBODescriptorSet; /* permanently set in Create function */
 	VkDeviceSize computeUBOBlockSize; /* permanently set in Create function */
 } VulkanComputePipeline;
 
 typedef struct VulkanTexture
 {
 	VulkanMemoryAllocation *allocation;
+	VulkanMemoryRegion *usedRegion; /* NULL for dedicated allocations */
 	VkDeviceSize offset;
 	VkDeviceSize memorySize;
 
@@ -765,6 +901,14 @@ typedef struct VulkanTexture
 	VulkanResourceAccessType resourceAccessType;
 	uint32_t queueFamilyIndex;
 	VkImageUsageFlags usageFlags;
+	uint32_t bindlessIndex; /* REFRESH_BINDLESS_INDEX_NONE if not in the global array */
+
+	/* Unsubmitted command buffers using the image keep it from being moved */
+	SDL_atomic_t recordingRefs;
+	void *lastRecordingCommandBuffer; /* accessed atomically, skips repeat tracking */
+
+	/* Set once GetTextureHandles hands out the image, which must then stay put */
+	uint8_t handlesExported;
 } VulkanTexture;
 
 typedef struct VulkanRenderTarget
@@ -869,7 +1013,231 @@ static inline void DescriptorSetLayoutHashTable_Insert(
 
 /* Descriptor Set Caches */
 
-#define NUM_DESCRIPTOR_SET_HASH_BUCKETS 1031
+#define DESCRIPTOR_SET_INDEX_STARTING_SLOTS 64 /* must be a power of two */
+#define DESCRIPTOR_SET_INDEX_EMPTY SDL_MAX_UINT32
+
+/* Open-addressed index into a cache's element array.
+ * The full hash is stored with each slot so most probes only
+ * compare one integer before touching the descriptor set data.
+ */
+typedef struct DescriptorSetIndexSlot
+{
+	uint64_t key;
+	uint32_t element; /* DESCRIPTOR_SET_INDEX_EMPTY if unused */
+} DescriptorSetIndexSlot;
+
+typedef struct DescriptorSetIndex
+{
+	DescriptorSetIndexSlot *slots;
+	uint32_t slotCount; /* power of two */
+	uint32_t count;
+} DescriptorSetIndex;
+
+static inline uint64_t DescriptorSetHash_Mix(uint64_t hash, uint64_t value)
+{
+	hash ^= value;
+	hash *= 0xFF51AFD7ED558CCDULL;
+	hash ^= hash >> 32;
+	return hash;
+}
+
+/* MurmurHash3 finalizer, spreads the handle bits over the whole key */
+static inline uint64_t DescriptorSetHash_Finalize(uint64_t hash)
+{
+	hash ^= hash >> 33;
+	hash *= 0xFF51AFD7ED558CCDULL;
+	hash ^= hash >> 33;
+	hash *= 0xC4CEB9FE1A85EC53ULL;
+	hash ^= hash >> 33;
+	return hash;
+}
+
+static void DescriptorSetIndex_Init(
+	DescriptorSetIndex *index,
+	uint32_t slotCount
+) {
+	uint32_t i;
+
+	index->slots = SDL_malloc(sizeof(DescriptorSetIndexSlot) * slotCount);
+	index->slotCount = slotCount;
+	index->count = 0;
+
+	for (i = 0; i < slotCount; i += 1)
+	{
+		index->slots[i].element = DESCRIPTOR_SET_INDEX_EMPTY;
+	}
+}
+
+static void DescriptorSetIndex_Insert(
+	DescriptorSetIndex *index,
+	uint64_t key,
+	uint32_t element
+) {
+	DescriptorSetIndexSlot *oldSlots;
+	uint32_t oldSlotCount, mask, slot, i;
+
+	/* Keep the load factor at or below one half so probes stay short */
+	if ((index->count + 1) * 2 > index->slotCount)
+	{
+		oldSlots = index->slots;
+		oldSlotCount = index->slotCount;
+
+		DescriptorSetIndex_Init(index, oldSlotCount * 2);
+
+		for (i = 0; i < oldSlotCount; i += 1)
+		{
+			if (oldSlots[i].element != DESCRIPTOR_SET_INDEX_EMPTY)
+			{
+				DescriptorSetIndex_Insert(
+					index,
+					oldSlots[i].key,
+					oldSlots[i].element
+				);
+			}
+		}
+
+		SDL_free(oldSlots);
+	}
+
+	mask = index->slotCount - 1;
+	slot = (uint32_t) key & mask;
+
+	while (index->slots[slot].element != DESCRIPTOR_SET_INDEX_EMPTY)
+	{
+		slot = (slot + 1) & mask;
+	}
+
+	index->slots[slot].key = key;
+	index->slots[slot].element = element;
+	index->count += 1;
+}
+
+static inline uint32_t DescriptorSetIndex_FindSlot(
+	DescriptorSetIndex *index,
+	uint64_t key,
+	uint32_t element
+) {
+	uint32_t mask = index->slotCount - 1;
+	uint32_t slot = (uint32_t) key & mask;
+
+	while (index->slots[slot].element != element)
+	{
+		slot = (slot + 1) & mask;
+	}
+
+	return slot;
+}
+
+/* Backward-shift deletion, so no tombstones are needed */
+static void DescriptorSetIndex_Remove(
+	DescriptorSetIndex *index,
+	uint64_t key,
+	uint32_t element
+) {
+	uint32_t mask = index->slotCount - 1;
+	uint32_t hole = DescriptorSetIndex_FindSlot(index, key, element);
+	uint32_t slot = hole;
+	uint32_t home;
+
+	while (1)
+	{
+		slot = (slot + 1) & mask;
+
+		if (index->slots[slot].element == DESCRIPTOR_SET_INDEX_EMPTY)
+		{
+			break;
+		}
+
+		/* Move the entry back if its home is not between the hole and here */
+		home = (uint32_t) index->slots[slot].key & mask;
+		if (((slot - home) & mask) >= ((slot - hole) & mask))
+		{
+			index->slots[hole] = index->slots[slot];
+			hole = slot;
+		}
+	}
+
+	index->slots[hole].element = DESCRIPTOR_SET_INDEX_EMPTY;
+	index->count -= 1;
+}
+
+static inline void DescriptorSetIndex_Move(
+	DescriptorSetIndex *index,
+	uint64_t key,
+	uint32_t oldElement,
+	uint32_t newElement
+) {
+	index->slots[
+		DescriptorSetIndex_FindSlot(index, key, oldElement)
+	].element = newElement;
+}
+
+/* Intrusive LRU lists threaded through a cache's element array.
+ * DESCRIPTOR_SET_INDEX_EMPTY terminates the list in both directions.
+ */
+
+#define DESCRIPTOR_SET_LRU_UNLINK(cache, i)				\
+	do								\
+	{								\
+		uint32_t lruPrev = cache->elements[i].lruPrev;		\
+		uint32_t lruNext = cache->elements[i].lruNext;		\
+		if (lruPrev != DESCRIPTOR_SET_INDEX_EMPTY)		\
+		{							\
+			cache->elements[lruPrev].lruNext = lruNext;	\
+		}							\
+		else							\
+		{							\
+			cache->lruHead = lruNext;			\
+		}							\
+		if (lruNext != DESCRIPTOR_SET_INDEX_EMPTY)		\
+		{							\
+			cache->elements[lruNext].lruPrev = lruPrev;	\
+		}							\
+		else							\
+		{							\
+			cache->lruTail = lruPrev;			\
+		}							\
+	} while (0)
+
+#define DESCRIPTOR_SET_LRU_APPEND(cache, i)				\
+	do								\
+	{								\
+		cache->elements[i].lruPrev = cache->lruTail;		\
+		cache->elements[i].lruNext = DESCRIPTOR_SET_INDEX_EMPTY;\
+		if (cache->lruTail != DESCRIPTOR_SET_INDEX_EMPTY)	\
+		{							\
+			cache->elements[cache->lruTail].lruNext = i;	\
+		}							\
+		else							\
+		{							\
+			cache->lruHead = i;				\
+		}							\
+		cache->lruTail = i;					\
+	} while (0)
+
+/* Points the neighbours of an element at its new position i */
+#define DESCRIPTOR_SET_LRU_RELINK(cache, i)				\
+	do								\
+	{								\
+		uint32_t lruPrev = cache->elements[i].lruPrev;		\
+		uint32_t lruNext = cache->elements[i].lruNext;		\
+		if (lruPrev != DESCRIPTOR_SET_INDEX_EMPTY)		\
+		{							\
+			cache->elements[lruPrev].lruNext = i;		\
+		}							\
+		else							\
+		{							\
+			cache->lruHead = i;				\
+		}							\
+		if (lruNext != DESCRIPTOR_SET_INDEX_EMPTY)		\
+		{							\
+			cache->elements[lruNext].lruPrev = i;		\
+		}							\
+		else							\
+		{							\
+			cache->lruTail = i;				\
+		}							\
+	} while (0)
 
 typedef struct ImageDescriptorSetData
 {
@@ -881,44 +1249,49 @@ typedef struct ImageDescriptorSetHashMap
 	uint64_t key;
 	ImageDescriptorSetData descriptorSetData;
 	VkDescriptorSet descriptorSet;
-	uint8_t inactiveFrameCount;
+	uint32_t lastUsedSubmission; /* compared with wrapping math */
+	uint8_t indexed; /* 0 once expired, then only reachable through the list */
+	uint32_t lruPrev; /* towards the least recently used entry */
+	uint32_t lruNext;
 } ImageDescriptorSetHashMap;
 
-typedef struct ImageDescriptorSetHashArray
-{
-	uint32_t *elements;
-	int32_t count;
-	int32_t capacity;
-} ImageDescriptorSetHashArray;
-
 static inline uint64_t ImageDescriptorSetHashTable_GetHashCode(
 	ImageDescriptorSetData *descriptorSetData,
 	uint32_t samplerCount
 ) {
-	const uint64_t HASH_FACTOR = 97;
 	uint32_t i;
-	uint64_t result = 1;
+	uint64_t result = samplerCount;
 
 	for (i = 0; i < samplerCount; i += 1)
 	{
-		result = result * HASH_FACTOR + (uint64_t) descriptorSetData->descriptorImageInfo[i].imageView;
-		result = result * HASH_FACTOR + (uint64_t) descriptorSetData->descriptorImageInfo[i].sampler;
+		result = DescriptorSetHash_Mix(result, (uint64_t) descriptorSetData->descriptorImageInfo[i].imageView);
+		result = DescriptorSetHash_Mix(result, (uint64_t) descriptorSetData->descriptorImageInfo[i].sampler);
+		result = DescriptorSetHash_Mix(result, (uint64_t) descriptorSetData->descriptorImageInfo[i].imageLayout);
 	}
 
-	return result;
+	return DescriptorSetHash_Finalize(result);
 }
 
 struct ImageDescriptorSetCache
 {
+	/* copied from the DescriptorSetCacheInfo */
 	VkDescriptorSetLayout descriptorSetLayout;
 	uint32_t bindingCount;
 	VkDescriptorType descriptorType;
 
-	ImageDescriptorSetHashArray buckets[NUM_DESCRIPTOR_SET_HASH_BUCKETS]; /* these buckets store indices */
+	DescriptorSetIndex index; /* maps keys to indices into elements */
 	ImageDescriptorSetHashMap *elements; /* where the hash map elements are stored */
 	uint32_t count;
 	uint32_t capacity;
 
+	/* Elements ordered by last use, only the head needs checking for expiry */
+	uint32_t lruHead;
+	uint32_t lruTail;
+	uint8_t active; /* in the command pool's list of caches holding sets */
+
+	/* Writes a whole ImageDescriptorSetData into a set in one call */
+	VkDescriptorUpdateTemplateKHR descriptorUpdateTemplate;
+
 	VkDescriptorPool *imageDescriptorPools;
 	uint32_t imageDescriptorPoolCount;
 	uint32_t nextPoolSize;
@@ -938,32 +1311,27 @@ typedef struct BufferDescriptorSetHashMap
 	uint64_t key;
 	BufferDescriptorSetData descriptorSetData;
 	VkDescriptorSet descriptorSet;
-	uint8_t inactiveFrameCount;
+	uint32_t lastUsedSubmission; /* compared with wrapping math */
+	uint8_t indexed; /* 0 once expired, then only reachable through the list */
+	uint32_t lruPrev; /* towards the least recently used entry */
+	uint32_t lruNext;
 } BufferDescriptorSetHashMap;
 
-typedef struct BufferDescriptorSetHashArray
-{
-	uint32_t *elements;
-	int32_t count;
-	int32_t capacity;
-} BufferDescriptorSetHashArray;
-
 static inline uint64_t BufferDescriptorSetHashTable_GetHashCode(
 	BufferDescriptorSetData *descriptorSetData,
 	uint32_t bindingCount
 ) {
-	const uint64_t HASH_FACTOR = 97;
 	uint32_t i;
-	uint64_t result = 1;
+	uint64_t result = bindingCount;
 
 	for (i = 0; i < bindingCount; i += 1)
 	{
-		result = result * HASH_FACTOR + (uint64_t) descriptorSetData->descriptorBufferInfo[i].buffer;
-		result = result * HASH_FACTOR + (uint64_t) descriptorSetData->descriptorBufferInfo[i].offset;
-		result = result * HASH_FACTOR + (uint64_t) descriptorSetData->descriptorBufferInfo[i].range;
+		result = DescriptorSetHash_Mix(result, (uint64_t) descriptorSetData->descriptorBufferInfo[i].buffer);
+		result = DescriptorSetHash_Mix(result, (uint64_t) descriptorSetData->descriptorBufferInfo[i].offset);
+		result = DescriptorSetHash_Mix(result, (uint64_t) descriptorSetData->descriptorBufferInfo[i].range);
 	}
 
-	return result;
+	return DescriptorSetHash_Finalize(result);
 }
 
 struct BufferDescriptorSetCache
@@ -972,11 +1340,17 @@ struct BufferDescriptorSetCache
 	uint32_t bindingCount;
 	VkDescriptorType descriptorType;
 
-	BufferDescriptorSetHashArray buckets[NUM_DESCRIPTOR_SET_HASH_BUCKETS];
+	DescriptorSetIndex index;
 	BufferDescriptorSetHashMap *elements;
 	uint32_t count;
 	uint32_t capacity;
 
+	uint32_t lruHead;
+	uint32_t lruTail;
+	uint8_t active;
+
+	VkDescriptorUpdateTemplateKHR descriptorUpdateTemplate;
+
 	VkDescriptorPool *bufferDescriptorPools;
 	uint32_t bufferDescriptorPoolCount;
 	uint32_t nextPoolSize;
@@ -996,6 +1370,8 @@ typedef struct GraphicsPipelineLayoutHash
 	VkDescriptorSetLayout fragmentSamplerLayout;
 	VkDescriptorSetLayout vertexUniformLayout;
 	VkDescriptorSetLayout fragmentUniformLayout;
+	uint32_t vertexPushConstantSize;
+	uint32_t fragmentPushConstantSize;
 } GraphicsPipelineLayoutHash;
 
 typedef struct GraphicsPipelineLayoutHashMap
@@ -1024,6 +1400,8 @@ static inline uint64_t GraphicsPipelineLayoutHashTable_GetHashCode(GraphicsPipel
 	result = result * HASH_FACTOR + (uint64_t) key.fragmentSamplerLayout;
 	result = result * HASH_FACTOR + (uint64_t) key.vertexUniformLayout;
 	result = result * HASH_FACTOR + (uint64_t) key.fragmentUniformLayout;
+	result = result * HASH_FACTOR + (uint64_t) key.vertexPushConstantSize;
+	result = result * HASH_FACTOR + (uint64_t) key.fragmentPushConstantSize;
 	return result;
 }
 
@@ -1041,7 +1419,9 @@ static inline VulkanGraphicsPipelineLayout* GraphicsPipelineLayoutHashArray_Fetc
 		if (	key.vertexSamplerLayout == e->vertexSamplerLayout &&
 			key.fragmentSamplerLayout == e->fragmentSamplerLayout &&
 			key.vertexUniformLayout == e->vertexUniformLayout &&
-			key.fragmentUniformLayout == e->fragmentUniformLayout	)
+			key.fragmentUniformLayout == e->fragmentUniformLayout &&
+			key.vertexPushConstantSize == e->vertexPushConstantSize &&
+			key.fragmentPushConstantSize == e->fragmentPushConstantSize	)
 		{
 			return arr->elements[i].value;
 		}
@@ -1073,6 +1453,7 @@ typedef struct ComputePipelineLayoutHash
 	VkDescriptorSetLayout bufferLayout;
 	VkDescriptorSetLayout imageLayout;
 	VkDescriptorSetLayout uniformLayout;
+	uint32_t pushConstantSize;
 } ComputePipelineLayoutHash;
 
 typedef struct ComputePipelineLayoutHashMap
@@ -1100,6 +1481,7 @@ static inline uint64_t ComputePipelineLayoutHashTable_GetHashCode(ComputePipelin
 	result = result * HASH_FACTOR + (uint64_t) key.bufferLayout;
 	result = result * HASH_FACTOR + (uint64_t) key.imageLayout;
 	result = result * HASH_FACTOR + (uint64_t) key.uniformLayout;
+	result = result * HASH_FACTOR + (uint64_t) key.pushConstantSize;
 	return result;
 }
 
@@ -1116,7 +1498,8 @@ static inline VulkanComputePipelineLayout* ComputePipelineLayoutHashArray_Fetch(
 		const ComputePipelineLayoutHash *e = &arr->elements[i].key;
 		if (	key.bufferLayout == e->bufferLayout &&
 			key.imageLayout == e->imageLayout &&
-			key.uniformLayout == e->uniformLayout	)
+			key.uniformLayout == e->uniformLayout &&
+			key.pushConstantSize == e->pushConstantSize	)
 		{
 			return arr->elements[i].value;
 		}
@@ -1147,6 +1530,22 @@ static inline void ComputePipelineLayoutHashArray_Insert(
 
 typedef struct VulkanCommandPool VulkanCommandPool;
 
+/* Last descriptor sets bound at one bind point */
+typedef struct VulkanBoundDescriptorSets
+{
+	VkPipelineLayout pipelineLayout;
+	VkDescriptorSet descriptorSets[5];
+	uint32_t dynamicOffsets[2];
+} VulkanBoundDescriptorSets;
+
+/* Uniform set last resolved from a pushed offset */
+typedef struct VulkanUniformBinding
+{
+	uint32_t blockKey; /* frame slot and block index */
+	VkDeviceSize range;
+	VkDescriptorSet descriptorSet; /* VK_NULL_HANDLE until resolved */
+} VulkanUniformBinding;
+
 typedef struct VulkanCommandBuffer
 {
 	VkCommandBuffer commandBuffer;
@@ -1161,8 +1560,106 @@ typedef struct VulkanCommandBuffer
 
 	VulkanBuffer *boundComputeBuffers[MAX_BUFFER_BINDINGS];
 	uint32_t boundComputeBufferCount;
+
+	/* Textures recorded since the last submission, pinned until then */
+	VulkanTexture **recordedTextures;
+	uint32_t recordedTextureCount;
+	uint32_t recordedTextureCapacity;
+
+	/* Sets chosen by the Bind*Samplers and BindCompute* calls */
+	VkDescriptorSet vertexSamplerDescriptorSet;
+	VkDescriptorSet fragmentSamplerDescriptorSet;
+	VkDescriptorSet computeBufferDescriptorSet;
+	VkDescriptorSet computeImageDescriptorSet;
+
+	/* Sets of the uniform blocks the draws and dispatches read from */
+	VulkanUniformBinding vertexUniformBinding;
+	VulkanUniformBinding fragmentUniformBinding;
+	VulkanUniformBinding computeUniformBinding;
+
+	/* Vulkan state recorded so far, used to skip redundant binds */
+	VkPipeline boundGraphicsPipeline;
+	VkPipeline boundComputePipeline;
+	VkBuffer boundVertexBuffers[MAX_BUFFER_BINDINGS];
+	VkDeviceSize boundVertexBufferOffsets[MAX_BUFFER_BINDINGS];
+	VkBuffer boundIndexBuffer;
+	VkDeviceSize boundIndexBufferOffset;
+	VkIndexType boundIndexType;
+	VulkanBoundDescriptorSets boundGraphicsSets;
+	VulkanBoundDescriptorSets boundComputeSets;
+
+	Refresh_CommandBufferStats stats;
 } VulkanCommandBuffer;
 
+/* Uniform buffer blocks */
+
+typedef struct VulkanUniformDescriptorSet
+{
+	VkDeviceSize range;
+	VkDescriptorSet descriptorSet;
+} VulkanUniformDescriptorSet;
+
+/* One dynamic offset descriptor set per pipeline block size in use */
+typedef struct VulkanUniformBlock
+{
+	VulkanBuffer *buffer;
+	VulkanUniformDescriptorSet *descriptorSets;
+	uint32_t descriptorSetCount;
+	uint32_t descriptorSetCapacity;
+} VulkanUniformBlock;
+
+/* The blocks of one frame slot, filled in order */
+typedef struct VulkanUniformBlockChain
+{
+	VulkanUniformBlock **blocks;
+	uint32_t blockCount;
+	uint32_t blockCapacity;
+	uint32_t currentBlockIndex;
+	uint32_t offset; /* next unreserved byte in the current block */
+	uint32_t quietFrameCount; /* frames in a row that left a block unused */
+} VulkanUniformBlockChain;
+
+typedef struct VulkanUniformBufferPool
+{
+	VkDescriptorSetLayout descriptorSetLayout;
+	VulkanResourceAccessType resourceAccessType;
+	VkDescriptorSet dummyDescriptorSet; /* for pipelines without uniforms */
+	VulkanUniformBlockChain chains[MAX_FRAMES_IN_FLIGHT]; /* indexed by frameIndex */
+
+	/* Block descriptor sets, grown like the descriptor set caches.
+	 * Sets of released blocks go back to the inactive list.
+	 */
+	VkDescriptorPool *descriptorPools;
+	uint32_t descriptorPoolCount;
+	uint32_t nextPoolSize;
+	VkDescriptorSet *inactiveDescriptorSets;
+	uint32_t inactiveDescriptorSetCount;
+	uint32_t inactiveDescriptorSetCapacity;
+	SDL_atomic_t epoch; /* bumped on reset, invalidates all chunks */
+} VulkanUniformBufferPool;
+
+/* A range of the current frame's block owned by one thread.
+ * Pushes sub-allocate from it without taking uniformBufferLock.
+ */
+typedef struct VulkanUniformChunk
+{
+	VulkanUniformBlock *block; /* NULL until first reserved */
+	int epoch;
+	uint32_t blockKey; /* frame slot and block index, stored above pushed offsets */
+	uint32_t offset;
+	uint32_t end;
+} VulkanUniformChunk;
+
+/* Buffers are recycled from a pool once the client has read the results */
+typedef struct VulkanBufferReadback /* cast from Refresh_BufferReadback */
+{
+	VulkanBuffer *buffer; /* READBACK memory, at least size bytes */
+	VkDeviceSize size;
+	VulkanCommandBuffer *commandBuffer; /* NULL once submitted */
+	uint64_t submission; /* 0 until submitted */
+	uint8_t inUse;
+} VulkanBufferReadback;
+
 struct VulkanCommandPool
 {
 	SDL_threadID threadID;
@@ -1171,6 +1668,42 @@ struct VulkanCommandPool
 	VulkanCommandBuffer **inactiveCommandBuffers;
 	uint32_t inactiveCommandBufferCapacity;
 	uint32_t inactiveCommandBufferCount;
+
+	/* Only touched by the owning thread */
+	VulkanUniformChunk vertexUniformChunk;
+	VulkanUniformChunk fragmentUniformChunk;
+	VulkanUniformChunk computeUniformChunk;
+
+	/* Descriptor set caches of this thread, indexed by DescriptorSetCacheInfo id.
+	 * Entries are NULL until the thread first binds with that layout.
+	 */
+	ImageDescriptorSetCache **imageDescriptorSetCaches;
+	uint32_t imageDescriptorSetCacheCount;
+	BufferDescriptorSetCache **bufferDescriptorSetCaches;
+	uint32_t bufferDescriptorSetCacheCount;
+
+	/* Caches holding at least one set */
+	ImageDescriptorSetCache **activeImageDescriptorSetCaches;
+	uint32_t activeImageDescriptorSetCacheCount;
+	uint32_t activeImageDescriptorSetCacheCapacity;
+
+	BufferDescriptorSetCache **activeBufferDescriptorSetCaches;
+	uint32_t activeBufferDescriptorSetCacheCount;
+	uint32_t activeBufferDescriptorSetCacheCapacity;
+
+	uint32_t descriptorSetResetSubmission; /* recordingSubmission at the last eviction */
+
+	/* Handles replaced by defragmentation. Other threads queue them under
+	 * expirationLock and the owning thread applies them on its next fetch.
+	 */
+	SDL_mutex *expirationLock;
+	SDL_atomic_t expirationPending;
+	VkImageView *expiredImageViews;
+	uint32_t expiredImageViewCount;
+	uint32_t expiredImageViewCapacity;
+	VkBuffer *expiredBuffers;
+	uint32_t expiredBufferCount;
+	uint32_t expiredBufferCapacity;
 };
 
 #define NUM_COMMAND_POOL_BUCKETS 1031
@@ -1244,6 +1777,69 @@ static inline void CommandPoolHashTable_Insert(
 	arr->count += 1;
 }
 
+/* Work submitted from one frame slot, released once the slot's fence signals */
+typedef struct VulkanFrame
+{
+	uint64_t submission; /* 0 until first submitted */
+	uint8_t needsCleanup; /* submitted work not yet released */
+
+	VulkanCommandBuffer **submittedCommandBuffers;
+	uint32_t submittedCommandBufferCount;
+	uint32_t submittedCommandBufferCapacity;
+
+	VulkanBuffer **submittedBuffers;
+	uint32_t submittedBufferCount;
+	uint32_t submittedBufferCapacity;
+
+	/* Deferred destroy storage */
+
+	VulkanRenderTarget **submittedRenderTargetsToDestroy;
+	uint32_t submittedRenderTargetsToDestroyCount;
+	uint32_t submittedRenderTargetsToDestroyCapacity;
+
+	VulkanTexture **submittedTexturesToDestroy;
+	uint32_t submittedTexturesToDestroyCount;
+	uint32_t submittedTexturesToDestroyCapacity;
+
+	VulkanBuffer **submittedBuffersToDestroy;
+	uint32_t submittedBuffersToDestroyCount;
+	uint32_t submittedBuffersToDestroyCapacity;
+
+	VulkanGraphicsPipeline **submittedGraphicsPipelinesToDestroy;
+	uint32_t submittedGraphicsPipelinesToDestroyCount;
+	uint32_t submittedGraphicsPipelinesToDestroyCapacity;
+
+	VulkanComputePipeline **submittedComputePipelinesToDestroy;
+	uint32_t submittedComputePipelinesToDestroyCount;
+	uint32_t submittedComputePipelinesToDestroyCapacity;
+
+	VkShaderModule *submittedShaderModulesToDestroy;
+	uint32_t submittedShaderModulesToDestroyCount;
+	uint32_t submittedShaderModulesToDestroyCapacity;
+
+	VkSampler *submittedSamplersToDestroy;
+	uint32_t submittedSamplersToDestroyCount;
+	uint32_t submittedSamplersToDestroyCapacity;
+
+	VulkanFramebuffer **submittedFramebuffersToDestroy;
+	uint32_t submittedFramebuffersToDestroyCount;
+	uint32_t submittedFramebuffersToDestroyCapacity;
+
+	VkRenderPass *submittedRenderPassesToDestroy;
+	uint32_t submittedRenderPassesToDestroyCount;
+	uint32_t submittedRenderPassesToDestroyCapacity;
+} VulkanFrame;
+
+/* Slots of one global bindless array. Freed slots are reused first. */
+typedef struct VulkanBindlessIndices
+{
+	uint32_t capacity;
+	uint32_t nextIndex;
+	uint32_t *freeIndices;
+	uint32_t freeIndexCount;
+	uint32_t freeIndexCapacity;
+} VulkanBindlessIndices;
+
 /* Context */
 
 typedef struct VulkanRenderer
@@ -1263,6 +1859,15 @@ typedef struct VulkanRenderer
 	VulkanMemoryAllocator *memoryAllocator;
 	VkPhysicalDeviceMemoryProperties memoryProperties;
 
+	uint8_t supportsMemoryBudget;
+	uint8_t supportsMultiDrawIndirect;
+	uint8_t supportsMultiDraw;
+	uint8_t supportsBindless;
+	Refresh_MemoryBudgetFunc memoryBudgetCallback;
+	void *memoryBudgetUserdata;
+	float memoryBudgetThreshold;
+	uint32_t memoryBudgetExceededHeaps; /* bit per heap, cleared when back under */
+
     Refresh_PresentMode presentMode;
     VkSurfaceKHR surface;
     VkSwapchainKHR swapChain;
@@ -1279,6 +1884,7 @@ typedef struct VulkanRenderer
 	uint8_t shouldPresent;
 	uint8_t swapChainImageAcquired;
 	uint32_t currentSwapChainIndex;
+	VkSemaphore swapChainAcquireSemaphore; /* signaled by the acquire in QueuePresent */
 
     QueueFamilyIndices queueFamilyIndices;
 	VkQueue graphicsQueue;
@@ -1286,24 +1892,25 @@ typedef struct VulkanRenderer
 	VkQueue computeQueue;
 	VkQueue transferQueue;
 
-	VkFence inFlightFence;
-	VkSemaphore transferFinishedSemaphore;
-	VkSemaphore imageAvailableSemaphore;
-	VkSemaphore renderFinishedSemaphore;
+	/* Indexed by frameIndex */
+	VkFence inFlightFences[MAX_FRAMES_IN_FLIGHT];
+	VkSemaphore transferFinishedSemaphores[MAX_FRAMES_IN_FLIGHT];
+	VkSemaphore imageAvailableSemaphores[MAX_FRAMES_IN_FLIGHT];
+	VkSemaphore renderFinishedSemaphores[MAX_FRAMES_IN_FLIGHT];
 
 	VkCommandPool transferCommandPool;
-	VkCommandBuffer transferCommandBuffers[2]; /* frame count */
+	VkCommandBuffer transferCommandBuffers[MAX_FRAMES_IN_FLIGHT];
 	uint8_t pendingTransfer;
 
-	VulkanCommandBuffer **submittedCommandBuffers;
-	uint32_t submittedCommandBufferCount;
-	uint32_t submittedCommandBufferCapacity;
-
 	CommandPoolHashTable commandPoolHashTable;
 	DescriptorSetLayoutHashTable descriptorSetLayoutHashTable;
 	GraphicsPipelineLayoutHashTable graphicsPipelineLayoutHashTable;
 	ComputePipelineLayoutHashTable computePipelineLayoutHashTable;
 
+	/* Next DescriptorSetCacheInfo ids */
+	SDL_atomic_t imageDescriptorSetCacheInfoCount;
+	SDL_atomic_t bufferDescriptorSetCacheInfoCount;
+
 	/* initialize baseline descriptor info */
 	VkDescriptorPool defaultDescriptorPool;
 
@@ -1317,6 +1924,16 @@ typedef struct VulkanRenderer
 	VkDescriptorSet emptyComputeBufferDescriptorSet;
 	VkDescriptorSet emptyComputeImageDescriptorSet;
 
+	/* Bound after every other set when supportsBindless is set.
+	 * Binding 0 holds sampled images, binding 1 holds samplers.
+	 */
+	VkDescriptorPool bindlessDescriptorPool;
+	VkDescriptorSetLayout bindlessDescriptorSetLayout;
+	VkDescriptorSet bindlessDescriptorSet;
+	VulkanBindlessIndices bindlessTextureIndices;
+	VulkanBindlessIndices bindlessSamplerIndices;
+	VkSampler *bindlessSamplers; /* by index, VK_NULL_HANDLE when free */
+
 	VkDescriptorSetLayout vertexParamLayout;
 	VkDescriptorSetLayout fragmentParamLayout;
 	VkDescriptorSetLayout computeParamLayout;
@@ -1324,39 +1941,38 @@ typedef struct VulkanRenderer
 	VulkanBuffer *dummyFragmentUniformBuffer;
 	VulkanBuffer *dummyComputeUniformBuffer;
 
-	VulkanBuffer *textureStagingBuffer;
+	VulkanBuffer *textureStagingBuffers[MAX_FRAMES_IN_FLIGHT];
 	VkDeviceSize textureStagingBufferOffset;
 
 	VulkanBuffer** buffersInUse;
 	uint32_t buffersInUseCount;
 	uint32_t buffersInUseCapacity;
 
-	VulkanBuffer** submittedBuffers;
-	uint32_t submittedBufferCount;
-	uint32_t submittedBufferCapacity;
-
-	VulkanBuffer *vertexUBO;
-	VulkanBuffer *fragmentUBO;
-	VulkanBuffer *computeUBO;
-	uint32_t minUBOAlignment;
-
-	uint32_t vertexUBOOffset;
-	VkDeviceSize vertexUBOBlockIncrement;
+	VulkanBufferReadback **readbacks;
+	uint32_t readbackCount;
+	uint32_t readbackCapacity;
 
-	uint32_t fragmentUBOOffset;
-	VkDeviceSize fragmentUBOBlockIncrement;
+	/* Submissions older than the ones in frames have been waited on */
+	uint64_t submissionCount;
+	SDL_atomic_t recordingSubmission; /* low bits of submissionCount, read by recording threads */
 
-	uint32_t computeUBOOffset;
-	VkDeviceSize computeUBOBlockIncrement;
+	VulkanUniformBufferPool *vertexUniformBufferPool;
+	VulkanUniformBufferPool *fragmentUniformBufferPool;
+	VulkanUniformBufferPool *computeUniformBufferPool;
+	uint32_t minUBOAlignment;
 
+	VulkanFrame frames[MAX_FRAMES_IN_FLIGHT];
+	uint32_t framesInFlight; /* 2 to MAX_FRAMES_IN_FLIGHT */
 	uint32_t frameIndex;
 
 	SDL_mutex *allocatorLock;
 	SDL_mutex *disposeLock;
 	SDL_mutex *uniformBufferLock;
-	SDL_mutex *descriptorSetLock;
 	SDL_mutex *boundBufferLock;
 	SDL_mutex *stagingLock;
+	SDL_mutex *readbackLock;
+	SDL_mutex *bindlessLock;
+	SDL_mutex *commandPoolLock; /* guards commandPoolHashTable */
 
 	/* Deferred destroy storage */
 
@@ -1364,74 +1980,38 @@ typedef struct VulkanRenderer
 	uint32_t renderTargetsToDestroyCount;
 	uint32_t renderTargetsToDestroyCapacity;
 
-	VulkanRenderTarget **submittedRenderTargetsToDestroy;
-	uint32_t submittedRenderTargetsToDestroyCount;
-	uint32_t submittedRenderTargetsToDestroyCapacity;
-
 	VulkanTexture **texturesToDestroy;
 	uint32_t texturesToDestroyCount;
 	uint32_t texturesToDestroyCapacity;
 
-	VulkanTexture **submittedTexturesToDestroy;
-	uint32_t submittedTexturesToDestroyCount;
-	uint32_t submittedTexturesToDestroyCapacity;
-
 	VulkanBuffer **buffersToDestroy;
 	uint32_t buffersToDestroyCount;
 	uint32_t buffersToDestroyCapacity;
 
-	VulkanBuffer **submittedBuffersToDestroy;
-	uint32_t submittedBuffersToDestroyCount;
-	uint32_t submittedBuffersToDestroyCapacity;
-
 	VulkanGraphicsPipeline **graphicsPipelinesToDestroy;
 	uint32_t graphicsPipelinesToDestroyCount;
 	uint32_t graphicsPipelinesToDestroyCapacity;
 
-	VulkanGraphicsPipeline **submittedGraphicsPipelinesToDestroy;
-	uint32_t submittedGraphicsPipelinesToDestroyCount;
-	uint32_t submittedGraphicsPipelinesToDestroyCapacity;
-
 	VulkanComputePipeline **computePipelinesToDestroy;
 	uint32_t computePipelinesToDestroyCount;
 	uint32_t computePipelinesToDestroyCapacity;
 
-	VulkanComputePipeline **submittedComputePipelinesToDestroy;
-	uint32_t submittedComputePipelinesToDestroyCount;
-	uint32_t submittedComputePipelinesToDestroyCapacity;
-
 	VkShaderModule *shaderModulesToDestroy;
 	uint32_t shaderModulesToDestroyCount;
 	uint32_t shaderModulesToDestroyCapacity;
 
-	VkShaderModule *submittedShaderModulesToDestroy;
-	uint32_t submittedShaderModulesToDestroyCount;
-	uint32_t submittedShaderModulesToDestroyCapacity;
-
 	VkSampler *samplersToDestroy;
 	uint32_t samplersToDestroyCount;
 	uint32_t samplersToDestroyCapacity;
 
-	VkSampler *submittedSamplersToDestroy;
-	uint32_t submittedSamplersToDestroyCount;
-	uint32_t submittedSamplersToDestroyCapacity;
-
 	VulkanFramebuffer **framebuffersToDestroy;
 	uint32_t framebuffersToDestroyCount;
 	uint32_t framebuffersToDestroyCapacity;
 
-	VulkanFramebuffer **submittedFramebuffersToDestroy;
-	uint32_t submittedFramebuffersToDestroyCount;
-	uint32_t submittedFramebuffersToDestroyCapacity;
-
 	VkRenderPass *renderPassesToDestroy;
 	uint32_t renderPassesToDestroyCount;
 	uint32_t renderPassesToDestroyCapacity;
 
-	VkRenderPass *submittedRenderPassesToDestroy;
-	uint32_t submittedRenderPassesToDestroyCount;
-	uint32_t submittedRenderPassesToDestroyCapacity;
-
 	/* External Interop */
 
 	uint8_t usesExternalDevice;
@@ -1448,6 +2028,13 @@ typedef struct VulkanRenderer
 static void VULKAN_INTERNAL_BeginCommandBuffer(VulkanRenderer *renderer, VulkanCommandBuffer *commandBuffer);
 static void VULKAN_Submit(Refresh_Renderer *driverData, uint32_t commandBufferCount, Refresh_CommandBuffer **pCommandBuffers);
 static void VULKAN_INTERNAL_FlushTransfers(VulkanRenderer *renderer);
+static void VULKAN_INTERNAL_MarkAsBound(VulkanRenderer* renderer, VulkanBuffer* buf);
+static void VULKAN_INTERNAL_TrackTexture(VulkanRenderer *renderer, VulkanCommandBuffer *commandBuffer, VulkanTexture *texture);
+static VkDescriptorSet VULKAN_INTERNAL_FetchPushedUniformDescriptorSet(VulkanRenderer *renderer, VulkanUniformBufferPool *pool, VulkanUniformBinding *binding, VkDeviceSize blockSize, uint32_t paramOffset, uint32_t *dynamicOffset);
+static void VULKAN_INTERNAL_DestroyUniformBufferPool(VulkanRenderer *renderer, VulkanUniformBufferPool *pool);
+static VulkanCommandPool* VULKAN_INTERNAL_FetchCommandPool(VulkanRenderer *renderer, SDL_threadID threadID);
+static void VULKAN_INTERNAL_ResetCommandBuffer(VulkanRenderer *renderer, VulkanCommandBuffer *commandBuffer);
+static void VULKAN_INTERNAL_ApplyDescriptorSetExpirations(VulkanCommandPool *commandPool);
 
 /* Error Handling */
 
@@ -1609,128 +2196,472 @@ static inline VkDeviceSize VULKAN_INTERNAL_NextHighestAlignment(
 	return align * ((n + align - 1) / align);
 }
 
-static void VULKAN_INTERNAL_RemoveMemoryFreeRegion(
-	VulkanMemoryFreeRegion *freeRegion
+static inline uint32_t VULKAN_INTERNAL_LowestBitIndex(uint64_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return (uint32_t) __builtin_ctzll(value);
+#else
+	uint32_t index = 0;
+
+	while ((value & 1) == 0)
+	{
+		value >>= 1;
+		index += 1;
+	}
+
+	return index;
+#endif
+}
+
+static inline uint32_t VULKAN_INTERNAL_HighestBitIndex(uint64_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return 63 - (uint32_t) __builtin_clzll(value);
+#else
+	uint32_t index = 0;
+
+	while (value >>= 1)
+	{
+		index += 1;
+	}
+
+	return index;
+#endif
+}
+
+static inline void VULKAN_INTERNAL_MapRegionSize(
+	VkDeviceSize size,
+	uint32_t *pFirstLevel,
+	uint32_t *pSecondLevel
+) {
+	uint32_t highestBit;
+
+	if (size < TLSF_SMALL_BLOCK_SIZE)
+	{
+		*pFirstLevel = 0;
+		*pSecondLevel = (uint32_t) size / (TLSF_SMALL_BLOCK_SIZE / TLSF_SL_INDEX_COUNT);
+	}
+	else
+	{
+		highestBit = VULKAN_INTERNAL_HighestBitIndex(size);
+		*pFirstLevel = highestBit - (TLSF_FL_INDEX_SHIFT - 1);
+		*pSecondLevel = (uint32_t) (size >> (highestBit - TLSF_SL_INDEX_COUNT_LOG2)) ^ TLSF_SL_INDEX_COUNT;
+	}
+}
+
+static VulkanMemoryRegion* VULKAN_INTERNAL_AcquireMemoryRegion(
+	VulkanMemoryAllocator *memoryAllocator
 ) {
+	VulkanMemoryRegion *region;
+	VulkanMemoryRegion *chunk;
 	uint32_t i;
 
-	/* close the gap in the sorted list */
-	if (freeRegion->allocation->allocator->sortedFreeRegionCount > 1)
+	if (memoryAllocator->regionPool == NULL)
 	{
-		for (i = freeRegion->sortedIndex; i < freeRegion->allocation->allocator->sortedFreeRegionCount - 1; i += 1)
-		{
-			freeRegion->allocation->allocator->sortedFreeRegions[i] =
-				freeRegion->allocation->allocator->sortedFreeRegions[i + 1];
+		chunk = SDL_malloc(sizeof(VulkanMemoryRegion) * MEMORY_REGION_POOL_CHUNK_SIZE);
+
+		memoryAllocator->regionPoolChunkCount += 1;
+		memoryAllocator->regionPoolChunks = SDL_realloc(
+			memoryAllocator->regionPoolChunks,
+			sizeof(VulkanMemoryRegion*) * memoryAllocator->regionPoolChunkCount
+		);
+		memoryAllocator->regionPoolChunks[memoryAllocator->regionPoolChunkCount - 1] = chunk;
 
-			freeRegion->allocation->allocator->sortedFreeRegions[i]->sortedIndex = i;
+		for (i = 0; i < MEMORY_REGION_POOL_CHUNK_SIZE; i += 1)
+		{
+			chunk[i].nextFree = memoryAllocator->regionPool;
+			memoryAllocator->regionPool = &chunk[i];
 		}
 	}
 
-	freeRegion->allocation->allocator->sortedFreeRegionCount -= 1;
+	region = memoryAllocator->regionPool;
+	memoryAllocator->regionPool = region->nextFree;
 
-	/* close the gap in the buffer list */
-	if (freeRegion->allocation->freeRegionCount > 1 && freeRegion->allocationIndex != freeRegion->allocation->freeRegionCount - 1)
-	{
-		freeRegion->allocation->freeRegions[freeRegion->allocationIndex] =
-			freeRegion->allocation->freeRegions[freeRegion->allocation->freeRegionCount - 1];
+	return region;
+}
+
+static inline void VULKAN_INTERNAL_ReleaseMemoryRegion(
+	VulkanMemoryAllocator *memoryAllocator,
+	VulkanMemoryRegion *region
+) {
+	region->nextFree = memoryAllocator->regionPool;
+	memoryAllocator->regionPool = region;
+}
+
+static void VULKAN_INTERNAL_InsertFreeRegion(
+	VulkanMemorySubAllocator *allocator,
+	VulkanMemoryRegion *region
+) {
+	uint32_t firstLevel, secondLevel;
+
+	VULKAN_INTERNAL_MapRegionSize(region->size, &firstLevel, &secondLevel);
 
-		freeRegion->allocation->freeRegions[freeRegion->allocationIndex]->allocationIndex =
-			freeRegion->allocationIndex;
+	region->isFree = 1;
+	region->prevFree = NULL;
+	region->nextFree = allocator->freeLists[firstLevel][secondLevel];
+
+	if (region->nextFree != NULL)
+	{
+		region->nextFree->prevFree = region;
 	}
 
-	freeRegion->allocation->freeRegionCount -= 1;
+	allocator->freeLists[firstLevel][secondLevel] = region;
+	allocator->firstLevelBitmap |= (uint64_t) 1 << firstLevel;
+	allocator->secondLevelBitmaps[firstLevel] |= 1u << secondLevel;
 
-	SDL_free(freeRegion);
+	allocator->totalFreeBytes += region->size;
+	allocator->freeRegionCount += 1;
 }
 
-static void VULKAN_INTERNAL_NewMemoryFreeRegion(
-	VulkanMemoryAllocation *allocation,
-	VkDeviceSize offset,
-	VkDeviceSize size
+static void VULKAN_INTERNAL_RemoveFreeRegion(
+	VulkanMemorySubAllocator *allocator,
+	VulkanMemoryRegion *region
 ) {
-	VulkanMemoryFreeRegion *newFreeRegion;
-	VkDeviceSize newOffset, newSize;
-	int32_t insertionIndex = 0;
-	int32_t i;
+	uint32_t firstLevel, secondLevel;
 
-	/* look for an adjacent region to merge */
-	for (i = allocation->freeRegionCount - 1; i >= 0; i -= 1)
+	VULKAN_INTERNAL_MapRegionSize(region->size, &firstLevel, &secondLevel);
+
+	if (region->nextFree != NULL)
+	{
+		region->nextFree->prevFree = region->prevFree;
+	}
+
+	if (region->prevFree != NULL)
 	{
-		/* check left side */
-		if (allocation->freeRegions[i]->offset + allocation->freeRegions[i]->size == offset)
+		region->prevFree->nextFree = region->nextFree;
+	}
+	else
+	{
+		allocator->freeLists[firstLevel][secondLevel] = region->nextFree;
+
+		if (region->nextFree == NULL)
 		{
-			newOffset = allocation->freeRegions[i]->offset;
-			newSize = allocation->freeRegions[i]->size + size;
+			allocator->secondLevelBitmaps[firstLevel] &= ~(1u << secondLevel);
 
-			VULKAN_INTERNAL_RemoveMemoryFreeRegion(allocation->freeRegions[i]);
-			VULKAN_INTERNAL_NewMemoryFreeRegion(allocation, newOffset, newSize);
-			return;
+			if (allocator->secondLevelBitmaps[firstLevel] == 0)
+			{
+				allocator->firstLevelBitmap &= ~((uint64_t) 1 << firstLevel);
+			}
 		}
+	}
 
-		/* check right side */
-		if (allocation->freeRegions[i]->offset == offset + size)
-		{
-			newOffset = offset;
-			newSize = allocation->freeRegions[i]->size + size;
+	allocator->totalFreeBytes -= region->size;
+	allocator->freeRegionCount -= 1;
 
-			VULKAN_INTERNAL_RemoveMemoryFreeRegion(allocation->freeRegions[i]);
-			VULKAN_INTERNAL_NewMemoryFreeRegion(allocation, newOffset, newSize);
-			return;
+	region->isFree = 0;
+	region->prevFree = NULL;
+	region->nextFree = NULL;
+}
+
+/* Returns a free region of at least size bytes, or NULL */
+static VulkanMemoryRegion* VULKAN_INTERNAL_SearchFreeRegion(
+	VulkanMemorySubAllocator *allocator,
+	VkDeviceSize size
+) {
+	uint32_t firstLevel, secondLevel, secondLevelMap;
+	uint64_t firstLevelMap;
+
+	/* Round up to the next list so every region in it is large enough */
+	if (size >= TLSF_SMALL_BLOCK_SIZE)
+	{
+		size += ((VkDeviceSize) 1 << (VULKAN_INTERNAL_HighestBitIndex(size) - TLSF_SL_INDEX_COUNT_LOG2)) - 1;
+	}
+	else
+	{
+		size += (TLSF_SMALL_BLOCK_SIZE / TLSF_SL_INDEX_COUNT) - 1;
+	}
+
+	VULKAN_INTERNAL_MapRegionSize(size, &firstLevel, &secondLevel);
+
+	if (firstLevel >= TLSF_FL_INDEX_COUNT)
+	{
+		return NULL;
+	}
+
+	secondLevelMap = allocator->secondLevelBitmaps[firstLevel] & (~0u << secondLevel);
+
+	if (secondLevelMap == 0)
+	{
+		firstLevelMap = allocator->firstLevelBitmap & (~((uint64_t) 0) << (firstLevel + 1));
+
+		if (firstLevelMap == 0)
+		{
+			return NULL;
 		}
+
+		firstLevel = VULKAN_INTERNAL_LowestBitIndex(firstLevelMap);
+		secondLevelMap = allocator->secondLevelBitmaps[firstLevel];
+	}
+
+	secondLevel = VULKAN_INTERNAL_LowestBitIndex(secondLevelMap);
+
+	return allocator->freeLists[firstLevel][secondLevel];
+}
+
+static inline uint8_t VULKAN_INTERNAL_RegionFits(
+	VulkanMemoryRegion *region,
+	VkDeviceSize size,
+	VkDeviceSize alignment,
+	VkDeviceSize *pAlignedOffset
+) {
+	*pAlignedOffset = VULKAN_INTERNAL_NextHighestAlignment(
+		region->offset,
+		alignment
+	);
+
+	return *pAlignedOffset + size <= region->offset + region->size;
+}
+
+/* Constant time: takes the head of the first size class that fits */
+static VulkanMemoryRegion* VULKAN_INTERNAL_SearchGoodFitRegion(
+	VulkanMemorySubAllocator *allocator,
+	VkDeviceSize size,
+	VkDeviceSize alignment,
+	VkDeviceSize *pAlignedOffset
+) {
+	VulkanMemoryRegion *region;
+
+	/* Any region in the matching list fits unless alignment padding gets in the way */
+	region = VULKAN_INTERNAL_SearchFreeRegion(allocator, size);
+
+	if (region != NULL && VULKAN_INTERNAL_RegionFits(region, size, alignment, pAlignedOffset))
+	{
+		return region;
 	}
 
-	/* region is not contiguous with another free region, make a new one */
-	allocation->freeRegionCount += 1;
-	if (allocation->freeRegionCount > allocation->freeRegionCapacity)
+	/* Searching with worst case padding guarantees a fit */
+	if (alignment > 1)
 	{
-		allocation->freeRegionCapacity *= 2;
-		allocation->freeRegions = SDL_realloc(
-			allocation->freeRegions,
-			sizeof(VulkanMemoryFreeRegion*) * allocation->freeRegionCapacity
+		region = VULKAN_INTERNAL_SearchFreeRegion(
+			allocator,
+			size + alignment - 1
 		);
+
+		if (region != NULL)
+		{
+			VULKAN_INTERNAL_RegionFits(region, size, alignment, pAlignedOffset);
+			return region;
+		}
 	}
 
-	newFreeRegion = SDL_malloc(sizeof(VulkanMemoryFreeRegion));
-	newFreeRegion->offset = offset;
-	newFreeRegion->size = size;
-	newFreeRegion->allocation = allocation;
+	return NULL;
+}
+
+/*
+ * Walks the size classes upward from the one containing size. Every region
+ * in a class is smaller than any region in the classes above it, so the
+ * smallest fitting region of the first class with a fit is the best fit.
+ */
+static VulkanMemoryRegion* VULKAN_INTERNAL_SearchBestFitRegion(
+	VulkanMemorySubAllocator *allocator,
+	VkDeviceSize size,
+	VkDeviceSize alignment,
+	VkDeviceSize *pAlignedOffset
+) {
+	VulkanMemoryRegion *region, *bestRegion;
+	VkDeviceSize alignedOffset;
+	uint32_t firstLevel, secondLevel, secondLevelMap;
+	uint64_t firstLevelMap;
+
+	VULKAN_INTERNAL_MapRegionSize(size, &firstLevel, &secondLevel);
+
+	if (firstLevel >= TLSF_FL_INDEX_COUNT)
+	{
+		return NULL;
+	}
 
-	allocation->freeRegions[allocation->freeRegionCount - 1] = newFreeRegion;
-	newFreeRegion->allocationIndex = allocation->freeRegionCount - 1;
+	secondLevelMap = allocator->secondLevelBitmaps[firstLevel] & (~0u << secondLevel);
+	firstLevelMap = allocator->firstLevelBitmap & (~((uint64_t) 0) << (firstLevel + 1));
 
-	for (i = 0; i < allocation->allocator->sortedFreeRegionCount; i += 1)
+	while (1)
 	{
-		if (allocation->allocator->sortedFreeRegions[i]->size < size)
+		if (secondLevelMap == 0)
 		{
-			/* this is where the new region should go */
-			break;
+			if (firstLevelMap == 0)
+			{
+				return NULL;
+			}
+
+			firstLevel = VULKAN_INTERNAL_LowestBitIndex(firstLevelMap);
+			firstLevelMap &= firstLevelMap - 1;
+			secondLevelMap = allocator->secondLevelBitmaps[firstLevel];
+		}
+
+		secondLevel = VULKAN_INTERNAL_LowestBitIndex(secondLevelMap);
+		secondLevelMap &= secondLevelMap - 1;
+
+		bestRegion = NULL;
+
+		for (
+			region = allocator->freeLists[firstLevel][secondLevel];
+			region != NULL;
+			region = region->nextFree
+		) {
+			if (	(bestRegion == NULL || region->size < bestRegion->size) &&
+				VULKAN_INTERNAL_RegionFits(region, size, alignment, &alignedOffset)	)
+			{
+				bestRegion = region;
+				*pAlignedOffset = alignedOffset;
+
+				if (region->size == size)
+				{
+					break;
+				}
+			}
+		}
+
+		if (bestRegion != NULL)
+		{
+			return bestRegion;
 		}
+	}
+}
+
+static VulkanMemoryRegion* VULKAN_INTERNAL_NewMemoryRegion(
+	VulkanMemoryAllocator *memoryAllocator,
+	VulkanMemoryAllocation *allocation,
+	VkDeviceSize offset,
+	VkDeviceSize size,
+	VulkanMemoryRegion *prevPhysical,
+	VulkanMemoryRegion *nextPhysical
+) {
+	VulkanMemoryRegion *region = VULKAN_INTERNAL_AcquireMemoryRegion(memoryAllocator);
+
+	region->allocation = allocation;
+	region->offset = offset;
+	region->size = size;
+	region->isFree = 0;
+	region->prevFree = NULL;
+	region->nextFree = NULL;
+	region->texture = NULL;
+	region->buffer = NULL;
+	region->subBufferIndex = 0;
+
+	region->prevPhysical = prevPhysical;
+	region->nextPhysical = nextPhysical;
+
+	if (prevPhysical != NULL)
+	{
+		prevPhysical->nextPhysical = region;
+	}
+	else
+	{
+		allocation->firstRegion = region;
+	}
+
+	if (nextPhysical != NULL)
+	{
+		nextPhysical->prevPhysical = region;
+	}
+
+	return region;
+}
+
+/* Splits a used range out of a free region, returning the excess to the free lists */
+static VulkanMemoryRegion* VULKAN_INTERNAL_SplitFreeRegion(
+	VulkanMemoryAllocator *memoryAllocator,
+	VulkanMemoryRegion *region,
+	VkDeviceSize alignedOffset,
+	VkDeviceSize size
+) {
+	VulkanMemorySubAllocator *allocator = region->allocation->allocator;
+	VulkanMemoryRegion *split;
+
+	VULKAN_INTERNAL_RemoveFreeRegion(allocator, region);
+
+	region->allocation->usedBytes += size;
+	region->allocation->usedRegionCount += 1;
+	region->allocation->emptyFrameCount = 0;
+	allocator->defragmentSourceDirty = 1;
+
+	if (alignedOffset != region->offset)
+	{
+		split = VULKAN_INTERNAL_NewMemoryRegion(
+			memoryAllocator,
+			region->allocation,
+			region->offset,
+			alignedOffset - region->offset,
+			region->prevPhysical,
+			region
+		);
+
+		region->offset = alignedOffset;
+		region->size -= split->size;
 
-		insertionIndex += 1;
+		VULKAN_INTERNAL_InsertFreeRegion(allocator, split);
 	}
 
-	if (allocation->allocator->sortedFreeRegionCount + 1 > allocation->allocator->sortedFreeRegionCapacity)
+	if (region->size > size)
 	{
-		allocation->allocator->sortedFreeRegionCapacity *= 2;
-		allocation->allocator->sortedFreeRegions = SDL_realloc(
-			allocation->allocator->sortedFreeRegions,
-			sizeof(VulkanMemoryFreeRegion*) * allocation->allocator->sortedFreeRegionCapacity
+		split = VULKAN_INTERNAL_NewMemoryRegion(
+			memoryAllocator,
+			region->allocation,
+			region->offset + size,
+			region->size - size,
+			region,
+			region->nextPhysical
 		);
+
+		region->size = size;
+
+		VULKAN_INTERNAL_InsertFreeRegion(allocator, split);
+	}
+
+	return region;
+}
+
+/* Returns a used region to its allocation, merging it with free neighbors */
+static void VULKAN_INTERNAL_FreeUsedRegion(
+	VulkanMemoryAllocator *memoryAllocator,
+	VulkanMemoryRegion *region
+) {
+	VulkanMemorySubAllocator *allocator = region->allocation->allocator;
+	VulkanMemoryRegion *neighbor;
+
+	region->allocation->usedBytes -= region->size;
+	region->allocation->usedRegionCount -= 1;
+	region->texture = NULL;
+	region->buffer = NULL;
+	allocator->defragmentSourceDirty = 1;
+
+	neighbor = region->prevPhysical;
+	if (neighbor != NULL && neighbor->isFree)
+	{
+		VULKAN_INTERNAL_RemoveFreeRegion(allocator, neighbor);
+
+		region->offset = neighbor->offset;
+		region->size += neighbor->size;
+		region->prevPhysical = neighbor->prevPhysical;
+
+		if (region->prevPhysical != NULL)
+		{
+			region->prevPhysical->nextPhysical = region;
+		}
+		else
+		{
+			region->allocation->firstRegion = region;
+		}
+
+		VULKAN_INTERNAL_ReleaseMemoryRegion(memoryAllocator, neighbor);
 	}
 
-	/* perform insertion sort */
-	if (allocation->allocator->sortedFreeRegionCount > 0 && insertionIndex != allocation->allocator->sortedFreeRegionCount)
+	neighbor = region->nextPhysical;
+	if (neighbor != NULL && neighbor->isFree)
 	{
-		for (i = allocation->allocator->sortedFreeRegionCount; i > insertionIndex && i > 0; i -= 1)
+		VULKAN_INTERNAL_RemoveFreeRegion(allocator, neighbor);
+
+		region->size += neighbor->size;
+		region->nextPhysical = neighbor->nextPhysical;
+
+		if (region->nextPhysical != NULL)
 		{
-			allocation->allocator->sortedFreeRegions[i] = allocation->allocator->sortedFreeRegions[i - 1];
-			allocation->allocator->sortedFreeRegions[i]->sortedIndex = i;
+			region->nextPhysical->prevPhysical = region;
 		}
+
+		VULKAN_INTERNAL_ReleaseMemoryRegion(memoryAllocator, neighbor);
 	}
 
-	allocation->allocator->sortedFreeRegionCount += 1;
-	allocation->allocator->sortedFreeRegions[insertionIndex] = newFreeRegion;
-	newFreeRegion->sortedIndex = insertionIndex;
+	VULKAN_INTERNAL_InsertFreeRegion(allocator, region);
 }
 
 static uint8_t VULKAN_INTERNAL_FindMemoryType(
@@ -1760,10 +2691,15 @@ static uint8_t VULKAN_INTERNAL_FindMemoryType(
 static uint8_t VULKAN_INTERNAL_FindBufferMemoryRequirements(
 	VulkanRenderer *renderer,
 	VkBuffer buffer,
+	VkMemoryPropertyFlags requiredMemoryPropertyFlags,
+	VkMemoryPropertyFlags preferredMemoryPropertyFlags,
 	VkMemoryRequirements2KHR *pMemoryRequirements,
 	uint32_t *pMemoryTypeIndex
 ) {
 	VkBufferMemoryRequirementsInfo2KHR bufferRequirementsInfo;
+	VkMemoryPropertyFlags flags = requiredMemoryPropertyFlags | preferredMemoryPropertyFlags;
+	uint32_t i;
+
 	bufferRequirementsInfo.sType =
 		VK_STRUCTURE_TYPE_BUFFER_MEMORY_REQUIREMENTS_INFO_2_KHR;
 	bufferRequirementsInfo.pNext = NULL;
@@ -1775,10 +2711,24 @@ static uint8_t VULKAN_INTERNAL_FindBufferMemoryRequirements(
 		pMemoryRequirements
 	);
 
+	/* Preferred properties are optional, so don't log if they're missing */
+	if (preferredMemoryPropertyFlags != 0)
+	{
+		for (i = 0; i < renderer->memoryProperties.memoryTypeCount; i += 1)
+		{
+			if (	(pMemoryRequirements->memoryRequirements.memoryTypeBits & (1 << i)) &&
+				(renderer->memoryProperties.memoryTypes[i].propertyFlags & flags) == flags	)
+			{
+				*pMemoryTypeIndex = i;
+				return 1;
+			}
+		}
+	}
+
 	if (!VULKAN_INTERNAL_FindMemoryType(
 		renderer,
 		pMemoryRequirements->memoryRequirements.memoryTypeBits,
-		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+		requiredMemoryPropertyFlags,
 		0,
 		pMemoryTypeIndex
 	)) {
@@ -1849,7 +2799,15 @@ static uint8_t VULKAN_INTERNAL_AllocateMemory(
 
 	allocation = SDL_malloc(sizeof(VulkanMemoryAllocation));
 	allocation->size = allocationSize;
+	allocation->nonCoherent = isHostVisible && !(
+		renderer->memoryProperties.memoryTypes[memoryTypeIndex].propertyFlags &
+		VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+	);
 	allocation->memoryLock = SDL_CreateMutex();
+	allocation->firstRegion = NULL;
+	allocation->usedBytes = 0;
+	allocation->usedRegionCount = 0;
+	allocation->emptyFrameCount = 0;
 
 	if (dedicated)
 	{
@@ -1880,9 +2838,6 @@ static uint8_t VULKAN_INTERNAL_AllocateMemory(
 		allocation->dedicated = 0;
 	}
 
-	allocation->freeRegions = SDL_malloc(sizeof(VulkanMemoryFreeRegion*));
-	allocation->freeRegionCount = 0;
-	allocation->freeRegionCapacity = 1;
 	allocation->allocator = allocator;
 
 	result = renderer->vkAllocateMemory(
@@ -1895,8 +2850,6 @@ static uint8_t VULKAN_INTERNAL_AllocateMemory(
 	if (result != VK_SUCCESS)
 	{
 		/* Uh oh, we couldn't allocate, time to clean up */
-		SDL_free(allocation->freeRegions);
-
 		allocator->allocationCount -= 1;
 		allocator->allocations = SDL_realloc(
 			allocator->allocations,
@@ -1909,6 +2862,12 @@ static uint8_t VULKAN_INTERNAL_AllocateMemory(
 		return 0;
 	}
 
+	allocator->allocatedBytes += allocationSize;
+	if (dedicated)
+	{
+		allocator->dedicatedAllocationCount += 1;
+	}
+
 	/* persistent mapping for host memory */
 	if (isHostVisible)
 	{
@@ -1932,16 +2891,40 @@ static uint8_t VULKAN_INTERNAL_AllocateMemory(
 		allocation->mapPointer = NULL;
 	}
 
-	VULKAN_INTERNAL_NewMemoryFreeRegion(
-		allocation,
-		0,
-		allocation->size
-	);
-
 	*pMemoryAllocation = allocation;
 	return 1;
 }
 
+static inline void VULKAN_INTERNAL_TrackResourceMemory(
+	VulkanMemorySubAllocator *allocator,
+	uint8_t isBuffer,
+	VkDeviceSize size
+) {
+	if (isBuffer)
+	{
+		allocator->bufferBytes += size;
+	}
+	else
+	{
+		allocator->textureBytes += size;
+	}
+}
+
+static inline void VULKAN_INTERNAL_UntrackResourceMemory(
+	VulkanMemorySubAllocator *allocator,
+	uint8_t isBuffer,
+	VkDeviceSize size
+) {
+	if (isBuffer)
+	{
+		allocator->bufferBytes -= size;
+	}
+	else
+	{
+		allocator->textureBytes -= size;
+	}
+}
+
 static uint8_t VULKAN_INTERNAL_FindAvailableMemory(
 	VulkanRenderer *renderer,
 	uint32_t memoryTypeIndex,
@@ -1950,16 +2933,16 @@ static uint8_t VULKAN_INTERNAL_FindAvailableMemory(
 	VkBuffer buffer, /* may be VK_NULL_HANDLE */
 	VkImage image, /* may be VK_NULL_HANDLE */
 	VulkanMemoryAllocation **pMemoryAllocation,
+	VulkanMemoryRegion **pRegion,
 	VkDeviceSize *pOffset,
 	VkDeviceSize *pSize
 ) {
 	VulkanMemoryAllocation *allocation;
 	VulkanMemorySubAllocator *allocator;
-	VulkanMemoryFreeRegion *region;
+	VulkanMemoryRegion *region;
 
-	VkDeviceSize requiredSize, allocationSize;
-	VkDeviceSize alignedOffset;
-	uint32_t newRegionSize, newRegionOffset;
+	VkDeviceSize requiredSize, allocationSize, alignment;
+	VkDeviceSize alignedOffset = 0;
 	uint8_t shouldAllocDedicated =
 		dedicatedRequirements->prefersDedicatedAllocation ||
 		dedicatedRequirements->requiresDedicatedAllocation;
@@ -1971,57 +2954,46 @@ static uint8_t VULKAN_INTERNAL_FindAvailableMemory(
 
 	allocator = &renderer->memoryAllocator->subAllocators[memoryTypeIndex];
 	requiredSize = memoryRequirements->memoryRequirements.size;
+	alignment = memoryRequirements->memoryRequirements.alignment;
 
 	SDL_LockMutex(renderer->allocatorLock);
 
-	/* find the largest free region and use it */
-	if (allocator->sortedFreeRegionCount > 0)
+	if (renderer->memoryAllocator->placementPolicy == REFRESH_MEMORYPLACEMENTPOLICY_BESTFIT)
 	{
-		region = allocator->sortedFreeRegions[0];
-		allocation = region->allocation;
-
-		alignedOffset = VULKAN_INTERNAL_NextHighestAlignment(
-			region->offset,
-			memoryRequirements->memoryRequirements.alignment
+		region = VULKAN_INTERNAL_SearchBestFitRegion(
+			allocator,
+			requiredSize,
+			alignment,
+			&alignedOffset
 		);
+	}
+	else
+	{
+		region = VULKAN_INTERNAL_SearchGoodFitRegion(
+			allocator,
+			requiredSize,
+			alignment,
+			&alignedOffset
+		);
+	}
 
-		if (alignedOffset + requiredSize <= region->offset + region->size)
-		{
-			*pMemoryAllocation = allocation;
-
-			/* not aligned - create a new free region */
-			if (region->offset != alignedOffset)
-			{
-				VULKAN_INTERNAL_NewMemoryFreeRegion(
-					allocation,
-					region->offset,
-					alignedOffset - region->offset
-				);
-			}
-
-			*pOffset = alignedOffset;
-			*pSize = requiredSize;
-
-			newRegionSize = region->size - ((alignedOffset - region->offset) + requiredSize);
-			newRegionOffset = alignedOffset + requiredSize;
-
-			/* remove and add modified region to re-sort */
-			VULKAN_INTERNAL_RemoveMemoryFreeRegion(region);
+	if (region != NULL)
+	{
+		*pMemoryAllocation = region->allocation;
+		*pRegion = VULKAN_INTERNAL_SplitFreeRegion(
+			renderer->memoryAllocator,
+			region,
+			alignedOffset,
+			requiredSize
+		);
+		*pOffset = alignedOffset;
+		*pSize = requiredSize;
 
-			/* if size is 0, no need to re-insert */
-			if (newRegionSize != 0)
-			{
-				VULKAN_INTERNAL_NewMemoryFreeRegion(
-					allocation,
-					newRegionOffset,
-					newRegionSize
-				);
-			}
+		VULKAN_INTERNAL_TrackResourceMemory(allocator, buffer != VK_NULL_HANDLE, requiredSize);
 
-			SDL_UnlockMutex(renderer->allocatorLock);
+		SDL_UnlockMutex(renderer->allocatorLock);
 
-			return 1;
-		}
+		return 1;
 	}
 
 	/* No suitable free regions exist, allocate a new memory region */
@@ -2067,35 +3039,51 @@ static uint8_t VULKAN_INTERNAL_FindAvailableMemory(
 	*pOffset = 0;
 	*pSize = requiredSize;
 
-	region = allocation->freeRegions[0];
-
-	newRegionOffset = region->offset + requiredSize;
-	newRegionSize = region->size - requiredSize;
+	VULKAN_INTERNAL_TrackResourceMemory(allocator, buffer != VK_NULL_HANDLE, requiredSize);
 
-	VULKAN_INTERNAL_RemoveMemoryFreeRegion(region);
-
-	if (newRegionSize != 0)
+	if (shouldAllocDedicated)
 	{
-		VULKAN_INTERNAL_NewMemoryFreeRegion(
-			allocation,
-			newRegionOffset,
-			newRegionSize
-		);
+		/* Dedicated allocations are freed whole, no regions needed */
+		*pRegion = NULL;
 	}
-
-	SDL_UnlockMutex(renderer->allocatorLock);
-
-	return 1;
+	else
+	{
+		region = VULKAN_INTERNAL_NewMemoryRegion(
+			renderer->memoryAllocator,
+			allocation,
+			0,
+			allocation->size,
+			NULL,
+			NULL
+		);
+
+		VULKAN_INTERNAL_InsertFreeRegion(allocator, region);
+
+		*pRegion = VULKAN_INTERNAL_SplitFreeRegion(
+			renderer->memoryAllocator,
+			region,
+			0,
+			requiredSize
+		);
+	}
+
+	SDL_UnlockMutex(renderer->allocatorLock);
+
+	return 1;
 }
 
 static uint8_t VULKAN_INTERNAL_FindAvailableBufferMemory(
 	VulkanRenderer *renderer,
 	VkBuffer buffer,
+	VulkanBufferMemoryUsage memoryUsage,
 	VulkanMemoryAllocation **pMemoryAllocation,
+	VulkanMemoryRegion **pRegion,
 	VkDeviceSize *pOffset,
 	VkDeviceSize *pSize
 ) {
 	uint32_t memoryTypeIndex;
+	VkMemoryPropertyFlags requiredMemoryPropertyFlags;
+	VkMemoryPropertyFlags preferredMemoryPropertyFlags = 0;
 	VkMemoryDedicatedRequirementsKHR dedicatedRequirements =
 	{
 		VK_STRUCTURE_TYPE_MEMORY_DEDICATED_REQUIREMENTS_KHR,
@@ -2107,9 +3095,30 @@ static uint8_t VULKAN_INTERNAL_FindAvailableBufferMemory(
 		&dedicatedRequirements
 	};
 
+	if (memoryUsage == VULKAN_BUFFER_MEMORY_DEVICE)
+	{
+		requiredMemoryPropertyFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+	}
+	else if (memoryUsage == VULKAN_BUFFER_MEMORY_READBACK)
+	{
+		/* CPU reads from uncached memory are very slow, and cached
+		 * memory is often only available without coherency
+		 */
+		requiredMemoryPropertyFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+		preferredMemoryPropertyFlags = VK_MEMORY_PROPERTY_HOST_CACHED_BIT;
+	}
+	else
+	{
+		requiredMemoryPropertyFlags =
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+			VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+	}
+
 	if (!VULKAN_INTERNAL_FindBufferMemoryRequirements(
 		renderer,
 		buffer,
+		requiredMemoryPropertyFlags,
+		preferredMemoryPropertyFlags,
 		&memoryRequirements,
 		&memoryTypeIndex
 	)) {
@@ -2117,6 +3126,22 @@ static uint8_t VULKAN_INTERNAL_FindAvailableBufferMemory(
 		return 0;
 	}
 
+	/* Flush and invalidate ranges are widened to whole atoms, so
+	 * non-coherent regions must not share an atom with a neighbour
+	 */
+	if (	memoryUsage == VULKAN_BUFFER_MEMORY_READBACK &&
+		!(renderer->memoryProperties.memoryTypes[memoryTypeIndex].propertyFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)	)
+	{
+		memoryRequirements.memoryRequirements.alignment = SDL_max(
+			memoryRequirements.memoryRequirements.alignment,
+			renderer->physicalDeviceProperties.properties.limits.nonCoherentAtomSize
+		);
+		memoryRequirements.memoryRequirements.size = VULKAN_INTERNAL_NextHighestAlignment(
+			memoryRequirements.memoryRequirements.size,
+			renderer->physicalDeviceProperties.properties.limits.nonCoherentAtomSize
+		);
+	}
+
 	return VULKAN_INTERNAL_FindAvailableMemory(
 		renderer,
 		memoryTypeIndex,
@@ -2125,6 +3150,7 @@ static uint8_t VULKAN_INTERNAL_FindAvailableBufferMemory(
 		buffer,
 		VK_NULL_HANDLE,
 		pMemoryAllocation,
+		pRegion,
 		pOffset,
 		pSize
 	);
@@ -2135,6 +3161,7 @@ static uint8_t VULKAN_INTERNAL_FindAvailableTextureMemory(
 	VkImage image,
 	uint8_t cpuAllocation,
 	VulkanMemoryAllocation **pMemoryAllocation,
+	VulkanMemoryRegion **pRegion,
 	VkDeviceSize *pOffset,
 	VkDeviceSize *pSize
 ) {
@@ -2183,6 +3210,7 @@ static uint8_t VULKAN_INTERNAL_FindAvailableTextureMemory(
 		VK_NULL_HANDLE,
 		image,
 		pMemoryAllocation,
+		pRegion,
 		pOffset,
 		pSize
 	);
@@ -2190,18 +3218,23 @@ static uint8_t VULKAN_INTERNAL_FindAvailableTextureMemory(
 
 /* Memory Barriers */
 
-static void VULKAN_INTERNAL_BufferMemoryBarrier(
+/* Like BufferMemoryBarrier, but the destination masks are given directly
+ * so a transition can cover several accesses at once.
+ */
+static void VULKAN_INTERNAL_BufferMemoryBarrierMasks(
 	VulkanRenderer *renderer,
 	VkCommandBuffer commandBuffer,
 	VulkanResourceAccessType nextResourceAccessType,
+	VkPipelineStageFlags nextStageMask,
+	VkAccessFlags nextAccessMask,
 	VulkanBuffer *buffer,
 	VulkanSubBuffer *subBuffer
 ) {
 	VkPipelineStageFlags srcStages = 0;
 	VkPipelineStageFlags dstStages = 0;
 	VkBufferMemoryBarrier memoryBarrier;
-	VulkanResourceAccessType prevAccess, nextAccess;
-	const VulkanResourceAccessInfo *prevAccessInfo, *nextAccessInfo;
+	VulkanResourceAccessType prevAccess;
+	const VulkanResourceAccessInfo *prevAccessInfo;
 
 	if (buffer->resourceAccessType == nextResourceAccessType)
 	{
@@ -2215,7 +3248,7 @@ static void VULKAN_INTERNAL_BufferMemoryBarrier(
 	memoryBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
 	memoryBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
 	memoryBarrier.buffer = subBuffer->buffer;
-	memoryBarrier.offset = 0;
+	memoryBarrier.offset = subBuffer->bufferOffset;
 	memoryBarrier.size = buffer->size;
 
 	prevAccess = buffer->resourceAccessType;
@@ -2228,14 +3261,11 @@ static void VULKAN_INTERNAL_BufferMemoryBarrier(
 		memoryBarrier.srcAccessMask |= prevAccessInfo->accessMask;
 	}
 
-	nextAccess = nextResourceAccessType;
-	nextAccessInfo = &AccessMap[nextAccess];
-
-	dstStages |= nextAccessInfo->stageMask;
+	dstStages |= nextStageMask;
 
 	if (memoryBarrier.srcAccessMask != 0)
 	{
-		memoryBarrier.dstAccessMask |= nextAccessInfo->accessMask;
+		memoryBarrier.dstAccessMask |= nextAccessMask;
 	}
 
 	if (srcStages == 0)
@@ -2263,6 +3293,73 @@ static void VULKAN_INTERNAL_BufferMemoryBarrier(
 	buffer->resourceAccessType = nextResourceAccessType;
 }
 
+static void VULKAN_INTERNAL_BufferMemoryBarrier(
+	VulkanRenderer *renderer,
+	VkCommandBuffer commandBuffer,
+	VulkanResourceAccessType nextResourceAccessType,
+	VulkanBuffer *buffer,
+	VulkanSubBuffer *subBuffer
+) {
+	VULKAN_INTERNAL_BufferMemoryBarrierMasks(
+		renderer,
+		commandBuffer,
+		nextResourceAccessType,
+		AccessMap[nextResourceAccessType].stageMask,
+		AccessMap[nextResourceAccessType].accessMask,
+		buffer,
+		subBuffer
+	);
+}
+
+/* Transitions a buffer written on the GPU to every read its usage implies */
+static void VULKAN_INTERNAL_BufferReadBarrier(
+	VulkanRenderer *renderer,
+	VkCommandBuffer commandBuffer,
+	VulkanBuffer *buffer,
+	VulkanSubBuffer *subBuffer
+) {
+	VulkanResourceAccessType reads[4];
+	uint32_t readCount = 0;
+	VkPipelineStageFlags stageMask = 0;
+	VkAccessFlags accessMask = 0;
+	uint32_t i;
+
+	if (buffer->usage & VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT)
+	{
+		reads[readCount++] = RESOURCE_ACCESS_INDIRECT_BUFFER;
+	}
+	if (buffer->usage & VK_BUFFER_USAGE_VERTEX_BUFFER_BIT)
+	{
+		reads[readCount++] = RESOURCE_ACCESS_VERTEX_BUFFER;
+	}
+	if (buffer->usage & VK_BUFFER_USAGE_INDEX_BUFFER_BIT)
+	{
+		reads[readCount++] = RESOURCE_ACCESS_INDEX_BUFFER;
+	}
+	if (	(buffer->usage & VK_BUFFER_USAGE_STORAGE_BUFFER_BIT) ||
+		readCount == 0	)
+	{
+		reads[readCount++] = RESOURCE_ACCESS_COMPUTE_SHADER_READ_OTHER;
+	}
+
+	for (i = 0; i < readCount; i += 1)
+	{
+		stageMask |= AccessMap[reads[i]].stageMask;
+		accessMask |= AccessMap[reads[i]].accessMask;
+	}
+
+	/* ANY_BUFFER_READ covers every read stage a later write must wait on */
+	VULKAN_INTERNAL_BufferMemoryBarrierMasks(
+		renderer,
+		commandBuffer,
+		(readCount == 1) ? reads[0] : RESOURCE_ACCESS_ANY_BUFFER_READ,
+		stageMask,
+		accessMask,
+		buffer,
+		subBuffer
+	);
+}
+
 static void VULKAN_INTERNAL_ImageMemoryBarrier(
 	VulkanRenderer *renderer,
 	VkCommandBuffer commandBuffer,
@@ -2355,12 +3452,201 @@ static void VULKAN_INTERNAL_ImageMemoryBarrier(
 
 /* Resource Disposal */
 
+static inline uint8_t VULKAN_INTERNAL_IsArenaSubBuffer(
+	VulkanRenderer *renderer,
+	VulkanSubBuffer *subBuffer
+) {
+	return subBuffer->allocation->allocator == &renderer->memoryAllocator->bufferArenas;
+}
+
+/* Bindless */
+
+static uint32_t VULKAN_INTERNAL_AcquireBindlessIndex(
+	VulkanBindlessIndices *indices
+) {
+	uint32_t index;
+
+	if (indices->freeIndexCount > 0)
+	{
+		indices->freeIndexCount -= 1;
+		return indices->freeIndices[indices->freeIndexCount];
+	}
+
+	if (indices->nextIndex == indices->capacity)
+	{
+		return REFRESH_BINDLESS_INDEX_NONE;
+	}
+
+	index = indices->nextIndex;
+	indices->nextIndex += 1;
+	return index;
+}
+
+static void VULKAN_INTERNAL_ReleaseBindlessIndex(
+	VulkanBindlessIndices *indices,
+	uint32_t index
+) {
+	EXPAND_ARRAY_IF_NEEDED(
+		indices->freeIndices,
+		uint32_t,
+		indices->freeIndexCount,
+		indices->freeIndexCapacity,
+		indices->freeIndexCapacity * 2
+	)
+
+	indices->freeIndices[indices->freeIndexCount] = index;
+	indices->freeIndexCount += 1;
+}
+
+/* Slots are only rewritten once their previous owner was destroyed, which
+ * happens after the last submission using it, so no pending work reads them.
+ */
+static void VULKAN_INTERNAL_WriteBindlessDescriptor(
+	VulkanRenderer *renderer,
+	uint32_t binding,
+	uint32_t index,
+	VkImageView imageView,
+	VkSampler sampler
+) {
+	VkDescriptorImageInfo imageInfo;
+	VkWriteDescriptorSet writeDescriptorSet;
+
+	imageInfo.sampler = sampler;
+	imageInfo.imageView = imageView;
+	imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+	writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+	writeDescriptorSet.pNext = NULL;
+	writeDescriptorSet.dstSet = renderer->bindlessDescriptorSet;
+	writeDescriptorSet.dstBinding = binding;
+	writeDescriptorSet.dstArrayElement = index;
+	writeDescriptorSet.descriptorCount = 1;
+	writeDescriptorSet.descriptorType = (binding == 0) ?
+		VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE :
+		VK_DESCRIPTOR_TYPE_SAMPLER;
+	writeDescriptorSet.pImageInfo = &imageInfo;
+	writeDescriptorSet.pBufferInfo = NULL;
+	writeDescriptorSet.pTexelBufferView = NULL;
+
+	renderer->vkUpdateDescriptorSets(
+		renderer->logicalDevice,
+		1,
+		&writeDescriptorSet,
+		0,
+		NULL
+	);
+}
+
+static void VULKAN_INTERNAL_AddBindlessTexture(
+	VulkanRenderer *renderer,
+	VulkanTexture *texture
+) {
+	SDL_LockMutex(renderer->bindlessLock);
+
+	texture->bindlessIndex = VULKAN_INTERNAL_AcquireBindlessIndex(
+		&renderer->bindlessTextureIndices
+	);
+
+	if (texture->bindlessIndex == REFRESH_BINDLESS_INDEX_NONE)
+	{
+		Refresh_LogWarn("Bindless texture array is full!");
+	}
+	else
+	{
+		VULKAN_INTERNAL_WriteBindlessDescriptor(
+			renderer,
+			0,
+			texture->bindlessIndex,
+			texture->view,
+			VK_NULL_HANDLE
+		);
+	}
+
+	SDL_UnlockMutex(renderer->bindlessLock);
+}
+
+static void VULKAN_INTERNAL_AddBindlessSampler(
+	VulkanRenderer *renderer,
+	VkSampler sampler
+) {
+	uint32_t index;
+
+	SDL_LockMutex(renderer->bindlessLock);
+
+	index = VULKAN_INTERNAL_AcquireBindlessIndex(
+		&renderer->bindlessSamplerIndices
+	);
+
+	if (index == REFRESH_BINDLESS_INDEX_NONE)
+	{
+		Refresh_LogWarn("Bindless sampler array is full!");
+	}
+	else
+	{
+		renderer->bindlessSamplers[index] = sampler;
+
+		VULKAN_INTERNAL_WriteBindlessDescriptor(
+			renderer,
+			1,
+			index,
+			VK_NULL_HANDLE,
+			sampler
+		);
+	}
+
+	SDL_UnlockMutex(renderer->bindlessLock);
+}
+
+/* Samplers are plain VkSampler handles, so look them up by value.
+ * Applications create few samplers, so a scan is cheap enough.
+ * Call with bindlessLock held.
+ */
+static uint32_t VULKAN_INTERNAL_FindBindlessSampler(
+	VulkanRenderer *renderer,
+	VkSampler sampler
+) {
+	uint32_t i;
+
+	for (i = 0; i < renderer->bindlessSamplerIndices.nextIndex; i += 1)
+	{
+		if (renderer->bindlessSamplers[i] == sampler)
+		{
+			return i;
+		}
+	}
+
+	return REFRESH_BINDLESS_INDEX_NONE;
+}
+
 static void VULKAN_INTERNAL_DestroyTexture(
 	VulkanRenderer* renderer,
 	VulkanTexture* texture
 ) {
+	if (texture->bindlessIndex != REFRESH_BINDLESS_INDEX_NONE)
+	{
+		SDL_LockMutex(renderer->bindlessLock);
+		VULKAN_INTERNAL_ReleaseBindlessIndex(
+			&renderer->bindlessTextureIndices,
+			texture->bindlessIndex
+		);
+		SDL_UnlockMutex(renderer->bindlessLock);
+	}
+
+	SDL_LockMutex(renderer->allocatorLock);
+
+	VULKAN_INTERNAL_UntrackResourceMemory(
+		texture->allocation->allocator,
+		0,
+		texture->memorySize
+	);
+
 	if (texture->allocation->dedicated)
 	{
+		texture->allocation->allocator->allocatedBytes -= texture->allocation->size;
+		texture->allocation->allocator->dedicatedAllocationCount -= 1;
+
+		SDL_UnlockMutex(renderer->allocatorLock);
+
 		renderer->vkFreeMemory(
 			renderer->logicalDevice,
 			texture->allocation->memory,
@@ -2368,17 +3654,13 @@ static void VULKAN_INTERNAL_DestroyTexture(
 		);
 
 		SDL_DestroyMutex(texture->allocation->memoryLock);
-		SDL_free(texture->allocation->freeRegions);
 		SDL_free(texture->allocation);
 	}
 	else
 	{
-		SDL_LockMutex(renderer->allocatorLock);
-
-		VULKAN_INTERNAL_NewMemoryFreeRegion(
-			texture->allocation,
-			texture->offset,
-			texture->memorySize
+		VULKAN_INTERNAL_FreeUsedRegion(
+			renderer->memoryAllocator,
+			texture->usedRegion
 		);
 
 		SDL_UnlockMutex(renderer->allocatorLock);
@@ -2424,6 +3706,80 @@ static void VULKAN_INTERNAL_DestroyRenderTarget(
 	SDL_free(renderTargetTarget);
 }
 
+/*
+ * Frees non-dedicated blocks that have stayed empty for a while.
+ * One block per memory type is always kept so that allocation churn
+ * around a single resource doesn't keep reallocating device memory.
+ */
+static void VULKAN_INTERNAL_ReleaseEmptyAllocations(
+	VulkanRenderer *renderer
+) {
+	VulkanMemorySubAllocator *allocator;
+	VulkanMemoryAllocation *allocation;
+	uint32_t i;
+	int32_t j;
+
+	SDL_LockMutex(renderer->allocatorLock);
+
+	for (i = 0; i < VK_MAX_MEMORY_TYPES; i += 1)
+	{
+		allocator = &renderer->memoryAllocator->subAllocators[i];
+
+		for (j = allocator->allocationCount - 1; j >= 0; j -= 1)
+		{
+			allocation = allocator->allocations[j];
+
+			if (allocation->usedRegionCount > 0)
+			{
+				continue;
+			}
+
+			allocation->emptyFrameCount += 1;
+
+			if (	allocation->emptyFrameCount < EMPTY_ALLOCATION_RELEASE_FRAMES ||
+				allocator->allocationCount == 1	)
+			{
+				continue;
+			}
+
+			/* Neighbors are always coalesced, so an empty block is one region */
+			VULKAN_INTERNAL_RemoveFreeRegion(allocator, allocation->firstRegion);
+			VULKAN_INTERNAL_ReleaseMemoryRegion(
+				renderer->memoryAllocator,
+				allocation->firstRegion
+			);
+
+			renderer->vkFreeMemory(
+				renderer->logicalDevice,
+				allocation->memory,
+				NULL
+			);
+
+			allocator->allocatedBytes -= allocation->size;
+
+			if (allocator->defragmentSource == allocation)
+			{
+				allocator->defragmentSource = NULL;
+				allocator->defragmentSourceDirty = 1;
+			}
+
+			SDL_DestroyMutex(allocation->memoryLock);
+			SDL_free(allocation);
+
+			allocator->allocations[j] = allocator->allocations[allocator->allocationCount - 1];
+			allocator->allocationCount -= 1;
+
+			/* We needed less memory than we thought, grow more slowly */
+			allocator->nextAllocationSize = SDL_max(
+				allocator->nextAllocationSize / 2,
+				STARTING_ALLOCATION_SIZE
+			);
+		}
+	}
+
+	SDL_UnlockMutex(renderer->allocatorLock);
+}
+
 static void VULKAN_INTERNAL_DestroyBuffer(
 	VulkanRenderer* renderer,
 	VulkanBuffer* buffer
@@ -2438,8 +3794,22 @@ static void VULKAN_INTERNAL_DestroyBuffer(
 
 	for (i = 0; i < buffer->subBufferCount; i += 1)
 	{
+		SDL_LockMutex(renderer->allocatorLock);
+
+		VULKAN_INTERNAL_UntrackResourceMemory(
+			buffer->subBuffers[i]->allocation->allocator,
+			1,
+			buffer->subBuffers[i]->size
+		);
+
 		if (buffer->subBuffers[i]->allocation->dedicated)
 		{
+			buffer->subBuffers[i]->allocation->allocator->allocatedBytes -=
+				buffer->subBuffers[i]->allocation->size;
+			buffer->subBuffers[i]->allocation->allocator->dedicatedAllocationCount -= 1;
+
+			SDL_UnlockMutex(renderer->allocatorLock);
+
 			renderer->vkFreeMemory(
 				renderer->logicalDevice,
 				buffer->subBuffers[i]->allocation->memory,
@@ -2447,27 +3817,27 @@ static void VULKAN_INTERNAL_DestroyBuffer(
 			);
 
 			SDL_DestroyMutex(buffer->subBuffers[i]->allocation->memoryLock);
-			SDL_free(buffer->subBuffers[i]->allocation->freeRegions);
 			SDL_free(buffer->subBuffers[i]->allocation);
 		}
 		else
 		{
-			SDL_LockMutex(renderer->allocatorLock);
-
-			VULKAN_INTERNAL_NewMemoryFreeRegion(
-				buffer->subBuffers[i]->allocation,
-				buffer->subBuffers[i]->offset,
-				buffer->subBuffers[i]->size
+			VULKAN_INTERNAL_FreeUsedRegion(
+				renderer->memoryAllocator,
+				buffer->subBuffers[i]->usedRegion
 			);
 
 			SDL_UnlockMutex(renderer->allocatorLock);
 		}
 
-		renderer->vkDestroyBuffer(
-			renderer->logicalDevice,
-			buffer->subBuffers[i]->buffer,
-			NULL
-		);
+		/* Arena VkBuffers are shared and owned by the arena */
+		if (!VULKAN_INTERNAL_IsArenaSubBuffer(renderer, buffer->subBuffers[i]))
+		{
+			renderer->vkDestroyBuffer(
+				renderer->logicalDevice,
+				buffer->subBuffers[i]->buffer,
+				NULL
+			);
+		}
 
 		SDL_free(buffer->subBuffers[i]);
 	}
@@ -2478,35 +3848,185 @@ static void VULKAN_INTERNAL_DestroyBuffer(
 	SDL_free(buffer);
 }
 
-static void VULKAN_INTERNAL_DestroyCommandPool(
-	VulkanRenderer *renderer,
-	VulkanCommandPool *commandPool
+/* Arenas follow the same policy as memory blocks. Their backing buffers
+ * have been idle for many frames, so they are destroyed right away.
+ */
+static void VULKAN_INTERNAL_ReleaseEmptyBufferArenas(
+	VulkanRenderer *renderer
 ) {
-	renderer->vkDestroyCommandPool(
-		renderer->logicalDevice,
-		commandPool->commandPool,
-		NULL
-	);
+	VulkanMemorySubAllocator *bufferArenas = &renderer->memoryAllocator->bufferArenas;
+	VulkanBufferArena *arena;
+	VulkanBufferArena **releasedArenas = NULL;
+	uint32_t releasedArenaCount = 0;
+	int32_t i;
 
-	SDL_free(commandPool->inactiveCommandBuffers);
-	SDL_free(commandPool);
+	SDL_LockMutex(renderer->allocatorLock);
+
+	for (i = bufferArenas->allocationCount - 1; i >= 0; i -= 1)
+	{
+		arena = (VulkanBufferArena*) bufferArenas->allocations[i];
+
+		if (arena->block.usedRegionCount > 0)
+		{
+			continue;
+		}
+
+		arena->block.emptyFrameCount += 1;
+
+		if (	arena->block.emptyFrameCount < EMPTY_ALLOCATION_RELEASE_FRAMES ||
+			bufferArenas->allocationCount == 1	)
+		{
+			continue;
+		}
+
+		VULKAN_INTERNAL_RemoveFreeRegion(bufferArenas, arena->block.firstRegion);
+		VULKAN_INTERNAL_ReleaseMemoryRegion(
+			renderer->memoryAllocator,
+			arena->block.firstRegion
+		);
+
+		bufferArenas->allocations[i] = bufferArenas->allocations[bufferArenas->allocationCount - 1];
+		bufferArenas->allocationCount -= 1;
+
+		releasedArenas = SDL_realloc(
+			releasedArenas,
+			sizeof(VulkanBufferArena*) * (releasedArenaCount + 1)
+		);
+		releasedArenas[releasedArenaCount] = arena;
+		releasedArenaCount += 1;
+	}
+
+	SDL_UnlockMutex(renderer->allocatorLock);
+
+	for (i = 0; i < (int32_t) releasedArenaCount; i += 1)
+	{
+		VULKAN_INTERNAL_DestroyBuffer(renderer, releasedArenas[i]->backing);
+		SDL_free(releasedArenas[i]);
+	}
+
+	SDL_free(releasedArenas);
 }
 
-static void VULKAN_INTERNAL_DestroyGraphicsPipeline(
+static void VULKAN_INTERNAL_DestroyBufferDescriptorSetCache(
 	VulkanRenderer *renderer,
-	VulkanGraphicsPipeline *graphicsPipeline
+	BufferDescriptorSetCache *cache
 ) {
-	VkDescriptorSet descriptorSets[2];
-	descriptorSets[0] = graphicsPipeline->vertexUBODescriptorSet;
-	descriptorSets[1] = graphicsPipeline->fragmentUBODescriptorSet;
+	uint32_t i;
 
-	renderer->vkFreeDescriptorSets(
+	if (cache == NULL)
+	{
+		return;
+	}
+
+	for (i = 0; i < cache->bufferDescriptorPoolCount; i += 1)
+	{
+		renderer->vkDestroyDescriptorPool(
+			renderer->logicalDevice,
+			cache->bufferDescriptorPools[i],
+			NULL
+		);
+	}
+
+	SDL_free(cache->bufferDescriptorPools);
+	SDL_free(cache->inactiveDescriptorSets);
+	SDL_free(cache->elements);
+	SDL_free(cache->index.slots);
+
+	SDL_free(cache);
+}
+
+static void VULKAN_INTERNAL_DestroyImageDescriptorSetCache(
+	VulkanRenderer *renderer,
+	ImageDescriptorSetCache *cache
+) {
+	uint32_t i;
+
+	if (cache == NULL)
+	{
+		return;
+	}
+
+	for (i = 0; i < cache->imageDescriptorPoolCount; i += 1)
+	{
+		renderer->vkDestroyDescriptorPool(
+			renderer->logicalDevice,
+			cache->imageDescriptorPools[i],
+			NULL
+		);
+	}
+
+	SDL_free(cache->imageDescriptorPools);
+	SDL_free(cache->inactiveDescriptorSets);
+	SDL_free(cache->elements);
+	SDL_free(cache->index.slots);
+
+	SDL_free(cache);
+}
+
+static void VULKAN_INTERNAL_DestroyDescriptorSetCacheInfo(
+	VulkanRenderer *renderer,
+	DescriptorSetCacheInfo *info
+) {
+	if (info == NULL)
+	{
+		return;
+	}
+
+	if (info->descriptorUpdateTemplate != VK_NULL_HANDLE)
+	{
+		renderer->vkDestroyDescriptorUpdateTemplateKHR(
+			renderer->logicalDevice,
+			info->descriptorUpdateTemplate,
+			NULL
+		);
+	}
+
+	SDL_free(info);
+}
+
+static void VULKAN_INTERNAL_DestroyCommandPool(
+	VulkanRenderer *renderer,
+	VulkanCommandPool *commandPool
+) {
+	uint32_t i;
+
+	renderer->vkDestroyCommandPool(
 		renderer->logicalDevice,
-		renderer->defaultDescriptorPool,
-		2,
-		descriptorSets
+		commandPool->commandPool,
+		NULL
 	);
 
+	for (i = 0; i < commandPool->imageDescriptorSetCacheCount; i += 1)
+	{
+		VULKAN_INTERNAL_DestroyImageDescriptorSetCache(
+			renderer,
+			commandPool->imageDescriptorSetCaches[i]
+		);
+	}
+
+	for (i = 0; i < commandPool->bufferDescriptorSetCacheCount; i += 1)
+	{
+		VULKAN_INTERNAL_DestroyBufferDescriptorSetCache(
+			renderer,
+			commandPool->bufferDescriptorSetCaches[i]
+		);
+	}
+
+	SDL_free(commandPool->imageDescriptorSetCaches);
+	SDL_free(commandPool->bufferDescriptorSetCaches);
+	SDL_free(commandPool->activeImageDescriptorSetCaches);
+	SDL_free(commandPool->activeBufferDescriptorSetCaches);
+	SDL_free(commandPool->expiredImageViews);
+	SDL_free(commandPool->expiredBuffers);
+	SDL_DestroyMutex(commandPool->expirationLock);
+	SDL_free(commandPool->inactiveCommandBuffers);
+	SDL_free(commandPool);
+}
+
+static void VULKAN_INTERNAL_DestroyGraphicsPipeline(
+	VulkanRenderer *renderer,
+	VulkanGraphicsPipeline *graphicsPipeline
+) {
 	renderer->vkDestroyPipeline(
 		renderer->logicalDevice,
 		graphicsPipeline->pipeline,
@@ -2520,13 +4040,6 @@ static void VULKAN_INTERNAL_DestroyComputePipeline(
 	VulkanRenderer *renderer,
 	VulkanComputePipeline *computePipeline
 ) {
-	renderer->vkFreeDescriptorSets(
-		renderer->logicalDevice,
-		renderer->defaultDescriptorPool,
-		1,
-		&computePipeline->computeUBODescriptorSet
-	);
-
 	renderer->vkDestroyPipeline(
 		renderer->logicalDevice,
 		computePipeline->pipeline,
@@ -2551,6 +4064,23 @@ static void VULKAN_INTERNAL_DestroySampler(
 	VulkanRenderer *renderer,
 	VkSampler sampler
 ) {
+	uint32_t index;
+
+	if (renderer->supportsBindless)
+	{
+		SDL_LockMutex(renderer->bindlessLock);
+		index = VULKAN_INTERNAL_FindBindlessSampler(renderer, sampler);
+		if (index != REFRESH_BINDLESS_INDEX_NONE)
+		{
+			renderer->bindlessSamplers[index] = VK_NULL_HANDLE;
+			VULKAN_INTERNAL_ReleaseBindlessIndex(
+				&renderer->bindlessSamplerIndices,
+				index
+			);
+		}
+		SDL_UnlockMutex(renderer->bindlessLock);
+	}
+
 	renderer->vkDestroySampler(
 		renderer->logicalDevice,
 		sampler,
@@ -2611,238 +4141,249 @@ static void VULKAN_INTERNAL_DestroySwapchain(VulkanRenderer* renderer)
 }
 
 static void VULKAN_INTERNAL_DestroyTextureStagingBuffer(
-	VulkanRenderer* renderer
+	VulkanRenderer* renderer,
+	uint32_t frameIndex
 ) {
 	VULKAN_INTERNAL_DestroyBuffer(
 		renderer,
-		renderer->textureStagingBuffer
+		renderer->textureStagingBuffers[frameIndex]
 	);
 }
 
-static void VULKAN_INTERNAL_DestroyBufferDescriptorSetCache(
-	VulkanRenderer *renderer,
-	BufferDescriptorSetCache *cache
+/* Called once the frame slot's fence has signaled */
+static void VULKAN_INTERNAL_PostWorkCleanup(
+	VulkanRenderer* renderer,
+	uint32_t frameIndex
 ) {
-	uint32_t i;
+	VulkanFrame *frame = &renderer->frames[frameIndex];
+	VulkanBuffer *buffer;
+	uint32_t i, j;
 
-	if (cache == NULL)
+	if (!frame->needsCleanup)
 	{
 		return;
 	}
 
-	for (i = 0; i < cache->bufferDescriptorPoolCount; i += 1)
-	{
-		renderer->vkDestroyDescriptorPool(
-			renderer->logicalDevice,
-			cache->bufferDescriptorPools[i],
-			NULL
-		);
-	}
-
-	SDL_free(cache->bufferDescriptorPools);
-	SDL_free(cache->inactiveDescriptorSets);
-	SDL_free(cache->elements);
-
-	for (i = 0; i < NUM_DESCRIPTOR_SET_HASH_BUCKETS; i += 1)
-	{
-		SDL_free(cache->buckets[i].elements);
-	}
-
-	SDL_free(cache);
-}
-
-static void VULKAN_INTERNAL_DestroyImageDescriptorSetCache(
-	VulkanRenderer *renderer,
-	ImageDescriptorSetCache *cache
-) {
-	uint32_t i;
+	frame->needsCleanup = 0;
 
-	if (cache == NULL)
+	/* Mark sub buffers bound in this frame as unbound */
+	for (i = 0; i < frame->submittedBufferCount; i += 1)
 	{
-		return;
-	}
+		buffer = frame->submittedBuffers[i];
+		buffer->boundSubmitted -= 1;
 
-	for (i = 0; i < cache->imageDescriptorPoolCount; i += 1)
-	{
-		renderer->vkDestroyDescriptorPool(
-			renderer->logicalDevice,
-			cache->imageDescriptorPools[i],
-			NULL
-		);
+		for (j = 0; j < buffer->subBufferCount; j += 1)
+		{
+			if (buffer->subBuffers[j]->bound == (int8_t) frameIndex)
+			{
+				buffer->subBuffers[j]->bound = -1;
+			}
+		}
 	}
+	frame->submittedBufferCount = 0;
 
-	SDL_free(cache->imageDescriptorPools);
-	SDL_free(cache->inactiveDescriptorSets);
-	SDL_free(cache->elements);
-
-	for (i = 0; i < NUM_DESCRIPTOR_SET_HASH_BUCKETS; i += 1)
+	/* Reset the submitted command buffers */
+	for (i = 0; i < frame->submittedCommandBufferCount; i += 1)
 	{
-		SDL_free(cache->buckets[i].elements);
+		if (!frame->submittedCommandBuffers[i]->fixed)
+		{
+			VULKAN_INTERNAL_ResetCommandBuffer(
+				renderer,
+				frame->submittedCommandBuffers[i]
+			);
+		}
 	}
-
-	SDL_free(cache);
-}
-
-static void VULKAN_INTERNAL_PostWorkCleanup(VulkanRenderer* renderer)
-{
-	uint32_t i, j;
+	frame->submittedCommandBufferCount = 0;
 
 	/* Destroy submitted resources */
 
 	SDL_LockMutex(renderer->disposeLock);
 
-	for (i = 0; i < renderer->submittedRenderTargetsToDestroyCount; i += 1)
+	for (i = 0; i < frame->submittedRenderTargetsToDestroyCount; i += 1)
 	{
 		VULKAN_INTERNAL_DestroyRenderTarget(
 			renderer,
-			renderer->submittedRenderTargetsToDestroy[i]
+			frame->submittedRenderTargetsToDestroy[i]
 		);
 	}
-	renderer->submittedRenderTargetsToDestroyCount = 0;
+	frame->submittedRenderTargetsToDestroyCount = 0;
 
-	for (i = 0; i < renderer->submittedTexturesToDestroyCount; i += 1)
+	for (i = 0; i < frame->submittedTexturesToDestroyCount; i += 1)
 	{
 		VULKAN_INTERNAL_DestroyTexture(
 			renderer,
-			renderer->submittedTexturesToDestroy[i]
+			frame->submittedTexturesToDestroy[i]
 		);
 	}
-	renderer->submittedTexturesToDestroyCount = 0;
+	frame->submittedTexturesToDestroyCount = 0;
 
-	for (i = 0; i < renderer->submittedBuffersToDestroyCount; i += 1)
+	for (i = 0; i < frame->submittedBuffersToDestroyCount; i += 1)
 	{
 		VULKAN_INTERNAL_DestroyBuffer(
 			renderer,
-			renderer->submittedBuffersToDestroy[i]
+			frame->submittedBuffersToDestroy[i]
 		);
 	}
-	renderer->submittedBuffersToDestroyCount = 0;
+	frame->submittedBuffersToDestroyCount = 0;
 
-	for (i = 0; i < renderer->submittedGraphicsPipelinesToDestroyCount; i += 1)
+	for (i = 0; i < frame->submittedGraphicsPipelinesToDestroyCount; i += 1)
 	{
 		VULKAN_INTERNAL_DestroyGraphicsPipeline(
 			renderer,
-			renderer->submittedGraphicsPipelinesToDestroy[i]
+			frame->submittedGraphicsPipelinesToDestroy[i]
 		);
 	}
-	renderer->submittedGraphicsPipelinesToDestroyCount = 0;
+	frame->submittedGraphicsPipelinesToDestroyCount = 0;
 
-	for (i = 0; i < renderer->submittedComputePipelinesToDestroyCount; i += 1)
+	for (i = 0; i < frame->submittedComputePipelinesToDestroyCount; i += 1)
 	{
 		VULKAN_INTERNAL_DestroyComputePipeline(
 			renderer,
-			renderer->submittedComputePipelinesToDestroy[i]
+			frame->submittedComputePipelinesToDestroy[i]
 		);
 	}
-	renderer->submittedComputePipelinesToDestroyCount = 0;
+	frame->submittedComputePipelinesToDestroyCount = 0;
 
-	for (i = 0; i < renderer->submittedShaderModulesToDestroyCount; i += 1)
+	for (i = 0; i < frame->submittedShaderModulesToDestroyCount; i += 1)
 	{
 		VULKAN_INTERNAL_DestroyShaderModule(
 			renderer,
-			renderer->submittedShaderModulesToDestroy[i]
+			frame->submittedShaderModulesToDestroy[i]
 		);
 	}
-	renderer->submittedShaderModulesToDestroyCount = 0;
+	frame->submittedShaderModulesToDestroyCount = 0;
 
-	for (i = 0; i < renderer->submittedSamplersToDestroyCount; i += 1)
+	for (i = 0; i < frame->submittedSamplersToDestroyCount; i += 1)
 	{
 		VULKAN_INTERNAL_DestroySampler(
 			renderer,
-			renderer->submittedSamplersToDestroy[i]
+			frame->submittedSamplersToDestroy[i]
 		);
 	}
-	renderer->submittedSamplersToDestroyCount = 0;
+	frame->submittedSamplersToDestroyCount = 0;
 
-	for (i = 0; i < renderer->submittedFramebuffersToDestroyCount; i += 1)
+	for (i = 0; i < frame->submittedFramebuffersToDestroyCount; i += 1)
 	{
 		VULKAN_INTERNAL_DestroyFramebuffer(
 			renderer,
-			renderer->submittedFramebuffersToDestroy[i]
+			frame->submittedFramebuffersToDestroy[i]
 		);
 	}
-	renderer->submittedFramebuffersToDestroyCount = 0;
+	frame->submittedFramebuffersToDestroyCount = 0;
 
-	for (i = 0; i < renderer->submittedRenderPassesToDestroyCount; i += 1)
+	for (i = 0; i < frame->submittedRenderPassesToDestroyCount; i += 1)
 	{
 		VULKAN_INTERNAL_DestroyRenderPass(
 			renderer,
-			renderer->submittedRenderPassesToDestroy[i]
+			frame->submittedRenderPassesToDestroy[i]
 		);
 	}
-	renderer->submittedRenderPassesToDestroyCount = 0;
+	frame->submittedRenderPassesToDestroyCount = 0;
+
+	SDL_UnlockMutex(renderer->disposeLock);
+
+	VULKAN_INTERNAL_ReleaseEmptyAllocations(renderer);
+	VULKAN_INTERNAL_ReleaseEmptyBufferArenas(renderer);
+}
+
+/* Hands everything recorded since the last submission to the frame slot */
+static void VULKAN_INTERNAL_TrackSubmittedWork(
+	VulkanRenderer *renderer,
+	uint32_t frameIndex,
+	uint32_t commandBufferCount,
+	Refresh_CommandBuffer **pCommandBuffers
+) {
+	VulkanFrame *frame = &renderer->frames[frameIndex];
+	uint32_t i;
+
+	EXPAND_ARRAY_IF_NEEDED(
+		frame->submittedCommandBuffers,
+		VulkanCommandBuffer*,
+		commandBufferCount,
+		frame->submittedCommandBufferCapacity,
+		commandBufferCount * 2
+	)
+
+	for (i = 0; i < commandBufferCount; i += 1)
+	{
+		((VulkanCommandBuffer*) pCommandBuffers[i])->submitted = 1;
+		frame->submittedCommandBuffers[i] = (VulkanCommandBuffer*) pCommandBuffers[i];
+	}
+	frame->submittedCommandBufferCount = commandBufferCount;
 
 	/* Re-size submitted destroy lists */
 
+	SDL_LockMutex(renderer->disposeLock);
+
 	EXPAND_ARRAY_IF_NEEDED(
-		renderer->submittedRenderTargetsToDestroy,
+		frame->submittedRenderTargetsToDestroy,
 		VulkanRenderTarget*,
 		renderer->renderTargetsToDestroyCount,
-		renderer->submittedRenderTargetsToDestroyCapacity,
+		frame->submittedRenderTargetsToDestroyCapacity,
 		renderer->renderTargetsToDestroyCount
 	)
 
 	EXPAND_ARRAY_IF_NEEDED(
-		renderer->submittedTexturesToDestroy,
+		frame->submittedTexturesToDestroy,
 		VulkanTexture*,
 		renderer->texturesToDestroyCount,
-		renderer->submittedTexturesToDestroyCapacity,
+		frame->submittedTexturesToDestroyCapacity,
 		renderer->texturesToDestroyCount
 	)
 
 	EXPAND_ARRAY_IF_NEEDED(
-		renderer->submittedBuffersToDestroy,
+		frame->submittedBuffersToDestroy,
 		VulkanBuffer*,
 		renderer->buffersToDestroyCount,
-		renderer->submittedBuffersToDestroyCapacity,
+		frame->submittedBuffersToDestroyCapacity,
 		renderer->buffersToDestroyCount
 	)
 
 	EXPAND_ARRAY_IF_NEEDED(
-		renderer->submittedGraphicsPipelinesToDestroy,
+		frame->submittedGraphicsPipelinesToDestroy,
 		VulkanGraphicsPipeline*,
 		renderer->graphicsPipelinesToDestroyCount,
-		renderer->submittedGraphicsPipelinesToDestroyCapacity,
+		frame->submittedGraphicsPipelinesToDestroyCapacity,
 		renderer->graphicsPipelinesToDestroyCount
 	)
 
 	EXPAND_ARRAY_IF_NEEDED(
-		renderer->submittedComputePipelinesToDestroy,
+		frame->submittedComputePipelinesToDestroy,
 		VulkanComputePipeline*,
 		renderer->computePipelinesToDestroyCount,
-		renderer->submittedComputePipelinesToDestroyCapacity,
+		frame->submittedComputePipelinesToDestroyCapacity,
 		renderer->computePipelinesToDestroyCount
 	)
 
 	EXPAND_ARRAY_IF_NEEDED(
-		renderer->submittedShaderModulesToDestroy,
+		frame->submittedShaderModulesToDestroy,
 		VkShaderModule,
 		renderer->shaderModulesToDestroyCount,
-		renderer->submittedShaderModulesToDestroyCapacity,
+		frame->submittedShaderModulesToDestroyCapacity,
 		renderer->shaderModulesToDestroyCount
 	)
 
 	EXPAND_ARRAY_IF_NEEDED(
-		renderer->submittedSamplersToDestroy,
+		frame->submittedSamplersToDestroy,
 		VkSampler,
 		renderer->samplersToDestroyCount,
-		renderer->submittedSamplersToDestroyCapacity,
+		frame->submittedSamplersToDestroyCapacity,
 		renderer->samplersToDestroyCount
 	)
 
 	EXPAND_ARRAY_IF_NEEDED(
-		renderer->submittedFramebuffersToDestroy,
+		frame->submittedFramebuffersToDestroy,
 		VulkanFramebuffer*,
 		renderer->framebuffersToDestroyCount,
-		renderer->submittedFramebuffersToDestroyCapacity,
+		frame->submittedFramebuffersToDestroyCapacity,
 		renderer->framebuffersToDestroyCount
 	)
 
 	EXPAND_ARRAY_IF_NEEDED(
-		renderer->submittedRenderPassesToDestroy,
+		frame->submittedRenderPassesToDestroy,
 		VkRenderPass,
 		renderer->renderPassesToDestroyCount,
-		renderer->submittedRenderPassesToDestroyCapacity,
+		frame->submittedRenderPassesToDestroyCapacity,
 		renderer->renderPassesToDestroyCount
 	)
 
@@ -2850,128 +4391,122 @@ static void VULKAN_INTERNAL_PostWorkCleanup(VulkanRenderer* renderer)
 
 	MOVE_ARRAY_CONTENTS_AND_RESET(
 		i,
-		renderer->submittedRenderTargetsToDestroy,
-		renderer->submittedRenderTargetsToDestroyCount,
+		frame->submittedRenderTargetsToDestroy,
+		frame->submittedRenderTargetsToDestroyCount,
 		renderer->renderTargetsToDestroy,
 		renderer->renderTargetsToDestroyCount
 	)
 
 	MOVE_ARRAY_CONTENTS_AND_RESET(
 		i,
-		renderer->submittedTexturesToDestroy,
-		renderer->submittedTexturesToDestroyCount,
+		frame->submittedTexturesToDestroy,
+		frame->submittedTexturesToDestroyCount,
 		renderer->texturesToDestroy,
 		renderer->texturesToDestroyCount
 	)
 
 	MOVE_ARRAY_CONTENTS_AND_RESET(
 		i,
-		renderer->submittedBuffersToDestroy,
-		renderer->submittedBuffersToDestroyCount,
+		frame->submittedBuffersToDestroy,
+		frame->submittedBuffersToDestroyCount,
 		renderer->buffersToDestroy,
 		renderer->buffersToDestroyCount
 	)
 
 	MOVE_ARRAY_CONTENTS_AND_RESET(
 		i,
-		renderer->submittedGraphicsPipelinesToDestroy,
-		renderer->submittedGraphicsPipelinesToDestroyCount,
+		frame->submittedGraphicsPipelinesToDestroy,
+		frame->submittedGraphicsPipelinesToDestroyCount,
 		renderer->graphicsPipelinesToDestroy,
 		renderer->graphicsPipelinesToDestroyCount
 	)
 
 	MOVE_ARRAY_CONTENTS_AND_RESET(
 		i,
-		renderer->submittedComputePipelinesToDestroy,
-		renderer->submittedComputePipelinesToDestroyCount,
+		frame->submittedComputePipelinesToDestroy,
+		frame->submittedComputePipelinesToDestroyCount,
 		renderer->computePipelinesToDestroy,
 		renderer->computePipelinesToDestroyCount
 	)
 
 	MOVE_ARRAY_CONTENTS_AND_RESET(
 		i,
-		renderer->submittedShaderModulesToDestroy,
-		renderer->submittedShaderModulesToDestroyCount,
+		frame->submittedShaderModulesToDestroy,
+		frame->submittedShaderModulesToDestroyCount,
 		renderer->shaderModulesToDestroy,
 		renderer->shaderModulesToDestroyCount
 	)
 
 	MOVE_ARRAY_CONTENTS_AND_RESET(
 		i,
-		renderer->submittedSamplersToDestroy,
-		renderer->submittedSamplersToDestroyCount,
+		frame->submittedSamplersToDestroy,
+		frame->submittedSamplersToDestroyCount,
 		renderer->samplersToDestroy,
 		renderer->samplersToDestroyCount
 	)
 
 	MOVE_ARRAY_CONTENTS_AND_RESET(
 		i,
-		renderer->submittedFramebuffersToDestroy,
-		renderer->submittedFramebuffersToDestroyCount,
+		frame->submittedFramebuffersToDestroy,
+		frame->submittedFramebuffersToDestroyCount,
 		renderer->framebuffersToDestroy,
 		renderer->framebuffersToDestroyCount
 	)
 
 	MOVE_ARRAY_CONTENTS_AND_RESET(
 		i,
-		renderer->submittedRenderPassesToDestroy,
-		renderer->submittedRenderPassesToDestroyCount,
+		frame->submittedRenderPassesToDestroy,
+		frame->submittedRenderPassesToDestroyCount,
 		renderer->renderPassesToDestroy,
 		renderer->renderPassesToDestroyCount
 	)
 
 	SDL_UnlockMutex(renderer->disposeLock);
 
-	/* Increment the frame index */
-	/* FIXME: need a better name, and to get rid of the magic value % 2 */
-	renderer->frameIndex = (renderer->frameIndex + 1) % 2;
+	/* Mark currently bound buffers as submitted buffers */
 
-	/* Mark sub buffers of previously submitted buffers as unbound */
-	for (i = 0; i < renderer->submittedBufferCount; i += 1)
-	{
-		if (renderer->submittedBuffers[i] != NULL)
-		{
-			renderer->submittedBuffers[i]->boundSubmitted = 0;
+	EXPAND_ARRAY_IF_NEEDED(
+		frame->submittedBuffers,
+		VulkanBuffer*,
+		renderer->buffersInUseCount,
+		frame->submittedBufferCapacity,
+		renderer->buffersInUseCount
+	)
 
-			for (j = 0; j < renderer->submittedBuffers[i]->subBufferCount; j += 1)
-			{
-				if (renderer->submittedBuffers[i]->subBuffers[j]->bound == renderer->frameIndex)
-				{
-					renderer->submittedBuffers[i]->subBuffers[j]->bound = -1;
-				}
-			}
+	for (i = 0; i < renderer->buffersInUseCount; i += 1)
+	{
+		renderer->buffersInUse[i]->bound = 0;
+		renderer->buffersInUse[i]->boundSubmitted += 1;
 
-			renderer->submittedBuffers[i] = NULL;
-		}
+		frame->submittedBuffers[i] = renderer->buffersInUse[i];
+		renderer->buffersInUse[i] = NULL;
 	}
 
-	renderer->submittedBufferCount = 0;
+	frame->submittedBufferCount = renderer->buffersInUseCount;
+	renderer->buffersInUseCount = 0;
 
-	/* Mark currently bound buffers as submitted buffers */
-	if (renderer->buffersInUseCount > renderer->submittedBufferCapacity)
-	{
-		renderer->submittedBuffers = SDL_realloc(
-			renderer->submittedBuffers,
-			sizeof(VulkanBuffer*) * renderer->buffersInUseCount
-		);
+	frame->needsCleanup = 1;
+}
 
-		renderer->submittedBufferCapacity = renderer->buffersInUseCount;
-	}
+/* Releases the work of every frame whose fence has already signaled,
+ * without blocking on the ones still executing.
+ */
+static void VULKAN_INTERNAL_CleanupFinishedFrames(
+	VulkanRenderer *renderer
+) {
+	uint32_t i;
 
-	for (i = 0; i < renderer->buffersInUseCount; i += 1)
+	for (i = 0; i < renderer->framesInFlight; i += 1)
 	{
-		if (renderer->buffersInUse[i] != NULL)
+		if (	renderer->frames[i].needsCleanup &&
+			renderer->vkGetFenceStatus(
+				renderer->logicalDevice,
+				renderer->inFlightFences[i]
+			) == VK_SUCCESS	)
 		{
-			renderer->buffersInUse[i]->bound = 0;
-			renderer->buffersInUse[i]->boundSubmitted = 1;
-
-			renderer->submittedBuffers[i] = renderer->buffersInUse[i];
-			renderer->buffersInUse[i] = NULL;
+			VULKAN_INTERNAL_PostWorkCleanup(renderer, i);
 		}
 	}
-
-	renderer->submittedBufferCount = renderer->buffersInUseCount;
-	renderer->buffersInUseCount = 0;
 }
 
 /* Swapchain */
@@ -3428,31 +4963,98 @@ static void VULKAN_INTERNAL_RecreateSwapchain(VulkanRenderer* renderer)
 
 /* Data Buffer */
 
-/* buffer should be an alloc'd but uninitialized VulkanBuffer */
-static uint8_t VULKAN_INTERNAL_CreateBuffer(
+/* Widens a sub-buffer range to whole non-coherent atoms */
+static void VULKAN_INTERNAL_GetMappedMemoryRange(
 	VulkanRenderer *renderer,
+	VulkanSubBuffer *subBuffer,
+	VkDeviceSize offset,
 	VkDeviceSize size,
-	VulkanResourceAccessType resourceAccessType,
-	VkBufferUsageFlags usage,
-	uint32_t subBufferCount,
-	VulkanBuffer *buffer
+	VkMappedMemoryRange *range
 ) {
-	VkResult vulkanResult;
-	VkBufferCreateInfo bufferCreateInfo;
-	uint8_t findMemoryResult;
-	uint32_t i;
+	VkDeviceSize atomSize = renderer->physicalDeviceProperties.properties.limits.nonCoherentAtomSize;
+	VkDeviceSize start = subBuffer->offset + offset;
+	VkDeviceSize end = VULKAN_INTERNAL_NextHighestAlignment(start + size, atomSize);
 
-	buffer->size = size;
-	buffer->currentSubBufferIndex = 0;
-	buffer->bound = 0;
-	buffer->boundSubmitted = 0;
-	buffer->resourceAccessType = resourceAccessType;
-	buffer->usage = usage;
-	buffer->subBufferCount = subBufferCount;
-	buffer->subBuffers = SDL_malloc(
-		sizeof(VulkanSubBuffer*) * buffer->subBufferCount
+	start -= start % atomSize;
+
+	range->sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+	range->pNext = NULL;
+	range->memory = subBuffer->allocation->memory;
+	range->offset = start;
+	range->size = SDL_min(end, subBuffer->allocation->size) - start;
+}
+
+/* Makes host writes to a sub-buffer visible to the device */
+static void VULKAN_INTERNAL_FlushSubBuffer(
+	VulkanRenderer *renderer,
+	VulkanSubBuffer *subBuffer,
+	VkDeviceSize offset,
+	VkDeviceSize size
+) {
+	VkMappedMemoryRange range;
+	VkResult vulkanResult;
+
+	if (!subBuffer->allocation->nonCoherent)
+	{
+		return;
+	}
+
+	VULKAN_INTERNAL_GetMappedMemoryRange(renderer, subBuffer, offset, size, &range);
+
+	vulkanResult = renderer->vkFlushMappedMemoryRanges(
+		renderer->logicalDevice,
+		1,
+		&range
+	);
+
+	if (vulkanResult != VK_SUCCESS)
+	{
+		LogVulkanResultAsError("vkFlushMappedMemoryRanges", vulkanResult);
+	}
+}
+
+/* Makes device writes to a sub-buffer visible to the host */
+static void VULKAN_INTERNAL_InvalidateSubBuffer(
+	VulkanRenderer *renderer,
+	VulkanSubBuffer *subBuffer,
+	VkDeviceSize offset,
+	VkDeviceSize size
+) {
+	VkMappedMemoryRange range;
+	VkResult vulkanResult;
+
+	if (!subBuffer->allocation->nonCoherent)
+	{
+		return;
+	}
+
+	VULKAN_INTERNAL_GetMappedMemoryRange(renderer, subBuffer, offset, size, &range);
+
+	vulkanResult = renderer->vkInvalidateMappedMemoryRanges(
+		renderer->logicalDevice,
+		1,
+		&range
 	);
 
+	if (vulkanResult != VK_SUCCESS)
+	{
+		LogVulkanResultAsError("vkInvalidateMappedMemoryRanges", vulkanResult);
+	}
+}
+
+/* subBuffer should be an alloc'd but uninitialized VulkanSubBuffer */
+static uint8_t VULKAN_INTERNAL_CreateSubBuffer(
+	VulkanRenderer *renderer,
+	VkDeviceSize size,
+	VulkanResourceAccessType resourceAccessType,
+	VkBufferUsageFlags usage,
+	VulkanBufferMemoryUsage memoryUsage,
+	VulkanSubBuffer *subBuffer
+) {
+	VkResult vulkanResult;
+	VkBufferCreateInfo bufferCreateInfo;
+	uint8_t findMemoryResult;
+
 	bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
 	bufferCreateInfo.pNext = NULL;
 	bufferCreateInfo.flags = 0;
@@ -3462,68 +5064,364 @@ static uint8_t VULKAN_INTERNAL_CreateBuffer(
 	bufferCreateInfo.queueFamilyIndexCount = 1;
 	bufferCreateInfo.pQueueFamilyIndices = &renderer->queueFamilyIndices.graphicsFamily;
 
-	for (i = 0; i < subBufferCount; i += 1)
+	vulkanResult = renderer->vkCreateBuffer(
+		renderer->logicalDevice,
+		&bufferCreateInfo,
+		NULL,
+		&subBuffer->buffer
+	);
+
+	if (vulkanResult != VK_SUCCESS)
 	{
-		buffer->subBuffers[i] = SDL_malloc(sizeof(VulkanSubBuffer));
+		LogVulkanResultAsError("vkCreateBuffer", vulkanResult);
+		Refresh_LogError("Failed to create VkBuffer");
+		return 0;
+	}
 
-		vulkanResult = renderer->vkCreateBuffer(
-			renderer->logicalDevice,
-			&bufferCreateInfo,
-			NULL,
-			&buffer->subBuffers[i]->buffer
-		);
+	findMemoryResult = VULKAN_INTERNAL_FindAvailableBufferMemory(
+		renderer,
+		subBuffer->buffer,
+		memoryUsage,
+		&subBuffer->allocation,
+		&subBuffer->usedRegion,
+		&subBuffer->offset,
+		&subBuffer->size
+	);
 
-		if (vulkanResult != VK_SUCCESS)
-		{
-			LogVulkanResultAsError("vkCreateBuffer", vulkanResult);
-			Refresh_LogError("Failed to create VkBuffer");
-			return 0;
-		}
+	/* Static buffers are only written by transfers, host memory works too */
+	if (findMemoryResult == 2 && memoryUsage == VULKAN_BUFFER_MEMORY_DEVICE)
+	{
+		Refresh_LogWarn("Out of device local memory, falling back to host memory");
 
 		findMemoryResult = VULKAN_INTERNAL_FindAvailableBufferMemory(
 			renderer,
-			buffer->subBuffers[i]->buffer,
-			&buffer->subBuffers[i]->allocation,
-			&buffer->subBuffers[i]->offset,
-			&buffer->subBuffers[i]->size
+			subBuffer->buffer,
+			VULKAN_BUFFER_MEMORY_HOST,
+			&subBuffer->allocation,
+			&subBuffer->usedRegion,
+			&subBuffer->offset,
+			&subBuffer->size
+		);
+	}
+
+	/* We're out of available memory */
+	if (findMemoryResult == 2)
+	{
+		Refresh_LogWarn("Out of buffer memory!");
+		return 2;
+	}
+	else if (findMemoryResult == 0)
+	{
+		Refresh_LogError("Failed to find buffer memory!");
+		return 0;
+	}
+
+	SDL_LockMutex(subBuffer->allocation->memoryLock);
+
+	vulkanResult = renderer->vkBindBufferMemory(
+		renderer->logicalDevice,
+		subBuffer->buffer,
+		subBuffer->allocation->memory,
+		subBuffer->offset
+	);
+
+	SDL_UnlockMutex(subBuffer->allocation->memoryLock);
+
+	if (vulkanResult != VK_SUCCESS)
+	{
+		Refresh_LogError("Failed to bind buffer memory!");
+		return 0;
+	}
+
+	subBuffer->bufferOffset = 0;
+	subBuffer->resourceAccessType = resourceAccessType;
+	subBuffer->bound = -1;
+
+	return 1;
+}
+
+/* buffer should be an alloc'd but uninitialized VulkanBuffer */
+static uint8_t VULKAN_INTERNAL_CreateBuffer(
+	VulkanRenderer *renderer,
+	VkDeviceSize size,
+	VulkanResourceAccessType resourceAccessType,
+	VkBufferUsageFlags usage,
+	uint32_t subBufferCount,
+	VulkanBufferMemoryUsage memoryUsage,
+	VulkanBuffer *buffer
+) {
+	uint8_t result;
+	uint32_t i;
+
+	buffer->size = size;
+	buffer->memoryUsage = memoryUsage;
+	buffer->mapped = 0;
+	buffer->currentSubBufferIndex = 0;
+	buffer->bound = 0;
+	buffer->boundSubmitted = 0;
+	buffer->resourceAccessType = resourceAccessType;
+	buffer->usage = usage;
+	buffer->subBufferCount = subBufferCount;
+	buffer->subBuffers = SDL_malloc(
+		sizeof(VulkanSubBuffer*) * buffer->subBufferCount
+	);
+
+	for (i = 0; i < subBufferCount; i += 1)
+	{
+		buffer->subBuffers[i] = SDL_malloc(sizeof(VulkanSubBuffer));
+
+		result = VULKAN_INTERNAL_CreateSubBuffer(
+			renderer,
+			size,
+			resourceAccessType,
+			usage,
+			memoryUsage,
+			buffer->subBuffers[i]
 		);
 
-		/* We're out of available memory */
-		if (findMemoryResult == 2)
+		if (result != 1)
 		{
-			Refresh_LogWarn("Out of buffer memory!");
-			return 2;
+			return result;
 		}
-		else if (findMemoryResult == 0)
+	}
+
+	return 1;
+}
+
+static VulkanBufferArena* VULKAN_INTERNAL_CreateBufferArena(
+	VulkanRenderer *renderer
+) {
+	VulkanMemorySubAllocator *bufferArenas = &renderer->memoryAllocator->bufferArenas;
+	VulkanBufferArena *arena = SDL_malloc(sizeof(VulkanBufferArena));
+	VulkanSubBuffer *backingSubBuffer;
+	VulkanMemoryRegion *region;
+
+	arena->backing = (VulkanBuffer*) SDL_malloc(sizeof(VulkanBuffer));
+
+	if (VULKAN_INTERNAL_CreateBuffer(
+		renderer,
+		BUFFER_ARENA_SIZE,
+		RESOURCE_ACCESS_VERTEX_BUFFER,
+		BUFFER_ARENA_USAGE,
+		1,
+		VULKAN_BUFFER_MEMORY_HOST,
+		arena->backing
+	) != 1) {
+		SDL_free(arena->backing);
+		SDL_free(arena);
+		return NULL;
+	}
+
+	backingSubBuffer = arena->backing->subBuffers[0];
+
+	arena->block.allocator = bufferArenas;
+	arena->block.memory = backingSubBuffer->allocation->memory;
+	arena->block.size = BUFFER_ARENA_SIZE;
+	arena->block.dedicated = 0;
+	arena->block.mapPointer = backingSubBuffer->allocation->mapPointer + backingSubBuffer->offset;
+	arena->block.nonCoherent = 0;
+	arena->block.memoryLock = NULL;
+	arena->block.firstRegion = NULL;
+	arena->block.usedBytes = 0;
+	arena->block.usedRegionCount = 0;
+	arena->block.emptyFrameCount = 0;
+
+	SDL_LockMutex(renderer->allocatorLock);
+
+	bufferArenas->allocationCount += 1;
+	bufferArenas->allocations = SDL_realloc(
+		bufferArenas->allocations,
+		sizeof(VulkanMemoryAllocation*) * bufferArenas->allocationCount
+	);
+	bufferArenas->allocations[bufferArenas->allocationCount - 1] = &arena->block;
+
+	region = VULKAN_INTERNAL_NewMemoryRegion(
+		renderer->memoryAllocator,
+		&arena->block,
+		0,
+		BUFFER_ARENA_SIZE,
+		NULL,
+		NULL
+	);
+	VULKAN_INTERNAL_InsertFreeRegion(bufferArenas, region);
+
+	SDL_UnlockMutex(renderer->allocatorLock);
+
+	return arena;
+}
+
+/* Like CreateSubBuffer, but the sub-buffer is a range of a shared arena */
+static uint8_t VULKAN_INTERNAL_CreateArenaSubBuffer(
+	VulkanRenderer *renderer,
+	VkDeviceSize size,
+	VulkanResourceAccessType resourceAccessType,
+	VulkanSubBuffer *subBuffer
+) {
+	VulkanMemorySubAllocator *bufferArenas = &renderer->memoryAllocator->bufferArenas;
+	VulkanMemoryRegion *region;
+	VkDeviceSize alignedOffset;
+	VkDeviceSize alignment = SDL_max(
+		renderer->physicalDeviceProperties.properties.limits.minStorageBufferOffsetAlignment,
+		16
+	);
+
+	SDL_LockMutex(renderer->allocatorLock);
+
+	region = VULKAN_INTERNAL_SearchBestFitRegion(
+		bufferArenas,
+		size,
+		alignment,
+		&alignedOffset
+	);
+
+	/* Arena creation takes the allocator lock itself, so another thread
+	 * may claim the new arena's space before we search again.
+	 */
+	while (region == NULL)
+	{
+		SDL_UnlockMutex(renderer->allocatorLock);
+
+		if (VULKAN_INTERNAL_CreateBufferArena(renderer) == NULL)
 		{
-			Refresh_LogError("Failed to find buffer memory!");
+			Refresh_LogError("Failed to create buffer arena!");
 			return 0;
 		}
 
-		SDL_LockMutex(buffer->subBuffers[i]->allocation->memoryLock);
+		SDL_LockMutex(renderer->allocatorLock);
 
-		vulkanResult = renderer->vkBindBufferMemory(
-			renderer->logicalDevice,
-			buffer->subBuffers[i]->buffer,
-			buffer->subBuffers[i]->allocation->memory,
-			buffer->subBuffers[i]->offset
+		region = VULKAN_INTERNAL_SearchBestFitRegion(
+			bufferArenas,
+			size,
+			alignment,
+			&alignedOffset
 		);
+	}
 
-		SDL_UnlockMutex(buffer->subBuffers[i]->allocation->memoryLock);
+	region = VULKAN_INTERNAL_SplitFreeRegion(
+		renderer->memoryAllocator,
+		region,
+		alignedOffset,
+		size
+	);
 
-		if (vulkanResult != VK_SUCCESS)
-		{
-			Refresh_LogError("Failed to bind buffer memory!");
+	VULKAN_INTERNAL_TrackResourceMemory(bufferArenas, 1, size);
+
+	SDL_UnlockMutex(renderer->allocatorLock);
+
+	subBuffer->allocation = region->allocation;
+	subBuffer->usedRegion = region;
+	subBuffer->buffer = ((VulkanBufferArena*) region->allocation)->backing->subBuffers[0]->buffer;
+	subBuffer->offset = region->offset;
+	subBuffer->size = size;
+	subBuffer->bufferOffset = region->offset;
+	subBuffer->resourceAccessType = resourceAccessType;
+	subBuffer->bound = -1;
+
+	return 1;
+}
+
+/* Like CreateBuffer, but each sub-buffer is a range of a shared arena.
+ * usage only drives barriers, arena VkBuffers support all of BUFFER_ARENA_USAGE.
+ */
+static uint8_t VULKAN_INTERNAL_CreateArenaBuffer(
+	VulkanRenderer *renderer,
+	VkDeviceSize size,
+	VulkanResourceAccessType resourceAccessType,
+	VkBufferUsageFlags usage,
+	uint32_t subBufferCount,
+	VulkanBuffer *buffer
+) {
+	uint32_t i;
+
+	buffer->size = size;
+	buffer->memoryUsage = VULKAN_BUFFER_MEMORY_HOST;
+	buffer->mapped = 0;
+	buffer->currentSubBufferIndex = 0;
+	buffer->bound = 0;
+	buffer->boundSubmitted = 0;
+	buffer->resourceAccessType = resourceAccessType;
+	buffer->usage = usage;
+	buffer->subBufferCount = subBufferCount;
+	buffer->subBuffers = SDL_malloc(
+		sizeof(VulkanSubBuffer*) * buffer->subBufferCount
+	);
+
+	for (i = 0; i < subBufferCount; i += 1)
+	{
+		buffer->subBuffers[i] = SDL_malloc(sizeof(VulkanSubBuffer));
+
+		if (!VULKAN_INTERNAL_CreateArenaSubBuffer(
+			renderer,
+			size,
+			resourceAccessType,
+			buffer->subBuffers[i]
+		)) {
 			return 0;
 		}
-
-		buffer->subBuffers[i]->resourceAccessType = resourceAccessType;
-		buffer->subBuffers[i]->bound = -1;
 	}
 
 	return 1;
 }
 
+/* Grows the sub-buffer pool of a buffer by one, returns the new index */
+static int32_t VULKAN_INTERNAL_AddSubBuffer(
+	VulkanRenderer *renderer,
+	VulkanBuffer *buffer
+) {
+	VulkanSubBuffer *subBuffer = SDL_malloc(sizeof(VulkanSubBuffer));
+	uint8_t isArena = VULKAN_INTERNAL_IsArenaSubBuffer(renderer, buffer->subBuffers[0]);
+	uint8_t result;
+	int32_t index;
+
+	if (isArena)
+	{
+		result = VULKAN_INTERNAL_CreateArenaSubBuffer(
+			renderer,
+			buffer->size,
+			buffer->resourceAccessType,
+			subBuffer
+		);
+	}
+	else
+	{
+		result = VULKAN_INTERNAL_CreateSubBuffer(
+			renderer,
+			buffer->size,
+			buffer->resourceAccessType,
+			buffer->usage,
+			buffer->memoryUsage,
+			subBuffer
+		);
+	}
+
+	if (result != 1)
+	{
+		SDL_free(subBuffer);
+		return -1;
+	}
+
+	/* The defragmenter walks sub-buffers under the allocator lock */
+	SDL_LockMutex(renderer->allocatorLock);
+
+	buffer->subBuffers = SDL_realloc(
+		buffer->subBuffers,
+		sizeof(VulkanSubBuffer*) * (buffer->subBufferCount + 1)
+	);
+	index = buffer->subBufferCount;
+	buffer->subBuffers[index] = subBuffer;
+	buffer->subBufferCount += 1;
+
+	if (!isArena && subBuffer->usedRegion != NULL)
+	{
+		subBuffer->usedRegion->buffer = buffer;
+		subBuffer->usedRegion->subBufferIndex = index;
+	}
+
+	SDL_UnlockMutex(renderer->allocatorLock);
+
+	return index;
+}
+
 /* Command Buffers */
 
 static void VULKAN_INTERNAL_BeginCommandBuffer(
@@ -3542,6 +5440,11 @@ static void VULKAN_INTERNAL_BeginCommandBuffer(
 	{
 		beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
 	}
+	else
+	{
+		/* May still be pending in an earlier frame when resubmitted */
+		beginInfo.flags = VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
+	}
 
 	result = renderer->vkBeginCommandBuffer(
 		commandBuffer->commandBuffer,
@@ -3584,7 +5487,8 @@ static void VULKAN_DestroyDevice(
 	GraphicsPipelineLayoutHashArray graphicsPipelineLayoutHashArray;
 	ComputePipelineLayoutHashArray computePipelineLayoutHashArray;
 	VulkanMemorySubAllocator *allocator;
-	uint32_t i, j, k;
+	VulkanBufferArena *arena;
+	uint32_t i, j;
 
 	waitResult = renderer->vkDeviceWaitIdle(renderer->logicalDevice);
 
@@ -3596,39 +5500,60 @@ static void VULKAN_DestroyDevice(
 	VULKAN_INTERNAL_DestroyBuffer(renderer, renderer->dummyVertexUniformBuffer);
 	VULKAN_INTERNAL_DestroyBuffer(renderer, renderer->dummyFragmentUniformBuffer);
 	VULKAN_INTERNAL_DestroyBuffer(renderer, renderer->dummyComputeUniformBuffer);
-	VULKAN_INTERNAL_DestroyBuffer(renderer, renderer->vertexUBO);
-	VULKAN_INTERNAL_DestroyBuffer(renderer, renderer->fragmentUBO);
-	VULKAN_INTERNAL_DestroyBuffer(renderer, renderer->computeUBO);
+	VULKAN_INTERNAL_DestroyUniformBufferPool(renderer, renderer->vertexUniformBufferPool);
+	VULKAN_INTERNAL_DestroyUniformBufferPool(renderer, renderer->fragmentUniformBufferPool);
+	VULKAN_INTERNAL_DestroyUniformBufferPool(renderer, renderer->computeUniformBufferPool);
 
-	/* We have to do this twice so the rotation happens correctly */
-	VULKAN_INTERNAL_PostWorkCleanup(renderer);
-	VULKAN_INTERNAL_PostWorkCleanup(renderer);
+	/* Hand pending work to the current frame so every frame can be drained */
+	VULKAN_INTERNAL_TrackSubmittedWork(renderer, renderer->frameIndex, 0, NULL);
 
-	VULKAN_INTERNAL_DestroyTextureStagingBuffer(renderer);
+	for (i = 0; i < renderer->framesInFlight; i += 1)
+	{
+		VULKAN_INTERNAL_PostWorkCleanup(renderer, i);
+		VULKAN_INTERNAL_DestroyTextureStagingBuffer(renderer, i);
+	}
 
-	renderer->vkDestroySemaphore(
-		renderer->logicalDevice,
-		renderer->transferFinishedSemaphore,
-		NULL
-	);
+	for (i = 0; i < renderer->readbackCount; i += 1)
+	{
+		VULKAN_INTERNAL_DestroyBuffer(renderer, renderer->readbacks[i]->buffer);
+		SDL_free(renderer->readbacks[i]);
+	}
+	SDL_free(renderer->readbacks);
 
-	renderer->vkDestroySemaphore(
-		renderer->logicalDevice,
-		renderer->imageAvailableSemaphore,
-		NULL
-	);
+	for (i = 0; i < renderer->memoryAllocator->bufferArenas.allocationCount; i += 1)
+	{
+		arena = (VulkanBufferArena*) renderer->memoryAllocator->bufferArenas.allocations[i];
+		VULKAN_INTERNAL_DestroyBuffer(renderer, arena->backing);
+		SDL_free(arena);
+	}
+	SDL_free(renderer->memoryAllocator->bufferArenas.allocations);
 
-	renderer->vkDestroySemaphore(
-		renderer->logicalDevice,
-		renderer->renderFinishedSemaphore,
-		NULL
-	);
+	for (i = 0; i < renderer->framesInFlight; i += 1)
+	{
+		renderer->vkDestroySemaphore(
+			renderer->logicalDevice,
+			renderer->transferFinishedSemaphores[i],
+			NULL
+		);
 
-	renderer->vkDestroyFence(
-		renderer->logicalDevice,
-		renderer->inFlightFence,
-		NULL
-	);
+		renderer->vkDestroySemaphore(
+			renderer->logicalDevice,
+			renderer->imageAvailableSemaphores[i],
+			NULL
+		);
+
+		renderer->vkDestroySemaphore(
+			renderer->logicalDevice,
+			renderer->renderFinishedSemaphores[i],
+			NULL
+		);
+
+		renderer->vkDestroyFence(
+			renderer->logicalDevice,
+			renderer->inFlightFences[i],
+			NULL
+		);
+	}
 
 	for (i = 0; i < NUM_COMMAND_POOL_BUCKETS; i += 1)
 	{
@@ -3658,14 +5583,14 @@ static void VULKAN_DestroyDevice(
 		graphicsPipelineLayoutHashArray = renderer->graphicsPipelineLayoutHashTable.buckets[i];
 		for (j = 0; j < graphicsPipelineLayoutHashArray.count; j += 1)
 		{
-			VULKAN_INTERNAL_DestroyImageDescriptorSetCache(
+			VULKAN_INTERNAL_DestroyDescriptorSetCacheInfo(
 				renderer,
-				graphicsPipelineLayoutHashArray.elements[j].value->vertexSamplerDescriptorSetCache
+				graphicsPipelineLayoutHashArray.elements[j].value->vertexSamplerDescriptorSetCacheInfo
 			);
 
-			VULKAN_INTERNAL_DestroyImageDescriptorSetCache(
+			VULKAN_INTERNAL_DestroyDescriptorSetCacheInfo(
 				renderer,
-				graphicsPipelineLayoutHashArray.elements[j].value->fragmentSamplerDescriptorSetCache
+				graphicsPipelineLayoutHashArray.elements[j].value->fragmentSamplerDescriptorSetCacheInfo
 			);
 
 			renderer->vkDestroyPipelineLayout(
@@ -3683,14 +5608,14 @@ static void VULKAN_DestroyDevice(
 		computePipelineLayoutHashArray = renderer->computePipelineLayoutHashTable.buckets[i];
 		for (j = 0; j < computePipelineLayoutHashArray.count; j += 1)
 		{
-			VULKAN_INTERNAL_DestroyBufferDescriptorSetCache(
+			VULKAN_INTERNAL_DestroyDescriptorSetCacheInfo(
 				renderer,
-				computePipelineLayoutHashArray.elements[j].value->bufferDescriptorSetCache
+				computePipelineLayoutHashArray.elements[j].value->bufferDescriptorSetCacheInfo
 			);
 
-			VULKAN_INTERNAL_DestroyImageDescriptorSetCache(
+			VULKAN_INTERNAL_DestroyDescriptorSetCacheInfo(
 				renderer,
-				computePipelineLayoutHashArray.elements[j].value->imageDescriptorSetCache
+				computePipelineLayoutHashArray.elements[j].value->imageDescriptorSetCacheInfo
 			);
 
 			renderer->vkDestroyPipelineLayout(
@@ -3768,6 +5693,26 @@ static void VULKAN_DestroyDevice(
 		NULL
 	);
 
+	if (renderer->supportsBindless)
+	{
+		renderer->vkDestroyDescriptorPool(
+			renderer->logicalDevice,
+			renderer->bindlessDescriptorPool,
+			NULL
+		);
+
+		renderer->vkDestroyDescriptorSetLayout(
+			renderer->logicalDevice,
+			renderer->bindlessDescriptorSetLayout,
+			NULL
+		);
+
+		SDL_free(renderer->bindlessSamplers);
+	}
+
+	SDL_free(renderer->bindlessTextureIndices.freeIndices);
+	SDL_free(renderer->bindlessSamplerIndices.freeIndices);
+
 	VULKAN_INTERNAL_DestroySwapchain(renderer);
 
 	if (!renderer->headless)
@@ -3785,13 +5730,6 @@ static void VULKAN_DestroyDevice(
 
 		for (j = 0; j < allocator->allocationCount; j += 1)
 		{
-			for (k = 0; k < allocator->allocations[j]->freeRegionCount; k += 1)
-			{
-				SDL_free(allocator->allocations[j]->freeRegions[k]);
-			}
-
-			SDL_free(allocator->allocations[j]->freeRegions);
-
 			renderer->vkFreeMemory(
 				renderer->logicalDevice,
 				allocator->allocations[j]->memory,
@@ -3803,17 +5741,24 @@ static void VULKAN_DestroyDevice(
 		}
 
 		SDL_free(allocator->allocations);
-		SDL_free(allocator->sortedFreeRegions);
 	}
 
+	for (i = 0; i < renderer->memoryAllocator->regionPoolChunkCount; i += 1)
+	{
+		SDL_free(renderer->memoryAllocator->regionPoolChunks[i]);
+	}
+
+	SDL_free(renderer->memoryAllocator->regionPoolChunks);
 	SDL_free(renderer->memoryAllocator);
 
 	SDL_DestroyMutex(renderer->allocatorLock);
 	SDL_DestroyMutex(renderer->disposeLock);
 	SDL_DestroyMutex(renderer->uniformBufferLock);
-	SDL_DestroyMutex(renderer->descriptorSetLock);
 	SDL_DestroyMutex(renderer->boundBufferLock);
 	SDL_DestroyMutex(renderer->stagingLock);
+	SDL_DestroyMutex(renderer->readbackLock);
+	SDL_DestroyMutex(renderer->bindlessLock);
+	SDL_DestroyMutex(renderer->commandPoolLock);
 
 	SDL_free(renderer->buffersInUse);
 
@@ -3939,6 +5884,132 @@ static void VULKAN_Clear(
 	);
 }
 
+/* Binds only the range of sets that differs from what the command buffer
+ * already has bound. Sets from firstDynamicSet on carry one dynamic
+ * offset each, so an offset change rebinds its set.
+ */
+static void VULKAN_INTERNAL_BindDescriptorSets(
+	VulkanRenderer *renderer,
+	VulkanCommandBuffer *vulkanCommandBuffer,
+	VkPipelineBindPoint bindPoint,
+	VkPipelineLayout pipelineLayout,
+	VulkanBoundDescriptorSets *boundSets,
+	VkDescriptorSet *descriptorSets,
+	uint32_t setCount,
+	uint32_t *dynamicOffsets,
+	uint32_t firstDynamicSet,
+	uint32_t dynamicSetCount
+) {
+	uint32_t firstChanged = setCount;
+	uint32_t lastChanged = 0;
+	uint32_t endDynamicSet = firstDynamicSet + dynamicSetCount;
+	uint32_t firstDynamic, lastDynamic, dynamicOffsetCount;
+	uint32_t i;
+
+	for (i = 0; i < setCount; i += 1)
+	{
+		if (	pipelineLayout != boundSets->pipelineLayout ||
+			descriptorSets[i] != boundSets->descriptorSets[i] ||
+			(	i >= firstDynamicSet && i < endDynamicSet &&
+				dynamicOffsets[i - firstDynamicSet] != boundSets->dynamicOffsets[i - firstDynamicSet]	)	)
+		{
+			if (firstChanged == setCount)
+			{
+				firstChanged = i;
+			}
+			lastChanged = i;
+		}
+	}
+
+	if (firstChanged == setCount)
+	{
+		vulkanCommandBuffer->stats.descriptorSetBindsElided += setCount;
+		return;
+	}
+
+	vulkanCommandBuffer->stats.descriptorSetBindsElided +=
+		setCount - (lastChanged - firstChanged + 1);
+
+	firstDynamic = SDL_max(firstChanged, firstDynamicSet);
+	lastDynamic = SDL_min(lastChanged, endDynamicSet - 1);
+	dynamicOffsetCount = (lastDynamic >= firstDynamic) ?
+		lastDynamic - firstDynamic + 1 :
+		0;
+
+	renderer->vkCmdBindDescriptorSets(
+		vulkanCommandBuffer->commandBuffer,
+		bindPoint,
+		pipelineLayout,
+		firstChanged,
+		lastChanged - firstChanged + 1,
+		&descriptorSets[firstChanged],
+		dynamicOffsetCount,
+		&dynamicOffsets[firstDynamic - firstDynamicSet]
+	);
+
+	boundSets->pipelineLayout = pipelineLayout;
+	for (i = 0; i < setCount; i += 1)
+	{
+		boundSets->descriptorSets[i] = descriptorSets[i];
+		if (i >= firstDynamicSet && i < endDynamicSet)
+		{
+			boundSets->dynamicOffsets[i - firstDynamicSet] = dynamicOffsets[i - firstDynamicSet];
+		}
+	}
+}
+
+/* Returns 0 if a uniform set could not be fetched, the draw is then skipped */
+static uint8_t VULKAN_INTERNAL_BindGraphicsDescriptorSets(
+	VulkanRenderer *renderer,
+	VulkanCommandBuffer *vulkanCommandBuffer,
+	uint32_t vertexParamOffset,
+	uint32_t fragmentParamOffset
+) {
+	VkDescriptorSet descriptorSets[5];
+	uint32_t dynamicOffsets[2];
+
+	descriptorSets[0] = vulkanCommandBuffer->vertexSamplerDescriptorSet;
+	descriptorSets[1] = vulkanCommandBuffer->fragmentSamplerDescriptorSet;
+	descriptorSets[2] = VULKAN_INTERNAL_FetchPushedUniformDescriptorSet(
+		renderer,
+		renderer->vertexUniformBufferPool,
+		&vulkanCommandBuffer->vertexUniformBinding,
+		vulkanCommandBuffer->currentGraphicsPipeline->vertexUBOBlockSize,
+		vertexParamOffset,
+		&dynamicOffsets[0]
+	);
+	descriptorSets[3] = VULKAN_INTERNAL_FetchPushedUniformDescriptorSet(
+		renderer,
+		renderer->fragmentUniformBufferPool,
+		&vulkanCommandBuffer->fragmentUniformBinding,
+		vulkanCommandBuffer->currentGraphicsPipeline->fragmentUBOBlockSize,
+		fragmentParamOffset,
+		&dynamicOffsets[1]
+	);
+	descriptorSets[4] = renderer->bindlessDescriptorSet;
+
+	if (	descriptorSets[2] == VK_NULL_HANDLE ||
+		descriptorSets[3] == VK_NULL_HANDLE	)
+	{
+		return 0;
+	}
+
+	VULKAN_INTERNAL_BindDescriptorSets(
+		renderer,
+		vulkanCommandBuffer,
+		VK_PIPELINE_BIND_POINT_GRAPHICS,
+		vulkanCommandBuffer->currentGraphicsPipeline->pipelineLayout->pipelineLayout,
+		&vulkanCommandBuffer->boundGraphicsSets,
+		descriptorSets,
+		renderer->supportsBindless ? 5 : 4,
+		dynamicOffsets,
+		2,
+		2
+	);
+
+	return 1;
+}
+
 static void VULKAN_DrawInstancedPrimitives(
 	Refresh_Renderer *driverData,
 	Refresh_CommandBuffer *commandBuffer,
@@ -3952,27 +6023,14 @@ static void VULKAN_DrawInstancedPrimitives(
 	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
 	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
 
-	VkDescriptorSet descriptorSets[4];
-	uint32_t dynamicOffsets[2];
-
-	descriptorSets[0] = vulkanCommandBuffer->currentGraphicsPipeline->vertexSamplerDescriptorSet;
-	descriptorSets[1] = vulkanCommandBuffer->currentGraphicsPipeline->fragmentSamplerDescriptorSet;
-	descriptorSets[2] = vulkanCommandBuffer->currentGraphicsPipeline->vertexUBODescriptorSet;
-	descriptorSets[3] = vulkanCommandBuffer->currentGraphicsPipeline->fragmentUBODescriptorSet;
-
-	dynamicOffsets[0] = vertexParamOffset;
-	dynamicOffsets[1] = fragmentParamOffset;
-
-	renderer->vkCmdBindDescriptorSets(
-		vulkanCommandBuffer->commandBuffer,
-		VK_PIPELINE_BIND_POINT_GRAPHICS,
-		vulkanCommandBuffer->currentGraphicsPipeline->pipelineLayout->pipelineLayout,
-		0,
-		4,
-		descriptorSets,
-		2,
-		dynamicOffsets
-	);
+	if (!VULKAN_INTERNAL_BindGraphicsDescriptorSets(
+		renderer,
+		vulkanCommandBuffer,
+		vertexParamOffset,
+		fragmentParamOffset
+	)) {
+		return;
+	}
 
 	renderer->vkCmdDrawIndexed(
 		vulkanCommandBuffer->commandBuffer,
@@ -4008,6 +6066,115 @@ static void VULKAN_DrawIndexedPrimitives(
 	);
 }
 
+static void VULKAN_INTERNAL_FlushMultiDrawIndexed(
+	VulkanRenderer *renderer,
+	VulkanCommandBuffer *vulkanCommandBuffer,
+	VkMultiDrawIndexedInfoEXT *multiDrawInfos,
+	uint32_t multiDrawCount,
+	uint32_t instanceCount
+) {
+	renderer->vkCmdDrawMultiIndexedEXT(
+		vulkanCommandBuffer->commandBuffer,
+		multiDrawCount,
+		multiDrawInfos,
+		instanceCount,
+		0,
+		sizeof(VkMultiDrawIndexedInfoEXT),
+		NULL
+	);
+}
+
+static void VULKAN_DrawIndexedPrimitivesBatch(
+	Refresh_Renderer *driverData,
+	Refresh_CommandBuffer *commandBuffer,
+	const Refresh_IndexedDraw *draws,
+	uint32_t drawCount
+) {
+	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
+	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+	Refresh_PrimitiveType primitiveType = vulkanCommandBuffer->currentGraphicsPipeline->primitiveType;
+
+	VkMultiDrawIndexedInfoEXT multiDrawInfos[MULTI_DRAW_BATCH_SIZE];
+	uint32_t multiDrawCount = 0;
+	const Refresh_IndexedDraw *draw;
+	uint8_t offsetsChanged;
+	uint32_t i;
+
+	for (i = 0; i < drawCount; i += 1)
+	{
+		draw = &draws[i];
+		offsetsChanged = (
+			i == 0 ||
+			draw->vertexParamOffset != draws[i - 1].vertexParamOffset ||
+			draw->fragmentParamOffset != draws[i - 1].fragmentParamOffset
+		);
+
+		/* A multi-draw shares its descriptor offsets and instance count */
+		if (	multiDrawCount > 0 &&
+			(	offsetsChanged ||
+				draw->instanceCount != draws[i - 1].instanceCount ||
+				multiDrawCount == MULTI_DRAW_BATCH_SIZE	)	)
+		{
+			VULKAN_INTERNAL_FlushMultiDrawIndexed(
+				renderer,
+				vulkanCommandBuffer,
+				multiDrawInfos,
+				multiDrawCount,
+				draws[i - 1].instanceCount
+			);
+			multiDrawCount = 0;
+		}
+
+		/* Pending multi-draws were flushed above, so nothing is lost */
+		if (	offsetsChanged &&
+			!VULKAN_INTERNAL_BindGraphicsDescriptorSets(
+				renderer,
+				vulkanCommandBuffer,
+				draw->vertexParamOffset,
+				draw->fragmentParamOffset
+			)	)
+		{
+			return;
+		}
+
+		if (renderer->supportsMultiDraw)
+		{
+			multiDrawInfos[multiDrawCount].firstIndex = draw->startIndex;
+			multiDrawInfos[multiDrawCount].indexCount = PrimitiveVerts(
+				primitiveType,
+				draw->primitiveCount
+			);
+			multiDrawInfos[multiDrawCount].vertexOffset = (int32_t) draw->baseVertex;
+			multiDrawCount += 1;
+		}
+		else
+		{
+			renderer->vkCmdDrawIndexed(
+				vulkanCommandBuffer->commandBuffer,
+				PrimitiveVerts(
+					primitiveType,
+					draw->primitiveCount
+				),
+				draw->instanceCount,
+				draw->startIndex,
+				draw->baseVertex,
+				0
+			);
+		}
+	}
+
+	if (multiDrawCount > 0)
+	{
+		VULKAN_INTERNAL_FlushMultiDrawIndexed(
+			renderer,
+			vulkanCommandBuffer,
+			multiDrawInfos,
+			multiDrawCount,
+			draws[drawCount - 1].instanceCount
+		);
+	}
+}
+
 static void VULKAN_DrawPrimitives(
 	Refresh_Renderer *driverData,
 	Refresh_CommandBuffer *commandBuffer,
@@ -4019,27 +6186,14 @@ static void VULKAN_DrawPrimitives(
 	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
 	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
 
-	VkDescriptorSet descriptorSets[4];
-	uint32_t dynamicOffsets[2];
-
-	descriptorSets[0] = vulkanCommandBuffer->currentGraphicsPipeline->vertexSamplerDescriptorSet;
-	descriptorSets[1] = vulkanCommandBuffer->currentGraphicsPipeline->fragmentSamplerDescriptorSet;
-	descriptorSets[2] = vulkanCommandBuffer->currentGraphicsPipeline->vertexUBODescriptorSet;
-	descriptorSets[3] = vulkanCommandBuffer->currentGraphicsPipeline->fragmentUBODescriptorSet;
-
-	dynamicOffsets[0] = vertexParamOffset;
-	dynamicOffsets[1] = fragmentParamOffset;
-
-	renderer->vkCmdBindDescriptorSets(
-		vulkanCommandBuffer->commandBuffer,
-		VK_PIPELINE_BIND_POINT_GRAPHICS,
-		vulkanCommandBuffer->currentGraphicsPipeline->pipelineLayout->pipelineLayout,
-		0,
-		4,
-		descriptorSets,
-		2,
-		dynamicOffsets
-	);
+	if (!VULKAN_INTERNAL_BindGraphicsDescriptorSets(
+		renderer,
+		vulkanCommandBuffer,
+		vertexParamOffset,
+		fragmentParamOffset
+	)) {
+		return;
+	}
 
 	renderer->vkCmdDraw(
 		vulkanCommandBuffer->commandBuffer,
@@ -4053,80 +6207,345 @@ static void VULKAN_DrawPrimitives(
 	);
 }
 
-static void VULKAN_DispatchCompute(
-	Refresh_Renderer *driverData,
-	Refresh_CommandBuffer *commandBuffer,
-	uint32_t groupCountX,
-	uint32_t groupCountY,
-	uint32_t groupCountZ,
-	uint32_t computeParamOffset
-) {
-	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
-	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
-	VulkanComputePipeline *computePipeline = vulkanCommandBuffer->currentComputePipeline;
-
-	VulkanBuffer *currentBuffer;
-	VkDescriptorSet descriptorSets[3];
+static void VULKAN_INTERNAL_DrawIndirect(
+	VulkanRenderer *renderer,
+	VulkanCommandBuffer *vulkanCommandBuffer,
+	VulkanBuffer *vulkanBuffer,
+	uint32_t offsetInBytes,
+	uint32_t drawCount,
+	uint32_t stride,
+	uint32_t vertexParamOffset,
+	uint32_t fragmentParamOffset,
+	uint8_t indexed
+) {
+	VulkanSubBuffer *subBuffer;
+	VkDeviceSize argumentOffset;
+	VkDeviceSize commandSize = indexed ?
+		sizeof(VkDrawIndexedIndirectCommand) :
+		sizeof(VkDrawIndirectCommand);
 	uint32_t i;
 
-	for (i = 0; i < vulkanCommandBuffer->boundComputeBufferCount; i += 1)
+	if (drawCount == 0)
 	{
-		currentBuffer = vulkanCommandBuffer->boundComputeBuffers[i];
-		VULKAN_INTERNAL_BufferMemoryBarrier(
-			renderer,
-			vulkanCommandBuffer->commandBuffer,
-			RESOURCE_ACCESS_COMPUTE_SHADER_READ_OTHER,
-			currentBuffer,
-			currentBuffer->subBuffers[currentBuffer->currentSubBufferIndex]
-		);
+		return;
 	}
 
-	descriptorSets[0] = computePipeline->bufferDescriptorSet;
-	descriptorSets[1] = computePipeline->imageDescriptorSet;
-	descriptorSets[2] = computePipeline->computeUBODescriptorSet;
+	if (!(vulkanBuffer->usage & VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT))
+	{
+		Refresh_LogError("Indirect draw buffer needs REFRESH_BUFFERUSAGE_INDIRECT_BIT!");
+		return;
+	}
 
-	renderer->vkCmdBindDescriptorSets(
-		vulkanCommandBuffer->commandBuffer,
-		VK_PIPELINE_BIND_POINT_COMPUTE,
-		computePipeline->pipelineLayout->pipelineLayout,
-		0,
-		3,
-		descriptorSets,
-		1,
-		&computeParamOffset
-	);
+	if (offsetInBytes & 3)
+	{
+		Refresh_LogError("Indirect draw offset must be a multiple of 4!");
+		return;
+	}
 
-	renderer->vkCmdDispatch(
-		vulkanCommandBuffer->commandBuffer,
-		groupCountX,
-		groupCountY,
-		groupCountZ
-	);
+	if (drawCount > 1 && ((stride & 3) || stride < commandSize))
+	{
+		Refresh_LogError("Indirect draw stride must be a multiple of 4 and at least the command size!");
+		return;
+	}
 
-	for (i = 0; i < vulkanCommandBuffer->boundComputeBufferCount; i += 1)
+	/* Done in 64 bits so the last command's offset cannot wrap */
+	if (	offsetInBytes > vulkanBuffer->size ||
+		(VkDeviceSize) (drawCount - 1) * stride + commandSize > vulkanBuffer->size - offsetInBytes	)
 	{
-		currentBuffer = vulkanCommandBuffer->boundComputeBuffers[i];
-		if (currentBuffer->usage & VK_BUFFER_USAGE_VERTEX_BUFFER_BIT)
+		Refresh_LogError("Indirect draw commands exceed buffer size!");
+		return;
+	}
+
+	/* The fallback below issues one draw per call, so the limit only
+	 * applies when the whole count goes to a single call.
+	 */
+	if (	renderer->supportsMultiDrawIndirect &&
+		drawCount > renderer->physicalDeviceProperties.properties.limits.maxDrawIndirectCount	)
+	{
+		Refresh_LogError("Indirect draw count exceeds maxDrawIndirectCount!");
+		return;
+	}
+
+	VULKAN_INTERNAL_MarkAsBound(renderer, vulkanBuffer);
+	subBuffer = vulkanBuffer->subBuffers[vulkanBuffer->currentSubBufferIndex];
+	argumentOffset = subBuffer->bufferOffset + offsetInBytes;
+
+	if (!VULKAN_INTERNAL_BindGraphicsDescriptorSets(
+		renderer,
+		vulkanCommandBuffer,
+		vertexParamOffset,
+		fragmentParamOffset
+	)) {
+		return;
+	}
+
+	/* No barrier can be recorded inside the render pass.
+	 * GPU writes to the argument buffer already leave it in the
+	 * indirect read state, see VULKAN_INTERNAL_BufferReadBarrier.
+	 */
+
+	if (renderer->supportsMultiDrawIndirect)
+	{
+		if (indexed)
 		{
-			VULKAN_INTERNAL_BufferMemoryBarrier(
-				renderer,
+			renderer->vkCmdDrawIndexedIndirect(
 				vulkanCommandBuffer->commandBuffer,
-				RESOURCE_ACCESS_VERTEX_BUFFER,
-				currentBuffer,
-				currentBuffer->subBuffers[currentBuffer->currentSubBufferIndex]
+				subBuffer->buffer,
+				argumentOffset,
+				drawCount,
+				stride
 			);
 		}
-		else if (currentBuffer->usage & VK_BUFFER_USAGE_INDEX_BUFFER_BIT)
+		else
 		{
-			VULKAN_INTERNAL_BufferMemoryBarrier(
-				renderer,
+			renderer->vkCmdDrawIndirect(
 				vulkanCommandBuffer->commandBuffer,
-				RESOURCE_ACCESS_INDEX_BUFFER,
-				currentBuffer,
-				currentBuffer->subBuffers[currentBuffer->currentSubBufferIndex]
+				subBuffer->buffer,
+				argumentOffset,
+				drawCount,
+				stride
 			);
 		}
 	}
+	else
+	{
+		/* Without multiDrawIndirect the draw count must be 0 or 1 */
+		for (i = 0; i < drawCount; i += 1)
+		{
+			if (indexed)
+			{
+				renderer->vkCmdDrawIndexedIndirect(
+					vulkanCommandBuffer->commandBuffer,
+					subBuffer->buffer,
+					argumentOffset + (VkDeviceSize) i * stride,
+					1,
+					stride
+				);
+			}
+			else
+			{
+				renderer->vkCmdDrawIndirect(
+					vulkanCommandBuffer->commandBuffer,
+					subBuffer->buffer,
+					argumentOffset + (VkDeviceSize) i * stride,
+					1,
+					stride
+				);
+			}
+		}
+	}
+}
+
+static void VULKAN_DrawIndexedPrimitivesIndirect(
+	Refresh_Renderer *driverData,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_Buffer *buffer,
+	uint32_t offsetInBytes,
+	uint32_t drawCount,
+	uint32_t stride,
+	uint32_t vertexParamOffset,
+	uint32_t fragmentParamOffset
+) {
+	VULKAN_INTERNAL_DrawIndirect(
+		(VulkanRenderer*) driverData,
+		(VulkanCommandBuffer*) commandBuffer,
+		(VulkanBuffer*) buffer,
+		offsetInBytes,
+		drawCount,
+		stride,
+		vertexParamOffset,
+		fragmentParamOffset,
+		1
+	);
+}
+
+static void VULKAN_DrawPrimitivesIndirect(
+	Refresh_Renderer *driverData,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_Buffer *buffer,
+	uint32_t offsetInBytes,
+	uint32_t drawCount,
+	uint32_t stride,
+	uint32_t vertexParamOffset,
+	uint32_t fragmentParamOffset
+) {
+	VULKAN_INTERNAL_DrawIndirect(
+		(VulkanRenderer*) driverData,
+		(VulkanCommandBuffer*) commandBuffer,
+		(VulkanBuffer*) buffer,
+		offsetInBytes,
+		drawCount,
+		stride,
+		vertexParamOffset,
+		fragmentParamOffset,
+		0
+	);
+}
+
+/* Returns 0 if the uniform set could not be fetched, the dispatch is then skipped */
+static uint8_t VULKAN_INTERNAL_BeginDispatch(
+	VulkanRenderer *renderer,
+	VulkanCommandBuffer *vulkanCommandBuffer,
+	uint32_t computeParamOffset
+) {
+	VulkanComputePipeline *computePipeline = vulkanCommandBuffer->currentComputePipeline;
+	VulkanBuffer *currentBuffer;
+	VkDescriptorSet descriptorSets[4];
+	uint32_t dynamicOffset;
+	uint32_t i;
+
+	descriptorSets[0] = vulkanCommandBuffer->computeBufferDescriptorSet;
+	descriptorSets[1] = vulkanCommandBuffer->computeImageDescriptorSet;
+	descriptorSets[2] = VULKAN_INTERNAL_FetchPushedUniformDescriptorSet(
+		renderer,
+		renderer->computeUniformBufferPool,
+		&vulkanCommandBuffer->computeUniformBinding,
+		computePipeline->computeUBOBlockSize,
+		computeParamOffset,
+		&dynamicOffset
+	);
+	descriptorSets[3] = renderer->bindlessDescriptorSet;
+
+	if (descriptorSets[2] == VK_NULL_HANDLE)
+	{
+		return 0;
+	}
+
+	/* Bound buffers may be written by the shader, so track the write */
+	for (i = 0; i < vulkanCommandBuffer->boundComputeBufferCount; i += 1)
+	{
+		currentBuffer = vulkanCommandBuffer->boundComputeBuffers[i];
+		VULKAN_INTERNAL_BufferMemoryBarrier(
+			renderer,
+			vulkanCommandBuffer->commandBuffer,
+			RESOURCE_ACCESS_COMPUTE_SHADER_BUFFER_READ_WRITE,
+			currentBuffer,
+			currentBuffer->subBuffers[currentBuffer->currentSubBufferIndex]
+		);
+	}
+
+	VULKAN_INTERNAL_BindDescriptorSets(
+		renderer,
+		vulkanCommandBuffer,
+		VK_PIPELINE_BIND_POINT_COMPUTE,
+		computePipeline->pipelineLayout->pipelineLayout,
+		&vulkanCommandBuffer->boundComputeSets,
+		descriptorSets,
+		renderer->supportsBindless ? 4 : 3,
+		&dynamicOffset,
+		2,
+		1
+	);
+
+	return 1;
+}
+
+static void VULKAN_INTERNAL_EndDispatch(
+	VulkanRenderer *renderer,
+	VulkanCommandBuffer *vulkanCommandBuffer
+) {
+	VulkanBuffer *currentBuffer;
+	uint32_t i;
+
+	for (i = 0; i < vulkanCommandBuffer->boundComputeBufferCount; i += 1)
+	{
+		currentBuffer = vulkanCommandBuffer->boundComputeBuffers[i];
+		VULKAN_INTERNAL_BufferReadBarrier(
+			renderer,
+			vulkanCommandBuffer->commandBuffer,
+			currentBuffer,
+			currentBuffer->subBuffers[currentBuffer->currentSubBufferIndex]
+		);
+	}
+}
+
+static void VULKAN_DispatchCompute(
+	Refresh_Renderer *driverData,
+	Refresh_CommandBuffer *commandBuffer,
+	uint32_t groupCountX,
+	uint32_t groupCountY,
+	uint32_t groupCountZ,
+	uint32_t computeParamOffset
+) {
+	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
+	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+
+	if (!VULKAN_INTERNAL_BeginDispatch(
+		renderer,
+		vulkanCommandBuffer,
+		computeParamOffset
+	)) {
+		return;
+	}
+
+	renderer->vkCmdDispatch(
+		vulkanCommandBuffer->commandBuffer,
+		groupCountX,
+		groupCountY,
+		groupCountZ
+	);
+
+	VULKAN_INTERNAL_EndDispatch(renderer, vulkanCommandBuffer);
+}
+
+static void VULKAN_DispatchComputeIndirect(
+	Refresh_Renderer *driverData,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_Buffer *buffer,
+	uint32_t offsetInBytes,
+	uint32_t computeParamOffset
+) {
+	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
+	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+	VulkanBuffer *vulkanBuffer = (VulkanBuffer*) buffer;
+	VulkanSubBuffer *subBuffer;
+
+	if (!(vulkanBuffer->usage & VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT))
+	{
+		Refresh_LogError("Indirect dispatch buffer needs REFRESH_BUFFERUSAGE_INDIRECT_BIT!");
+		return;
+	}
+
+	if (offsetInBytes & 3)
+	{
+		Refresh_LogError("Indirect dispatch offset must be a multiple of 4!");
+		return;
+	}
+
+	if (	offsetInBytes > vulkanBuffer->size ||
+		sizeof(VkDispatchIndirectCommand) > vulkanBuffer->size - offsetInBytes	)
+	{
+		Refresh_LogError("Indirect dispatch command exceeds buffer size!");
+		return;
+	}
+
+	VULKAN_INTERNAL_MarkAsBound(renderer, vulkanBuffer);
+	subBuffer = vulkanBuffer->subBuffers[vulkanBuffer->currentSubBufferIndex];
+
+	/* The arguments may come from an earlier dispatch or copy */
+	VULKAN_INTERNAL_BufferMemoryBarrier(
+		renderer,
+		vulkanCommandBuffer->commandBuffer,
+		RESOURCE_ACCESS_INDIRECT_BUFFER,
+		vulkanBuffer,
+		subBuffer
+	);
+
+	if (!VULKAN_INTERNAL_BeginDispatch(
+		renderer,
+		vulkanCommandBuffer,
+		computeParamOffset
+	)) {
+		return;
+	}
+
+	renderer->vkCmdDispatchIndirect(
+		vulkanCommandBuffer->commandBuffer,
+		subBuffer->buffer,
+		subBuffer->bufferOffset + offsetInBytes
+	);
+
+	VULKAN_INTERNAL_EndDispatch(renderer, vulkanCommandBuffer);
 }
 
 static Refresh_RenderPass* VULKAN_CreateRenderPass(
@@ -4384,8 +6803,6 @@ static uint8_t VULKAN_INTERNAL_AllocateDescriptorSets(
 	VkDescriptorSetAllocateInfo descriptorSetAllocateInfo;
 	VkDescriptorSetLayout *descriptorSetLayouts = SDL_stack_alloc(VkDescriptorSetLayout, descriptorSetCount);
 
-	SDL_LockMutex(renderer->descriptorSetLock);
-
 	for (i = 0; i < descriptorSetCount; i += 1)
 	{
 		descriptorSetLayouts[i] = descriptorSetLayout;
@@ -4410,35 +6827,174 @@ static uint8_t VULKAN_INTERNAL_AllocateDescriptorSets(
 		return 0;
 	}
 
-	SDL_UnlockMutex(renderer->descriptorSetLock);
-
 	SDL_stack_free(descriptorSetLayouts);
 	return 1;
 }
 
-static ImageDescriptorSetCache* VULKAN_INTERNAL_CreateImageDescriptorSetCache(
+/* Builds a template that writes one descriptor per binding from a packed
+ * array of descriptor infos, matching the *DescriptorSetData structs.
+ */
+static uint8_t VULKAN_INTERNAL_CreateDescriptorUpdateTemplate(
 	VulkanRenderer *renderer,
 	VkDescriptorType descriptorType,
 	VkDescriptorSetLayout descriptorSetLayout,
-	uint32_t bindingCount
+	uint32_t bindingCount,
+	size_t descriptorInfoSize,
+	VkDescriptorUpdateTemplateKHR *pDescriptorUpdateTemplate
+) {
+	VkResult vulkanResult;
+	VkDescriptorUpdateTemplateEntryKHR *entries;
+	VkDescriptorUpdateTemplateCreateInfoKHR templateCreateInfo;
+	uint32_t i;
+
+	entries = SDL_malloc(sizeof(VkDescriptorUpdateTemplateEntryKHR) * bindingCount);
+
+	for (i = 0; i < bindingCount; i += 1)
+	{
+		entries[i].dstBinding = i;
+		entries[i].dstArrayElement = 0;
+		entries[i].descriptorCount = 1;
+		entries[i].descriptorType = descriptorType;
+		entries[i].offset = descriptorInfoSize * i;
+		entries[i].stride = descriptorInfoSize;
+	}
+
+	templateCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO_KHR;
+	templateCreateInfo.pNext = NULL;
+	templateCreateInfo.flags = 0;
+	templateCreateInfo.descriptorUpdateEntryCount = bindingCount;
+	templateCreateInfo.pDescriptorUpdateEntries = entries;
+	templateCreateInfo.templateType = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET_KHR;
+	templateCreateInfo.descriptorSetLayout = descriptorSetLayout;
+	/* Only used by push descriptor templates */
+	templateCreateInfo.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+	templateCreateInfo.pipelineLayout = VK_NULL_HANDLE;
+	templateCreateInfo.set = 0;
+
+	vulkanResult = renderer->vkCreateDescriptorUpdateTemplateKHR(
+		renderer->logicalDevice,
+		&templateCreateInfo,
+		NULL,
+		pDescriptorUpdateTemplate
+	);
+
+	SDL_free(entries);
+
+	if (vulkanResult != VK_SUCCESS)
+	{
+		LogVulkanResultAsError("vkCreateDescriptorUpdateTemplateKHR", vulkanResult);
+		return 0;
+	}
+
+	return 1;
+}
+
+/* Writes every binding of a cached descriptor set from its packed infos.
+ * Exactly one of imageInfos and bufferInfos is non-NULL.
+ */
+static void VULKAN_INTERNAL_UpdateCachedDescriptorSet(
+	VulkanRenderer *renderer,
+	VkDescriptorSet descriptorSet,
+	VkDescriptorUpdateTemplateKHR descriptorUpdateTemplate,
+	VkDescriptorType descriptorType,
+	uint32_t bindingCount,
+	VkDescriptorImageInfo *imageInfos,
+	VkDescriptorBufferInfo *bufferInfos
 ) {
+	VkWriteDescriptorSet *writeDescriptorSets;
 	uint32_t i;
+
+	if (descriptorUpdateTemplate != VK_NULL_HANDLE)
+	{
+		renderer->vkUpdateDescriptorSetWithTemplateKHR(
+			renderer->logicalDevice,
+			descriptorSet,
+			descriptorUpdateTemplate,
+			(imageInfos != NULL) ? (void*) imageInfos : (void*) bufferInfos
+		);
+		return;
+	}
+
+	writeDescriptorSets = SDL_stack_alloc(VkWriteDescriptorSet, bindingCount);
+
+	for (i = 0; i < bindingCount; i += 1)
+	{
+		writeDescriptorSets[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		writeDescriptorSets[i].pNext = NULL;
+		writeDescriptorSets[i].dstSet = descriptorSet;
+		writeDescriptorSets[i].dstBinding = i;
+		writeDescriptorSets[i].dstArrayElement = 0;
+		writeDescriptorSets[i].descriptorCount = 1;
+		writeDescriptorSets[i].descriptorType = descriptorType;
+		writeDescriptorSets[i].pImageInfo = (imageInfos != NULL) ? &imageInfos[i] : NULL;
+		writeDescriptorSets[i].pBufferInfo = (bufferInfos != NULL) ? &bufferInfos[i] : NULL;
+		writeDescriptorSets[i].pTexelBufferView = NULL;
+	}
+
+	renderer->vkUpdateDescriptorSets(
+		renderer->logicalDevice,
+		bindingCount,
+		writeDescriptorSets,
+		0,
+		NULL
+	);
+
+	SDL_stack_free(writeDescriptorSets);
+}
+
+static DescriptorSetCacheInfo* VULKAN_INTERNAL_CreateDescriptorSetCacheInfo(
+	VulkanRenderer *renderer,
+	VkDescriptorType descriptorType,
+	VkDescriptorSetLayout descriptorSetLayout,
+	uint32_t bindingCount,
+	size_t descriptorInfoSize,
+	SDL_atomic_t *infoCount
+) {
+	DescriptorSetCacheInfo *info = SDL_malloc(sizeof(DescriptorSetCacheInfo));
+
+	info->id = (uint32_t) SDL_AtomicAdd(infoCount, 1);
+	info->descriptorSetLayout = descriptorSetLayout;
+	info->bindingCount = bindingCount;
+	info->descriptorType = descriptorType;
+
+	/* Without a template, sets are written with vkUpdateDescriptorSets */
+	if (!VULKAN_INTERNAL_CreateDescriptorUpdateTemplate(
+		renderer,
+		descriptorType,
+		descriptorSetLayout,
+		bindingCount,
+		descriptorInfoSize,
+		&info->descriptorUpdateTemplate
+	)) {
+		info->descriptorUpdateTemplate = VK_NULL_HANDLE;
+	}
+
+	return info;
+}
+
+static ImageDescriptorSetCache* VULKAN_INTERNAL_CreateImageDescriptorSetCache(
+	VulkanRenderer *renderer,
+	DescriptorSetCacheInfo *info
+) {
 	ImageDescriptorSetCache *imageDescriptorSetCache = SDL_malloc(sizeof(ImageDescriptorSetCache));
 
 	imageDescriptorSetCache->elements = SDL_malloc(sizeof(ImageDescriptorSetHashMap) * 16);
 	imageDescriptorSetCache->count = 0;
 	imageDescriptorSetCache->capacity = 16;
 
-	for (i = 0; i < NUM_DESCRIPTOR_SET_HASH_BUCKETS; i += 1)
-	{
-		imageDescriptorSetCache->buckets[i].elements = NULL;
-		imageDescriptorSetCache->buckets[i].count = 0;
-		imageDescriptorSetCache->buckets[i].capacity = 0;
-	}
+	DescriptorSetIndex_Init(
+		&imageDescriptorSetCache->index,
+		DESCRIPTOR_SET_INDEX_STARTING_SLOTS
+	);
+
+	imageDescriptorSetCache->lruHead = DESCRIPTOR_SET_INDEX_EMPTY;
+	imageDescriptorSetCache->lruTail = DESCRIPTOR_SET_INDEX_EMPTY;
+	imageDescriptorSetCache->active = 0;
 
-	imageDescriptorSetCache->descriptorSetLayout = descriptorSetLayout;
-	imageDescriptorSetCache->bindingCount = bindingCount;
-	imageDescriptorSetCache->descriptorType = descriptorType;
+	imageDescriptorSetCache->descriptorSetLayout = info->descriptorSetLayout;
+	imageDescriptorSetCache->bindingCount = info->bindingCount;
+	imageDescriptorSetCache->descriptorType = info->descriptorType;
+	imageDescriptorSetCache->descriptorUpdateTemplate = info->descriptorUpdateTemplate;
 
 	imageDescriptorSetCache->imageDescriptorPools = SDL_malloc(sizeof(VkDescriptorPool));
 	imageDescriptorSetCache->imageDescriptorPoolCount = 1;
@@ -4446,9 +7002,9 @@ static ImageDescriptorSetCache* VULKAN_INTERNAL_CreateImageDescriptorSetCache(
 
 	VULKAN_INTERNAL_CreateDescriptorPool(
 		renderer,
-		descriptorType,
+		info->descriptorType,
 		DESCRIPTOR_POOL_STARTING_SIZE,
-		DESCRIPTOR_POOL_STARTING_SIZE * bindingCount,
+		DESCRIPTOR_POOL_STARTING_SIZE * info->bindingCount,
 		&imageDescriptorSetCache->imageDescriptorPools[0]
 	);
 
@@ -4471,27 +7027,27 @@ static ImageDescriptorSetCache* VULKAN_INTERNAL_CreateImageDescriptorSetCache(
 
 static BufferDescriptorSetCache* VULKAN_INTERNAL_CreateBufferDescriptorSetCache(
 	VulkanRenderer *renderer,
-	VkDescriptorType descriptorType,
-	VkDescriptorSetLayout descriptorSetLayout,
-	uint32_t bindingCount
+	DescriptorSetCacheInfo *info
 ) {
-	uint32_t i;
 	BufferDescriptorSetCache *bufferDescriptorSetCache = SDL_malloc(sizeof(BufferDescriptorSetCache));
 
 	bufferDescriptorSetCache->elements = SDL_malloc(sizeof(BufferDescriptorSetHashMap) * 16);
 	bufferDescriptorSetCache->count = 0;
 	bufferDescriptorSetCache->capacity = 16;
 
-	for (i = 0; i < NUM_DESCRIPTOR_SET_HASH_BUCKETS; i += 1)
-	{
-		bufferDescriptorSetCache->buckets[i].elements = NULL;
-		bufferDescriptorSetCache->buckets[i].count = 0;
-		bufferDescriptorSetCache->buckets[i].capacity = 0;
-	}
+	DescriptorSetIndex_Init(
+		&bufferDescriptorSetCache->index,
+		DESCRIPTOR_SET_INDEX_STARTING_SLOTS
+	);
 
-	bufferDescriptorSetCache->descriptorSetLayout = descriptorSetLayout;
-	bufferDescriptorSetCache->bindingCount = bindingCount;
-	bufferDescriptorSetCache->descriptorType = descriptorType;
+	bufferDescriptorSetCache->lruHead = DESCRIPTOR_SET_INDEX_EMPTY;
+	bufferDescriptorSetCache->lruTail = DESCRIPTOR_SET_INDEX_EMPTY;
+	bufferDescriptorSetCache->active = 0;
+
+	bufferDescriptorSetCache->descriptorSetLayout = info->descriptorSetLayout;
+	bufferDescriptorSetCache->bindingCount = info->bindingCount;
+	bufferDescriptorSetCache->descriptorType = info->descriptorType;
+	bufferDescriptorSetCache->descriptorUpdateTemplate = info->descriptorUpdateTemplate;
 
 	bufferDescriptorSetCache->bufferDescriptorPools = SDL_malloc(sizeof(VkDescriptorPool));
 	bufferDescriptorSetCache->bufferDescriptorPoolCount = 1;
@@ -4501,7 +7057,7 @@ static BufferDescriptorSetCache* VULKAN_INTERNAL_CreateBufferDescriptorSetCache(
 		renderer,
 		VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
 		DESCRIPTOR_POOL_STARTING_SIZE,
-		DESCRIPTOR_POOL_STARTING_SIZE * bindingCount,
+		DESCRIPTOR_POOL_STARTING_SIZE * info->bindingCount,
 		&bufferDescriptorSetCache->bufferDescriptorPools[0]
 	);
 
@@ -4621,18 +7177,56 @@ static VkDescriptorSetLayout VULKAN_INTERNAL_FetchDescriptorSetLayout(
 	return descriptorSetLayout;
 }
 
-static VulkanGraphicsPipelineLayout* VULKAN_INTERNAL_FetchGraphicsPipelineLayout(
+static uint8_t VULKAN_INTERNAL_ValidatePushConstantSizes(
 	VulkanRenderer *renderer,
-	uint32_t vertexSamplerBindingCount,
-	uint32_t fragmentSamplerBindingCount
+	uint32_t firstSize,
+	uint32_t secondSize
 ) {
-	VkDescriptorSetLayout setLayouts[4];
+	uint32_t maxSize = renderer->physicalDeviceProperties.properties.limits.maxPushConstantsSize;
 
-	GraphicsPipelineLayoutHash pipelineLayoutHash;
-	VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo;
-	VkResult vulkanResult;
+	if ((firstSize % 4) != 0 || (secondSize % 4) != 0)
+	{
+		Refresh_LogError("Push constant sizes must be a multiple of 4!");
+		return 0;
+	}
 
-	VulkanGraphicsPipelineLayout *vulkanGraphicsPipelineLayout;
+	if (firstSize + secondSize > maxSize)
+	{
+		Refresh_LogError(
+			"Push constant size %u exceeds device limit of %u bytes!",
+			firstSize + secondSize,
+			maxSize
+		);
+		return 0;
+	}
+
+	return 1;
+}
+
+static VulkanGraphicsPipelineLayout* VULKAN_INTERNAL_FetchGraphicsPipelineLayout(
+	VulkanRenderer *renderer,
+	uint32_t vertexSamplerBindingCount,
+	uint32_t fragmentSamplerBindingCount,
+	uint32_t vertexPushConstantSize,
+	uint32_t fragmentPushConstantSize
+) {
+	VkDescriptorSetLayout setLayouts[5];
+	VkPushConstantRange pushConstantRanges[2];
+	uint32_t pushConstantRangeCount = 0;
+
+	GraphicsPipelineLayoutHash pipelineLayoutHash;
+	VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo;
+	VkResult vulkanResult;
+
+	VulkanGraphicsPipelineLayout *vulkanGraphicsPipelineLayout;
+
+	if (!VULKAN_INTERNAL_ValidatePushConstantSizes(
+		renderer,
+		vertexPushConstantSize,
+		fragmentPushConstantSize
+	)) {
+		return NULL;
+	}
 
 	pipelineLayoutHash.vertexSamplerLayout = VULKAN_INTERNAL_FetchDescriptorSetLayout(
 		renderer,
@@ -4650,6 +7244,8 @@ static VulkanGraphicsPipelineLayout* VULKAN_INTERNAL_FetchGraphicsPipelineLayout
 
 	pipelineLayoutHash.vertexUniformLayout = renderer->vertexParamLayout;
 	pipelineLayoutHash.fragmentUniformLayout = renderer->fragmentParamLayout;
+	pipelineLayoutHash.vertexPushConstantSize = vertexPushConstantSize;
+	pipelineLayoutHash.fragmentPushConstantSize = fragmentPushConstantSize;
 
 	vulkanGraphicsPipelineLayout = GraphicsPipelineLayoutHashArray_Fetch(
 		&renderer->graphicsPipelineLayoutHashTable,
@@ -4667,14 +7263,33 @@ static VulkanGraphicsPipelineLayout* VULKAN_INTERNAL_FetchGraphicsPipelineLayout
 	setLayouts[1] = pipelineLayoutHash.fragmentSamplerLayout;
 	setLayouts[2] = renderer->vertexParamLayout;
 	setLayouts[3] = renderer->fragmentParamLayout;
+	setLayouts[4] = renderer->bindlessDescriptorSetLayout;
+
+	/* The fragment block is packed directly after the vertex block */
+
+	if (vertexPushConstantSize > 0)
+	{
+		pushConstantRanges[pushConstantRangeCount].stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+		pushConstantRanges[pushConstantRangeCount].offset = 0;
+		pushConstantRanges[pushConstantRangeCount].size = vertexPushConstantSize;
+		pushConstantRangeCount += 1;
+	}
+
+	if (fragmentPushConstantSize > 0)
+	{
+		pushConstantRanges[pushConstantRangeCount].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+		pushConstantRanges[pushConstantRangeCount].offset = vertexPushConstantSize;
+		pushConstantRanges[pushConstantRangeCount].size = fragmentPushConstantSize;
+		pushConstantRangeCount += 1;
+	}
 
 	pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
 	pipelineLayoutCreateInfo.pNext = NULL;
 	pipelineLayoutCreateInfo.flags = 0;
-	pipelineLayoutCreateInfo.setLayoutCount = 4;
+	pipelineLayoutCreateInfo.setLayoutCount = renderer->supportsBindless ? 5 : 4;
 	pipelineLayoutCreateInfo.pSetLayouts = setLayouts;
-	pipelineLayoutCreateInfo.pushConstantRangeCount = 0;
-	pipelineLayoutCreateInfo.pPushConstantRanges = NULL;
+	pipelineLayoutCreateInfo.pushConstantRangeCount = pushConstantRangeCount;
+	pipelineLayoutCreateInfo.pPushConstantRanges = pushConstantRangeCount > 0 ? pushConstantRanges : NULL;
 
 	vulkanResult = renderer->vkCreatePipelineLayout(
 		renderer->logicalDevice,
@@ -4689,6 +7304,9 @@ static VulkanGraphicsPipelineLayout* VULKAN_INTERNAL_FetchGraphicsPipelineLayout
 		return NULL;
 	}
 
+	vulkanGraphicsPipelineLayout->vertexPushConstantSize = vertexPushConstantSize;
+	vulkanGraphicsPipelineLayout->fragmentPushConstantSize = fragmentPushConstantSize;
+
 	GraphicsPipelineLayoutHashArray_Insert(
 		&renderer->graphicsPipelineLayoutHashTable,
 		pipelineLayoutHash,
@@ -4702,31 +7320,35 @@ static VulkanGraphicsPipelineLayout* VULKAN_INTERNAL_FetchGraphicsPipelineLayout
 
 	if (vertexSamplerBindingCount == 0)
 	{
-		vulkanGraphicsPipelineLayout->vertexSamplerDescriptorSetCache = NULL;
+		vulkanGraphicsPipelineLayout->vertexSamplerDescriptorSetCacheInfo = NULL;
 	}
 	else
 	{
-		vulkanGraphicsPipelineLayout->vertexSamplerDescriptorSetCache =
-			VULKAN_INTERNAL_CreateImageDescriptorSetCache(
+		vulkanGraphicsPipelineLayout->vertexSamplerDescriptorSetCacheInfo =
+			VULKAN_INTERNAL_CreateDescriptorSetCacheInfo(
 				renderer,
 				VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
 				pipelineLayoutHash.vertexSamplerLayout,
-				vertexSamplerBindingCount
+				vertexSamplerBindingCount,
+				sizeof(VkDescriptorImageInfo),
+				&renderer->imageDescriptorSetCacheInfoCount
 			);
 	}
 
 	if (fragmentSamplerBindingCount == 0)
 	{
-		vulkanGraphicsPipelineLayout->fragmentSamplerDescriptorSetCache = NULL;
+		vulkanGraphicsPipelineLayout->fragmentSamplerDescriptorSetCacheInfo = NULL;
 	}
 	else
 	{
-		vulkanGraphicsPipelineLayout->fragmentSamplerDescriptorSetCache =
-			VULKAN_INTERNAL_CreateImageDescriptorSetCache(
+		vulkanGraphicsPipelineLayout->fragmentSamplerDescriptorSetCacheInfo =
+			VULKAN_INTERNAL_CreateDescriptorSetCacheInfo(
 				renderer,
 				VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
 				pipelineLayoutHash.fragmentSamplerLayout,
-				fragmentSamplerBindingCount
+				fragmentSamplerBindingCount,
+				sizeof(VkDescriptorImageInfo),
+				&renderer->imageDescriptorSetCacheInfoCount
 			);
 	}
 
@@ -4769,13 +7391,6 @@ static Refresh_GraphicsPipeline* VULKAN_CreateGraphicsPipeline(
 		pipelineCreateInfo->colorBlendState.blendStateCount
 	);
 
-	VkDescriptorSetAllocateInfo vertexUBODescriptorAllocateInfo;
-	VkDescriptorSetAllocateInfo fragmentUBODescriptorAllocateInfo;
-
-	VkWriteDescriptorSet uboWriteDescriptorSets[2];
-	VkDescriptorBufferInfo vertexUniformBufferInfo;
-	VkDescriptorBufferInfo fragmentUniformBufferInfo;
-
 	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
 
 	/* Shader stages */
@@ -5035,9 +7650,24 @@ static Refresh_GraphicsPipeline* VULKAN_CreateGraphicsPipeline(
 	graphicsPipeline->pipelineLayout = VULKAN_INTERNAL_FetchGraphicsPipelineLayout(
 		renderer,
 		pipelineCreateInfo->pipelineLayoutCreateInfo.vertexSamplerBindingCount,
-		pipelineCreateInfo->pipelineLayoutCreateInfo.fragmentSamplerBindingCount
+		pipelineCreateInfo->pipelineLayoutCreateInfo.fragmentSamplerBindingCount,
+		pipelineCreateInfo->pipelineLayoutCreateInfo.vertexPushConstantSize,
+		pipelineCreateInfo->pipelineLayoutCreateInfo.fragmentPushConstantSize
 	);
 
+	if (graphicsPipeline->pipelineLayout == NULL)
+	{
+		Refresh_LogError("Failed to create graphics pipeline layout!");
+
+		SDL_stack_free(vertexInputBindingDescriptions);
+		SDL_stack_free(vertexInputAttributeDescriptions);
+		SDL_stack_free(viewports);
+		SDL_stack_free(scissors);
+		SDL_stack_free(colorBlendAttachmentStates);
+		SDL_free(graphicsPipeline);
+		return NULL;
+	}
+
 	/* Pipeline */
 
 	vkPipelineCreateInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
@@ -5089,102 +7719,30 @@ static Refresh_GraphicsPipeline* VULKAN_CreateGraphicsPipeline(
 	SDL_stack_free(scissors);
 	SDL_stack_free(colorBlendAttachmentStates);
 
-	/* Allocate uniform buffer descriptors */
-
-	vertexUBODescriptorAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-	vertexUBODescriptorAllocateInfo.pNext = NULL;
-	vertexUBODescriptorAllocateInfo.descriptorPool = renderer->defaultDescriptorPool;
-	vertexUBODescriptorAllocateInfo.descriptorSetCount = 1;
-	vertexUBODescriptorAllocateInfo.pSetLayouts = &renderer->vertexParamLayout;
-
-	renderer->vkAllocateDescriptorSets(
-		renderer->logicalDevice,
-		&vertexUBODescriptorAllocateInfo,
-		&graphicsPipeline->vertexUBODescriptorSet
-	);
-
-	fragmentUBODescriptorAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-	fragmentUBODescriptorAllocateInfo.pNext = NULL;
-	fragmentUBODescriptorAllocateInfo.descriptorPool = renderer->defaultDescriptorPool;
-	fragmentUBODescriptorAllocateInfo.descriptorSetCount = 1;
-	fragmentUBODescriptorAllocateInfo.pSetLayouts = &renderer->fragmentParamLayout;
-
-	renderer->vkAllocateDescriptorSets(
-		renderer->logicalDevice,
-		&fragmentUBODescriptorAllocateInfo,
-		&graphicsPipeline->fragmentUBODescriptorSet
-	);
-
-	if (graphicsPipeline->vertexUBOBlockSize == 0)
-	{
-		vertexUniformBufferInfo.buffer = renderer->dummyVertexUniformBuffer->subBuffers[0]->buffer;
-		vertexUniformBufferInfo.offset = 0;
-		vertexUniformBufferInfo.range = renderer->dummyVertexUniformBuffer->subBuffers[0]->size;
-	}
-	else
-	{
-		vertexUniformBufferInfo.buffer = renderer->vertexUBO->subBuffers[0]->buffer;
-		vertexUniformBufferInfo.offset = 0;
-		vertexUniformBufferInfo.range = graphicsPipeline->vertexUBOBlockSize;
-	}
-
-	if (graphicsPipeline->fragmentUBOBlockSize == 0)
-	{
-		fragmentUniformBufferInfo.buffer = renderer->dummyFragmentUniformBuffer->subBuffers[0]->buffer;
-		fragmentUniformBufferInfo.offset = 0;
-		fragmentUniformBufferInfo.range = renderer->dummyFragmentUniformBuffer->subBuffers[0]->size;
-	}
-	else
-	{
-		fragmentUniformBufferInfo.buffer = renderer->fragmentUBO->subBuffers[0]->buffer;
-		fragmentUniformBufferInfo.offset = 0;
-		fragmentUniformBufferInfo.range = graphicsPipeline->fragmentUBOBlockSize;
-	}
-
-	uboWriteDescriptorSets[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-	uboWriteDescriptorSets[0].pNext = NULL;
-	uboWriteDescriptorSets[0].descriptorCount = 1;
-	uboWriteDescriptorSets[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
-	uboWriteDescriptorSets[0].dstArrayElement = 0;
-	uboWriteDescriptorSets[0].dstBinding = 0;
-	uboWriteDescriptorSets[0].dstSet = graphicsPipeline->vertexUBODescriptorSet;
-	uboWriteDescriptorSets[0].pBufferInfo = &vertexUniformBufferInfo;
-	uboWriteDescriptorSets[0].pImageInfo = NULL;
-	uboWriteDescriptorSets[0].pTexelBufferView = NULL;
-
-	uboWriteDescriptorSets[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-	uboWriteDescriptorSets[1].pNext = NULL;
-	uboWriteDescriptorSets[1].descriptorCount = 1;
-	uboWriteDescriptorSets[1].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
-	uboWriteDescriptorSets[1].dstArrayElement = 0;
-	uboWriteDescriptorSets[1].dstBinding = 0;
-	uboWriteDescriptorSets[1].dstSet = graphicsPipeline->fragmentUBODescriptorSet;
-	uboWriteDescriptorSets[1].pBufferInfo = &fragmentUniformBufferInfo;
-	uboWriteDescriptorSets[1].pImageInfo = NULL;
-	uboWriteDescriptorSets[1].pTexelBufferView = NULL;
-
-	renderer->vkUpdateDescriptorSets(
-		renderer->logicalDevice,
-		2,
-		uboWriteDescriptorSets,
-		0,
-		NULL
-	);
-
 	return (Refresh_GraphicsPipeline*) graphicsPipeline;
 }
 
 static VulkanComputePipelineLayout* VULKAN_INTERNAL_FetchComputePipelineLayout(
 	VulkanRenderer *renderer,
 	uint32_t bufferBindingCount,
-	uint32_t imageBindingCount
+	uint32_t imageBindingCount,
+	uint32_t pushConstantSize
 ) {
 	VkResult vulkanResult;
-	VkDescriptorSetLayout setLayouts[3];
+	VkDescriptorSetLayout setLayouts[4];
+	VkPushConstantRange pushConstantRange;
 	VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo;
 	ComputePipelineLayoutHash pipelineLayoutHash;
 	VulkanComputePipelineLayout *vulkanComputePipelineLayout;
 
+	if (!VULKAN_INTERNAL_ValidatePushConstantSizes(
+		renderer,
+		pushConstantSize,
+		0
+	)) {
+		return NULL;
+	}
+
 	pipelineLayoutHash.bufferLayout = VULKAN_INTERNAL_FetchDescriptorSetLayout(
 		renderer,
 		VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
@@ -5200,6 +7758,7 @@ static VulkanComputePipelineLayout* VULKAN_INTERNAL_FetchComputePipelineLayout(
 	);
 
 	pipelineLayoutHash.uniformLayout = renderer->computeParamLayout;
+	pipelineLayoutHash.pushConstantSize = pushConstantSize;
 
 	vulkanComputePipelineLayout = ComputePipelineLayoutHashArray_Fetch(
 		&renderer->computePipelineLayoutHashTable,
@@ -5216,14 +7775,19 @@ static VulkanComputePipelineLayout* VULKAN_INTERNAL_FetchComputePipelineLayout(
 	setLayouts[0] = pipelineLayoutHash.bufferLayout;
 	setLayouts[1] = pipelineLayoutHash.imageLayout;
 	setLayouts[2] = pipelineLayoutHash.uniformLayout;
+	setLayouts[3] = renderer->bindlessDescriptorSetLayout;
+
+	pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+	pushConstantRange.offset = 0;
+	pushConstantRange.size = pushConstantSize;
 
 	pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
 	pipelineLayoutCreateInfo.pNext = NULL;
 	pipelineLayoutCreateInfo.flags = 0;
-	pipelineLayoutCreateInfo.setLayoutCount = 3;
+	pipelineLayoutCreateInfo.setLayoutCount = renderer->supportsBindless ? 4 : 3;
 	pipelineLayoutCreateInfo.pSetLayouts = setLayouts;
-	pipelineLayoutCreateInfo.pushConstantRangeCount = 0;
-	pipelineLayoutCreateInfo.pPushConstantRanges = NULL;
+	pipelineLayoutCreateInfo.pushConstantRangeCount = pushConstantSize > 0 ? 1 : 0;
+	pipelineLayoutCreateInfo.pPushConstantRanges = pushConstantSize > 0 ? &pushConstantRange : NULL;
 
 	vulkanResult = renderer->vkCreatePipelineLayout(
 		renderer->logicalDevice,
@@ -5238,6 +7802,8 @@ static VulkanComputePipelineLayout* VULKAN_INTERNAL_FetchComputePipelineLayout(
 		return NULL;
 	}
 
+	vulkanComputePipelineLayout->pushConstantSize = pushConstantSize;
+
 	ComputePipelineLayoutHashArray_Insert(
 		&renderer->computePipelineLayoutHashTable,
 		pipelineLayoutHash,
@@ -5251,31 +7817,35 @@ static VulkanComputePipelineLayout* VULKAN_INTERNAL_FetchComputePipelineLayout(
 
 	if (bufferBindingCount == 0)
 	{
-		vulkanComputePipelineLayout->bufferDescriptorSetCache = NULL;
+		vulkanComputePipelineLayout->bufferDescriptorSetCacheInfo = NULL;
 	}
 	else
 	{
-		vulkanComputePipelineLayout->bufferDescriptorSetCache =
-			VULKAN_INTERNAL_CreateBufferDescriptorSetCache(
+		vulkanComputePipelineLayout->bufferDescriptorSetCacheInfo =
+			VULKAN_INTERNAL_CreateDescriptorSetCacheInfo(
 				renderer,
 				VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
 				pipelineLayoutHash.bufferLayout,
-				bufferBindingCount
+				bufferBindingCount,
+				sizeof(VkDescriptorBufferInfo),
+				&renderer->bufferDescriptorSetCacheInfoCount
 			);
 	}
 
 	if (imageBindingCount == 0)
 	{
-		vulkanComputePipelineLayout->imageDescriptorSetCache = NULL;
+		vulkanComputePipelineLayout->imageDescriptorSetCacheInfo = NULL;
 	}
 	else
 	{
-		vulkanComputePipelineLayout->imageDescriptorSetCache =
-			VULKAN_INTERNAL_CreateImageDescriptorSetCache(
+		vulkanComputePipelineLayout->imageDescriptorSetCacheInfo =
+			VULKAN_INTERNAL_CreateDescriptorSetCacheInfo(
 				renderer,
 				VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
 				pipelineLayoutHash.imageLayout,
-				imageBindingCount
+				imageBindingCount,
+				sizeof(VkDescriptorImageInfo),
+				&renderer->imageDescriptorSetCacheInfoCount
 			);
 	}
 
@@ -5289,10 +7859,6 @@ static Refresh_ComputePipeline* VULKAN_CreateComputePipeline(
 	VkComputePipelineCreateInfo computePipelineCreateInfo;
 	VkPipelineShaderStageCreateInfo pipelineShaderStageCreateInfo;
 
-	VkDescriptorSetAllocateInfo descriptorSetAllocateInfo;
-	VkDescriptorBufferInfo uniformBufferInfo;
-	VkWriteDescriptorSet writeDescriptorSet;
-
 	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
 	VulkanComputePipeline *vulkanComputePipeline = SDL_malloc(sizeof(VulkanComputePipeline));
 
@@ -5307,9 +7873,17 @@ static Refresh_ComputePipeline* VULKAN_CreateComputePipeline(
 	vulkanComputePipeline->pipelineLayout = VULKAN_INTERNAL_FetchComputePipelineLayout(
 		renderer,
 		pipelineCreateInfo->pipelineLayoutCreateInfo.bufferBindingCount,
-		pipelineCreateInfo->pipelineLayoutCreateInfo.imageBindingCount
+		pipelineCreateInfo->pipelineLayoutCreateInfo.imageBindingCount,
+		pipelineCreateInfo->pipelineLayoutCreateInfo.pushConstantSize
 	);
 
+	if (vulkanComputePipeline->pipelineLayout == NULL)
+	{
+		Refresh_LogError("Failed to create compute pipeline layout!");
+		SDL_free(vulkanComputePipeline);
+		return NULL;
+	}
+
 	computePipelineCreateInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
 	computePipelineCreateInfo.pNext = NULL;
 	computePipelineCreateInfo.flags = 0;
@@ -5334,50 +7908,6 @@ static Refresh_ComputePipeline* VULKAN_CreateComputePipeline(
 			renderer->minUBOAlignment
 		);
 
-	descriptorSetAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-	descriptorSetAllocateInfo.pNext = NULL;
-	descriptorSetAllocateInfo.descriptorPool = renderer->defaultDescriptorPool;
-	descriptorSetAllocateInfo.descriptorSetCount = 1;
-	descriptorSetAllocateInfo.pSetLayouts = &renderer->computeParamLayout;
-
-	renderer->vkAllocateDescriptorSets(
-		renderer->logicalDevice,
-		&descriptorSetAllocateInfo,
-		&vulkanComputePipeline->computeUBODescriptorSet
-	);
-
-	if (vulkanComputePipeline->computeUBOBlockSize == 0)
-	{
-		uniformBufferInfo.buffer = renderer->dummyComputeUniformBuffer->subBuffers[0]->buffer;
-		uniformBufferInfo.offset = 0;
-		uniformBufferInfo.range = renderer->dummyComputeUniformBuffer->subBuffers[0]->size;
-	}
-	else
-	{
-		uniformBufferInfo.buffer = renderer->computeUBO->subBuffers[0]->buffer;
-		uniformBufferInfo.offset = 0;
-		uniformBufferInfo.range = vulkanComputePipeline->computeUBOBlockSize;
-	}
-
-	writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-	writeDescriptorSet.pNext = NULL;
-	writeDescriptorSet.descriptorCount = 1;
-	writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
-	writeDescriptorSet.dstArrayElement = 0;
-	writeDescriptorSet.dstBinding = 0;
-	writeDescriptorSet.dstSet = vulkanComputePipeline->computeUBODescriptorSet;
-	writeDescriptorSet.pBufferInfo = &uniformBufferInfo;
-	writeDescriptorSet.pImageInfo = NULL;
-	writeDescriptorSet.pTexelBufferView = NULL;
-
-	renderer->vkUpdateDescriptorSets(
-		renderer->logicalDevice,
-		1,
-		&writeDescriptorSet,
-		0,
-		NULL
-	);
-
 	return (Refresh_ComputePipeline*) vulkanComputePipeline;
 }
 
@@ -5439,6 +7969,11 @@ static Refresh_Sampler* VULKAN_CreateSampler(
 		return NULL;
 	}
 
+	if (renderer->supportsBindless)
+	{
+		VULKAN_INTERNAL_AddBindlessSampler(renderer, sampler);
+	}
+
 	return (Refresh_Sampler*) sampler;
 }
 
@@ -5576,6 +8111,10 @@ static uint8_t VULKAN_INTERNAL_CreateTexture(
 
 	texture->isCube = 0;
 	texture->is3D = 0;
+	texture->bindlessIndex = REFRESH_BINDLESS_INDEX_NONE;
+	SDL_AtomicSet(&texture->recordingRefs, 0);
+	texture->lastRecordingCommandBuffer = NULL;
+	texture->handlesExported = 0;
 
 	if (isCube)
 	{
@@ -5625,6 +8164,7 @@ static uint8_t VULKAN_INTERNAL_CreateTexture(
 		texture->image,
 		0,
 		&texture->allocation,
+		&texture->usedRegion,
 		&texture->offset,
 		&texture->memorySize
 	);
@@ -5645,6 +8185,7 @@ static uint8_t VULKAN_INTERNAL_CreateTexture(
 			texture->image,
 			1,
 			&texture->allocation,
+			&texture->usedRegion,
 			&texture->offset,
 			&texture->memorySize
 		);
@@ -5795,6 +8336,25 @@ static Refresh_Texture* VULKAN_CreateTexture(
 		result
 	);
 
+	if (	renderer->supportsBindless &&
+		(imageUsageFlags & VK_IMAGE_USAGE_SAMPLED_BIT)	)
+	{
+		VULKAN_INTERNAL_AddBindlessTexture(renderer, result);
+	}
+
+	/* Render targets and the bindless array keep views of the image,
+	 * so only plain textures may move
+	 */
+	if (	result->usedRegion != NULL &&
+		result->bindlessIndex == REFRESH_BINDLESS_INDEX_NONE &&
+		!(imageUsageFlags & VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT) &&
+		!(imageUsageFlags & VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT)	)
+	{
+		SDL_LockMutex(renderer->allocatorLock);
+		result->usedRegion->texture = result;
+		SDL_UnlockMutex(renderer->allocatorLock);
+	}
+
 	return (Refresh_Texture*) result;
 }
 
@@ -5900,7 +8460,10 @@ static Refresh_Buffer* VULKAN_CreateBuffer(
 	Refresh_BufferUsageFlags usageFlags,
 	uint32_t sizeInBytes
 ) {
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
 	VulkanBuffer *buffer = (VulkanBuffer*) SDL_malloc(sizeof(VulkanBuffer));
+	VulkanBufferMemoryUsage memoryUsage;
+	uint32_t i;
 
 	VkBufferUsageFlags vulkanUsageFlags =
 		VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
@@ -5920,18 +8483,70 @@ static Refresh_Buffer* VULKAN_CreateBuffer(
 		vulkanUsageFlags |= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
 	}
 
+	if (usageFlags & REFRESH_BUFFERUSAGE_INDIRECT_BIT)
+	{
+		vulkanUsageFlags |= VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
+	}
+
+	if (usageFlags & REFRESH_BUFFERUSAGE_STATIC_BIT)
+	{
+		memoryUsage = VULKAN_BUFFER_MEMORY_DEVICE;
+	}
+	else if (usageFlags & REFRESH_BUFFERUSAGE_READBACK_BIT)
+	{
+		memoryUsage = VULKAN_BUFFER_MEMORY_READBACK;
+	}
+	else
+	{
+		memoryUsage = VULKAN_BUFFER_MEMORY_HOST;
+	}
+
+	/* Small dynamic buffers share arenas instead of owning a VkBuffer each */
+	if (	memoryUsage == VULKAN_BUFFER_MEMORY_HOST &&
+		sizeInBytes <= BUFFER_ARENA_MAX_SUBALLOCATION_SIZE	)
+	{
+		if (!VULKAN_INTERNAL_CreateArenaBuffer(
+			renderer,
+			sizeInBytes,
+			RESOURCE_ACCESS_VERTEX_BUFFER,
+			vulkanUsageFlags,
+			renderer->framesInFlight,
+			buffer
+		)) {
+			Refresh_LogError("Failed to create vertex buffer!");
+			return NULL;
+		}
+
+		return (Refresh_Buffer*) buffer;
+	}
+
+	/* Uploads to static buffers are ordered on the GPU, no need to cycle */
 	if(!VULKAN_INTERNAL_CreateBuffer(
-		(VulkanRenderer*) driverData,
+		renderer,
 		sizeInBytes,
 		RESOURCE_ACCESS_VERTEX_BUFFER,
 		vulkanUsageFlags,
-		SUB_BUFFER_COUNT,
+		(memoryUsage == VULKAN_BUFFER_MEMORY_DEVICE) ? 1 : renderer->framesInFlight,
+		memoryUsage,
 		buffer
 	)) {
 		Refresh_LogError("Failed to create vertex buffer!");
 		return NULL;
 	}
 
+	SDL_LockMutex(renderer->allocatorLock);
+
+	for (i = 0; i < buffer->subBufferCount; i += 1)
+	{
+		if (buffer->subBuffers[i]->usedRegion != NULL)
+		{
+			buffer->subBuffers[i]->usedRegion->buffer = buffer;
+			buffer->subBuffers[i]->usedRegion->subBufferIndex = i;
+		}
+	}
+
+	SDL_UnlockMutex(renderer->allocatorLock);
+
 	return (Refresh_Buffer*) buffer;
 }
 
@@ -5941,9 +8556,9 @@ static void VULKAN_INTERNAL_MaybeExpandStagingBuffer(
 	VulkanRenderer *renderer,
 	VkDeviceSize textureSize
 ) {
-	VkDeviceSize nextStagingSize = renderer->textureStagingBuffer->size;
+	VkDeviceSize nextStagingSize = renderer->textureStagingBuffers[renderer->frameIndex]->size;
 
-	if (renderer->textureStagingBufferOffset + textureSize <= renderer->textureStagingBuffer->size)
+	if (renderer->textureStagingBufferOffset + textureSize <= renderer->textureStagingBuffers[renderer->frameIndex]->size)
 	{
 		return;
 	}
@@ -5957,9 +8572,9 @@ static void VULKAN_INTERNAL_MaybeExpandStagingBuffer(
 	}
 
 	/* double staging buffer size up to max */
-	VULKAN_INTERNAL_DestroyTextureStagingBuffer(renderer);
+	VULKAN_INTERNAL_DestroyTextureStagingBuffer(renderer, renderer->frameIndex);
 
-	renderer->textureStagingBuffer = (VulkanBuffer*) SDL_malloc(sizeof(VulkanBuffer));
+	renderer->textureStagingBuffers[renderer->frameIndex] = (VulkanBuffer*) SDL_malloc(sizeof(VulkanBuffer));
 
 	if (!VULKAN_INTERNAL_CreateBuffer(
 		renderer,
@@ -5967,7 +8582,8 @@ static void VULKAN_INTERNAL_MaybeExpandStagingBuffer(
 		RESOURCE_ACCESS_MEMORY_TRANSFER_READ_WRITE,
 		VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
 		1,
-		renderer->textureStagingBuffer
+		VULKAN_BUFFER_MEMORY_HOST,
+		renderer->textureStagingBuffers[renderer->frameIndex]
 	)) {
 		Refresh_LogError("Failed to expand texture staging buffer!");
 		return;
@@ -6028,25 +8644,11 @@ static void VULKAN_INTERNAL_FlushTransfers(
 		transferSubmitInfo.pSignalSemaphores = NULL;
 		transferSubmitInfo.signalSemaphoreCount = 0;
 
-		/* Wait for the previous submission to complete */
-		vulkanResult = renderer->vkWaitForFences(
-			renderer->logicalDevice,
-			1,
-			&renderer->inFlightFence,
-			VK_TRUE,
-			UINT64_MAX
-		);
-
-		if (vulkanResult != VK_SUCCESS)
-		{
-			LogVulkanResultAsError("vkWaitForFences", vulkanResult);
-			return;
-		}
-
+		/* The current frame's fence was waited on when the frame began */
 		renderer->vkResetFences(
 			renderer->logicalDevice,
 			1,
-			&renderer->inFlightFence
+			&renderer->inFlightFences[renderer->frameIndex]
 		);
 
 		/* Submit transfers */
@@ -6054,7 +8656,7 @@ static void VULKAN_INTERNAL_FlushTransfers(
 			renderer->transferQueue,
 			1,
 			&transferSubmitInfo,
-			renderer->inFlightFence
+			renderer->inFlightFences[renderer->frameIndex]
 		);
 
 		if (vulkanResult != VK_SUCCESS)
@@ -6063,11 +8665,11 @@ static void VULKAN_INTERNAL_FlushTransfers(
 			return;
 		}
 
-		/* Wait again */
+		/* Wait for the transfer, leaving the fence signaled */
 		vulkanResult = renderer->vkWaitForFences(
 			renderer->logicalDevice,
 			1,
-			&renderer->inFlightFence,
+			&renderer->inFlightFences[renderer->frameIndex],
 			VK_TRUE,
 			UINT64_MAX
 		);
@@ -6109,8 +8711,8 @@ static void VULKAN_SetTextureData(
 	VULKAN_INTERNAL_MaybeBeginTransferCommandBuffer(renderer);
 
 	stagingBufferPointer =
-		renderer->textureStagingBuffer->subBuffers[0]->allocation->mapPointer +
-		renderer->textureStagingBuffer->subBuffers[0]->offset +
+		renderer->textureStagingBuffers[renderer->frameIndex]->subBuffers[0]->allocation->mapPointer +
+		renderer->textureStagingBuffers[renderer->frameIndex]->subBuffers[0]->offset +
 		renderer->textureStagingBufferOffset;
 
 	SDL_memcpy(
@@ -6149,7 +8751,7 @@ static void VULKAN_SetTextureData(
 
 	renderer->vkCmdCopyBufferToImage(
 		commandBuffer,
-		renderer->textureStagingBuffer->subBuffers[0]->buffer,
+		renderer->textureStagingBuffers[renderer->frameIndex]->subBuffers[0]->buffer,
 		vulkanTexture->image,
 		AccessMap[vulkanTexture->resourceAccessType].imageLayout,
 		1,
@@ -6209,8 +8811,8 @@ static void VULKAN_SetTextureDataYUV(
 	VULKAN_INTERNAL_MaybeBeginTransferCommandBuffer(renderer);
 
 	stagingBufferPointer =
-		renderer->textureStagingBuffer->subBuffers[0]->allocation->mapPointer +
-		renderer->textureStagingBuffer->subBuffers[0]->offset +
+		renderer->textureStagingBuffers[renderer->frameIndex]->subBuffers[0]->allocation->mapPointer +
+		renderer->textureStagingBuffers[renderer->frameIndex]->subBuffers[0]->offset +
 		renderer->textureStagingBufferOffset;
 
 	/* Initialize values that are the same for Y, U, and V */
@@ -6257,7 +8859,7 @@ static void VULKAN_SetTextureDataYUV(
 
 	renderer->vkCmdCopyBufferToImage(
 		commandBuffer,
-		renderer->textureStagingBuffer->subBuffers[0]->buffer,
+		renderer->textureStagingBuffers[renderer->frameIndex]->subBuffers[0]->buffer,
 		tex->image,
 		AccessMap[tex->resourceAccessType].imageLayout,
 		1,
@@ -6299,7 +8901,7 @@ static void VULKAN_SetTextureDataYUV(
 
 	renderer->vkCmdCopyBufferToImage(
 		commandBuffer,
-		renderer->textureStagingBuffer->subBuffers[0]->buffer,
+		renderer->textureStagingBuffers[renderer->frameIndex]->subBuffers[0]->buffer,
 		tex->image,
 		AccessMap[tex->resourceAccessType].imageLayout,
 		1,
@@ -6334,7 +8936,7 @@ static void VULKAN_SetTextureDataYUV(
 
 	renderer->vkCmdCopyBufferToImage(
 		commandBuffer,
-		renderer->textureStagingBuffer->subBuffers[0]->buffer,
+		renderer->textureStagingBuffers[renderer->frameIndex]->subBuffers[0]->buffer,
 		tex->image,
 		AccessMap[tex->resourceAccessType].imageLayout,
 		1,
@@ -6488,6 +9090,9 @@ REFRESHAPI void VULKAN_CopyTextureToTexture(
 	VulkanTexture *sourceTexture = (VulkanTexture*) sourceTextureSlice->texture;
 	VulkanTexture *destinationTexture = (VulkanTexture*) destinationTextureSlice->texture;
 
+	VULKAN_INTERNAL_TrackTexture(renderer, vulkanCommandBuffer, sourceTexture);
+	VULKAN_INTERNAL_TrackTexture(renderer, vulkanCommandBuffer, destinationTexture);
+
 	VULKAN_INTERNAL_BlitImage(
 		renderer,
 		vulkanCommandBuffer->commandBuffer,
@@ -6509,1633 +9114,4282 @@ REFRESHAPI void VULKAN_CopyTextureToTexture(
 	);
 }
 
-static void VULKAN_SetBufferData(
-	Refresh_Renderer *driverData,
-	Refresh_Buffer *buffer,
-	uint32_t offsetInBytes,
-	void* data,
-	uint32_t dataLength
+/* Static buffers are only ever written through the transfer command buffer,
+ * which is submitted ahead of the frame's graphics work.
+ */
+static void VULKAN_INTERNAL_StageBufferData(
+	VulkanRenderer *renderer,
+	VulkanBuffer *buffer,
+	VkDeviceSize offsetInBytes,
+	void *data,
+	VkDeviceSize dataLength
 ) {
-	VulkanRenderer* renderer = (VulkanRenderer*)driverData;
-	VulkanBuffer* vulkanBuffer = (VulkanBuffer*)buffer;
-	uint32_t i;
+	VkCommandBuffer commandBuffer;
+	VkBufferCopy bufferCopy;
+	uint8_t *stagingBufferPointer;
 
-	#define CURIDX vulkanBuffer->currentSubBufferIndex
-	#define SUBBUF vulkanBuffer->subBuffers[CURIDX]
+	SDL_LockMutex(renderer->stagingLock);
 
-	/* If buffer has not been bound this frame, set the first unbound index */
-	if (!vulkanBuffer->bound)
-	{
-		for (i = 0; i < vulkanBuffer->subBufferCount; i += 1)
-		{
-			if (vulkanBuffer->subBuffers[i]->bound == -1)
-			{
-				break;
-			}
-		}
-		CURIDX = i;
-	}
-	else
-	{
-		Refresh_LogError("Buffer already bound. It is an error to set vertex data after binding but before submitting.");
-		return;
-	}
+	VULKAN_INTERNAL_MaybeExpandStagingBuffer(renderer, dataLength);
+	VULKAN_INTERNAL_MaybeBeginTransferCommandBuffer(renderer);
+
+	commandBuffer = renderer->transferCommandBuffers[renderer->frameIndex];
+
+	stagingBufferPointer =
+		renderer->textureStagingBuffers[renderer->frameIndex]->subBuffers[0]->allocation->mapPointer +
+		renderer->textureStagingBuffers[renderer->frameIndex]->subBuffers[0]->offset +
+		renderer->textureStagingBufferOffset;
 
 	SDL_memcpy(
-		SUBBUF->allocation->mapPointer + SUBBUF->offset + offsetInBytes,
+		stagingBufferPointer,
 		data,
 		dataLength
 	);
 
-	#undef CURIDX
-	#undef SUBBUF
-}
-
-static uint32_t VULKAN_PushVertexShaderUniforms(
-	Refresh_Renderer *driverData,
-	Refresh_GraphicsPipeline *pipeline,
-	void *data,
-	uint32_t dataLengthInBytes
-) {
-	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
-	VulkanGraphicsPipeline* graphicsPipeline = (VulkanGraphicsPipeline*) pipeline;
-
-	SDL_LockMutex(renderer->uniformBufferLock);
+	VULKAN_INTERNAL_BufferMemoryBarrier(
+		renderer,
+		commandBuffer,
+		RESOURCE_ACCESS_TRANSFER_WRITE,
+		buffer,
+		buffer->subBuffers[0]
+	);
 
-	renderer->vertexUBOOffset += renderer->vertexUBOBlockIncrement;
-	renderer->vertexUBOBlockIncrement = graphicsPipeline->vertexUBOBlockSize;
+	bufferCopy.srcOffset = renderer->textureStagingBufferOffset;
+	bufferCopy.dstOffset = buffer->subBuffers[0]->bufferOffset + offsetInBytes;
+	bufferCopy.size = dataLength;
 
-	if (
-		renderer->vertexUBOOffset +
-		graphicsPipeline->vertexUBOBlockSize >=
-		UBO_BUFFER_SIZE * (renderer->frameIndex + 1)
-	) {
-		Refresh_LogError("Vertex UBO overflow!");
-		return 0;
-	}
+	renderer->vkCmdCopyBuffer(
+		commandBuffer,
+		renderer->textureStagingBuffers[renderer->frameIndex]->subBuffers[0]->buffer,
+		buffer->subBuffers[0]->buffer,
+		1,
+		&bufferCopy
+	);
 
-	VULKAN_SetBufferData(
-		(Refresh_Renderer*) renderer,
-		(Refresh_Buffer*) renderer->vertexUBO,
-		renderer->vertexUBOOffset,
-		data,
-		dataLengthInBytes
+	/* Keep texture copies that follow aligned to the texel block size */
+	renderer->textureStagingBufferOffset = VULKAN_INTERNAL_NextHighestAlignment(
+		renderer->textureStagingBufferOffset + dataLength,
+		16
 	);
 
-	SDL_UnlockMutex(renderer->uniformBufferLock);
+	VULKAN_INTERNAL_BufferReadBarrier(
+		renderer,
+		commandBuffer,
+		buffer,
+		buffer->subBuffers[0]
+	);
 
-	return renderer->vertexUBOOffset;
+	SDL_UnlockMutex(renderer->stagingLock);
 }
 
-static uint32_t VULKAN_PushFragmentShaderUniforms(
-	Refresh_Renderer *driverData,
-	Refresh_GraphicsPipeline *pipeline,
-	void *data,
-	uint32_t dataLengthInBytes
+/* Picks the sub-buffer that a host write with the given options goes to */
+static uint8_t VULKAN_INTERNAL_PrepareBufferWrite(
+	VulkanRenderer *renderer,
+	VulkanBuffer *buffer,
+	Refresh_SetDataOptions options
 ) {
-	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
-	VulkanGraphicsPipeline* graphicsPipeline = (VulkanGraphicsPipeline*) pipeline;
+	int32_t i;
 
-	SDL_LockMutex(renderer->uniformBufferLock);
-
-	renderer->fragmentUBOOffset += renderer->fragmentUBOBlockIncrement;
-	renderer->fragmentUBOBlockIncrement = graphicsPipeline->fragmentUBOBlockSize;
+	/* The client promises not to touch anything the GPU might be reading */
+	if (options == REFRESH_SETDATAOPTIONS_NOOVERWRITE)
+	{
+		return 1;
+	}
 
-	if (
-		renderer->fragmentUBOOffset +
-		graphicsPipeline->fragmentUBOBlockSize >=
-		UBO_BUFFER_SIZE * (renderer->frameIndex + 1)
-	) {
-		Refresh_LogError("Fragment UBO overflow!");
-		return 0;
+	/* Rename to the first sub-buffer the GPU is done with */
+	for (i = 0; i < (int32_t) buffer->subBufferCount; i += 1)
+	{
+		if (buffer->subBuffers[i]->bound == -1)
+		{
+			break;
+		}
 	}
 
-	VULKAN_SetBufferData(
-		(Refresh_Renderer*) renderer,
-		(Refresh_Buffer*) renderer->fragmentUBO,
-		renderer->fragmentUBOOffset,
-		data,
-		dataLengthInBytes
-	);
+	/* Every sub-buffer is in flight, grow the pool */
+	if (i == (int32_t) buffer->subBufferCount)
+	{
+		i = VULKAN_INTERNAL_AddSubBuffer(renderer, buffer);
 
-	SDL_UnlockMutex(renderer->uniformBufferLock);
+		if (i == -1)
+		{
+			Refresh_LogError("Failed to grow buffer sub-buffer pool!");
+			return 0;
+		}
+	}
 
-	return renderer->fragmentUBOOffset;
+	buffer->currentSubBufferIndex = i;
+	return 1;
 }
 
-static uint32_t VULKAN_PushComputeShaderUniforms(
+static void VULKAN_SetBufferDataWithOptions(
 	Refresh_Renderer *driverData,
-	Refresh_ComputePipeline *pipeline,
-	void *data,
-	uint32_t dataLengthInBytes
+	Refresh_Buffer *buffer,
+	uint32_t offsetInBytes,
+	void* data,
+	uint32_t dataLength,
+	Refresh_SetDataOptions options
 ) {
-	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
-	VulkanComputePipeline* computePipeline = (VulkanComputePipeline*) pipeline;
+	VulkanRenderer* renderer = (VulkanRenderer*)driverData;
+	VulkanBuffer* vulkanBuffer = (VulkanBuffer*)buffer;
 
-	SDL_LockMutex(renderer->uniformBufferLock);
+	#define CURIDX vulkanBuffer->currentSubBufferIndex
+	#define SUBBUF vulkanBuffer->subBuffers[CURIDX]
 
-	renderer->computeUBOOffset += renderer->computeUBOBlockIncrement;
-	renderer->computeUBOBlockIncrement = computePipeline->computeUBOBlockSize;
+	if (vulkanBuffer->bound && options == REFRESH_SETDATAOPTIONS_NONE)
+	{
+		Refresh_LogError("Buffer already bound. It is an error to set vertex data after binding but before submitting.");
+		return;
+	}
 
-	if (
-		renderer->computeUBOOffset +
-		computePipeline->computeUBOBlockSize >=
-		UBO_BUFFER_SIZE * (renderer->frameIndex + 1)
-	) {
-		Refresh_LogError("Compute UBO overflow!");
-		return 0;
+	if (vulkanBuffer->memoryUsage == VULKAN_BUFFER_MEMORY_DEVICE)
+	{
+		/* Staged copies run before all of this frame's draws, so a bound
+		 * static buffer can't be renamed, only appended to.
+		 */
+		if (vulkanBuffer->bound && options != REFRESH_SETDATAOPTIONS_NOOVERWRITE)
+		{
+			Refresh_LogError("Static buffers can only be set with NOOVERWRITE after binding but before submitting.");
+			return;
+		}
+
+		VULKAN_INTERNAL_StageBufferData(
+			renderer,
+			vulkanBuffer,
+			offsetInBytes,
+			data,
+			dataLength
+		);
+		return;
 	}
 
-	VULKAN_SetBufferData(
-		(Refresh_Renderer*) renderer,
-		(Refresh_Buffer*) renderer->computeUBO,
-		renderer->computeUBOOffset,
+	if (!VULKAN_INTERNAL_PrepareBufferWrite(renderer, vulkanBuffer, options))
+	{
+		return;
+	}
+
+	SDL_memcpy(
+		SUBBUF->allocation->mapPointer + SUBBUF->offset + offsetInBytes,
 		data,
-		dataLengthInBytes
+		dataLength
 	);
 
-	SDL_UnlockMutex(renderer->uniformBufferLock);
+	VULKAN_INTERNAL_FlushSubBuffer(
+		renderer,
+		SUBBUF,
+		offsetInBytes,
+		dataLength
+	);
 
-	return renderer->computeUBOOffset;
+	#undef CURIDX
+	#undef SUBBUF
 }
 
-static inline uint8_t BufferDescriptorSetDataEqual(
-	BufferDescriptorSetData *a,
-	BufferDescriptorSetData *b,
-	uint8_t bindingCount
+static void VULKAN_SetBufferData(
+	Refresh_Renderer *driverData,
+	Refresh_Buffer *buffer,
+	uint32_t offsetInBytes,
+	void* data,
+	uint32_t dataLength
 ) {
-	uint32_t i;
-
-	for (i = 0; i < bindingCount; i += 1)
-	{
-		if (	a->descriptorBufferInfo[i].buffer != b->descriptorBufferInfo[i].buffer ||
-			a->descriptorBufferInfo[i].offset != b->descriptorBufferInfo[i].offset ||
-			a->descriptorBufferInfo[i].range != b->descriptorBufferInfo[i].range	)
-		{
-			return 0;
-		}
-	}
-
-	return 1;
+	VULKAN_SetBufferDataWithOptions(
+		driverData,
+		buffer,
+		offsetInBytes,
+		data,
+		dataLength,
+		REFRESH_SETDATAOPTIONS_NONE
+	);
 }
 
-/* FIXME: this can probably be cleverly folded into the same cache structure as image descriptors */
-static VkDescriptorSet VULKAN_INTERNAL_FetchBufferDescriptorSet(
-	VulkanRenderer *renderer,
-	BufferDescriptorSetCache *bufferDescriptorSetCache,
-	BufferDescriptorSetData *bufferDescriptorSetData
+static void* VULKAN_MapBuffer(
+	Refresh_Renderer *driverData,
+	Refresh_Buffer *buffer,
+	Refresh_SetDataOptions options
 ) {
-	uint32_t i;
-	uint64_t hashcode;
-	BufferDescriptorSetHashArray *arr;
-	VkDescriptorSet newDescriptorSet;
-	VkWriteDescriptorSet writeDescriptorSets[MAX_BUFFER_BINDINGS];
-	BufferDescriptorSetHashMap *map;
-
-	hashcode = BufferDescriptorSetHashTable_GetHashCode(
-		bufferDescriptorSetData,
-		bufferDescriptorSetCache->bindingCount
-	);
-	arr = &bufferDescriptorSetCache->buckets[hashcode % NUM_DESCRIPTOR_SET_HASH_BUCKETS];
+	VulkanRenderer* renderer = (VulkanRenderer*)driverData;
+	VulkanBuffer* vulkanBuffer = (VulkanBuffer*)buffer;
+	VulkanSubBuffer *subBuffer;
 
-	for (i = 0; i < arr->count; i += 1)
+	if (vulkanBuffer->memoryUsage == VULKAN_BUFFER_MEMORY_DEVICE)
 	{
-		BufferDescriptorSetHashMap *e = &bufferDescriptorSetCache->elements[arr->elements[i]];
-		if (BufferDescriptorSetDataEqual(
-			bufferDescriptorSetData,
-			&e->descriptorSetData,
-			bufferDescriptorSetCache->bindingCount
-		)) {
-			e->inactiveFrameCount = 0;
-			return e->descriptorSet;
-		}
+		Refresh_LogError("Static buffers can't be mapped!");
+		return NULL;
 	}
 
-	/* If no match exists, assign a new descriptor set and prepare it for update */
-	/* If no inactive descriptor sets remain, create a new pool and allocate new inactive sets */
-
-	if (bufferDescriptorSetCache->inactiveDescriptorSetCount == 0)
+	if (vulkanBuffer->mapped)
 	{
-		bufferDescriptorSetCache->bufferDescriptorPoolCount += 1;
-		bufferDescriptorSetCache->bufferDescriptorPools = SDL_realloc(
-			bufferDescriptorSetCache->bufferDescriptorPools,
-			sizeof(VkDescriptorPool) * bufferDescriptorSetCache->bufferDescriptorPoolCount
-		);
-
-		VULKAN_INTERNAL_CreateDescriptorPool(
-			renderer,
-			VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-			bufferDescriptorSetCache->nextPoolSize,
-			bufferDescriptorSetCache->nextPoolSize * bufferDescriptorSetCache->bindingCount,
-			&bufferDescriptorSetCache->bufferDescriptorPools[bufferDescriptorSetCache->bufferDescriptorPoolCount - 1]
-		);
-
-		bufferDescriptorSetCache->inactiveDescriptorSetCapacity += bufferDescriptorSetCache->nextPoolSize;
+		Refresh_LogError("Buffer is already mapped!");
+		return NULL;
+	}
 
-		bufferDescriptorSetCache->inactiveDescriptorSets = SDL_realloc(
-			bufferDescriptorSetCache->inactiveDescriptorSets,
-			sizeof(VkDescriptorSet) * bufferDescriptorSetCache->inactiveDescriptorSetCapacity
-		);
+	if (vulkanBuffer->bound && options == REFRESH_SETDATAOPTIONS_NONE)
+	{
+		Refresh_LogError("Buffer already bound. It is an error to map a buffer after binding but before submitting.");
+		return NULL;
+	}
 
-		VULKAN_INTERNAL_AllocateDescriptorSets(
-			renderer,
-			bufferDescriptorSetCache->bufferDescriptorPools[bufferDescriptorSetCache->bufferDescriptorPoolCount - 1],
-			bufferDescriptorSetCache->descriptorSetLayout,
-			bufferDescriptorSetCache->nextPoolSize,
-			bufferDescriptorSetCache->inactiveDescriptorSets
-		);
+	if (!VULKAN_INTERNAL_PrepareBufferWrite(renderer, vulkanBuffer, options))
+	{
+		return NULL;
+	}
 
-		bufferDescriptorSetCache->inactiveDescriptorSetCount = bufferDescriptorSetCache->nextPoolSize;
+	vulkanBuffer->mapped = 1;
 
-		bufferDescriptorSetCache->nextPoolSize *= 2;
-	}
+	subBuffer = vulkanBuffer->subBuffers[vulkanBuffer->currentSubBufferIndex];
+	return subBuffer->allocation->mapPointer + subBuffer->offset;
+}
 
-	newDescriptorSet = bufferDescriptorSetCache->inactiveDescriptorSets[bufferDescriptorSetCache->inactiveDescriptorSetCount - 1];
-	bufferDescriptorSetCache->inactiveDescriptorSetCount -= 1;
+static void VULKAN_UnmapBuffer(
+	Refresh_Renderer *driverData,
+	Refresh_Buffer *buffer
+) {
+	VulkanRenderer* renderer = (VulkanRenderer*)driverData;
+	VulkanBuffer* vulkanBuffer = (VulkanBuffer*)buffer;
 
-	for (i = 0; i < bufferDescriptorSetCache->bindingCount; i += 1)
+	if (!vulkanBuffer->mapped)
 	{
-		writeDescriptorSets[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-		writeDescriptorSets[i].pNext = NULL;
-		writeDescriptorSets[i].descriptorCount = 1;
-		writeDescriptorSets[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-		writeDescriptorSets[i].dstArrayElement = 0;
-		writeDescriptorSets[i].dstBinding = i;
-		writeDescriptorSets[i].dstSet = newDescriptorSet;
-		writeDescriptorSets[i].pBufferInfo = &bufferDescriptorSetData->descriptorBufferInfo[i];
-		writeDescriptorSets[i].pImageInfo = NULL;
-		writeDescriptorSets[i].pTexelBufferView = NULL;
+		Refresh_LogError("Buffer is not mapped!");
+		return;
 	}
 
-	renderer->vkUpdateDescriptorSets(
-		renderer->logicalDevice,
-		bufferDescriptorSetCache->bindingCount,
-		writeDescriptorSets,
+	/* We don't know what the client touched, so flush all of it */
+	VULKAN_INTERNAL_FlushSubBuffer(
+		renderer,
+		vulkanBuffer->subBuffers[vulkanBuffer->currentSubBufferIndex],
 		0,
-		NULL
+		vulkanBuffer->size
 	);
 
-	EXPAND_ELEMENTS_IF_NEEDED(arr, 2, uint32_t)
-	arr->elements[arr->count] = bufferDescriptorSetCache->count;
-	arr->count += 1;
+	vulkanBuffer->mapped = 0;
+}
 
-	if (bufferDescriptorSetCache->count == bufferDescriptorSetCache->capacity)
-	{
-		bufferDescriptorSetCache->capacity *= 2;
+/* Uniform Buffers */
 
-		bufferDescriptorSetCache->elements = SDL_realloc(
-			bufferDescriptorSetCache->elements,
-			sizeof(BufferDescriptorSetHashMap) * bufferDescriptorSetCache->capacity
-		);
-	}
+static VulkanUniformBlock* VULKAN_INTERNAL_CreateUniformBlock(
+	VulkanRenderer *renderer,
+	VulkanUniformBufferPool *pool
+) {
+	VulkanUniformBlock *block = SDL_malloc(sizeof(VulkanUniformBlock));
 
-	map = &bufferDescriptorSetCache->elements[bufferDescriptorSetCache->count];
-	map->key = hashcode;
+	block->buffer = SDL_malloc(sizeof(VulkanBuffer));
 
-	for (i = 0; i < bufferDescriptorSetCache->bindingCount; i += 1)
-	{
-		map->descriptorSetData.descriptorBufferInfo[i].buffer =
-			bufferDescriptorSetData->descriptorBufferInfo[i].buffer;
-		map->descriptorSetData.descriptorBufferInfo[i].offset =
-			bufferDescriptorSetData->descriptorBufferInfo[i].offset;
-		map->descriptorSetData.descriptorBufferInfo[i].range =
-			bufferDescriptorSetData->descriptorBufferInfo[i].range;
+	if (!VULKAN_INTERNAL_CreateBuffer(
+		renderer,
+		UBO_BUFFER_SIZE,
+		pool->resourceAccessType,
+		VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+		1,
+		VULKAN_BUFFER_MEMORY_HOST,
+		block->buffer
+	)) {
+		Refresh_LogError("Failed to create uniform buffer block!");
+		SDL_free(block->buffer);
+		SDL_free(block);
+		return NULL;
 	}
 
-	map->descriptorSet = newDescriptorSet;
-	map->inactiveFrameCount = 0;
-	bufferDescriptorSetCache->count += 1;
+	block->descriptorSets = NULL;
+	block->descriptorSetCount = 0;
+	block->descriptorSetCapacity = 0;
 
-	return newDescriptorSet;
+	return block;
 }
 
-static inline uint8_t ImageDescriptorSetDataEqual(
-	ImageDescriptorSetData *a,
-	ImageDescriptorSetData *b,
-	uint8_t bindingCount
+static void VULKAN_INTERNAL_DestroyUniformBlock(
+	VulkanRenderer *renderer,
+	VulkanUniformBufferPool *pool,
+	VulkanUniformBlock *block
 ) {
 	uint32_t i;
 
-	for (i = 0; i < bindingCount; i += 1)
+	EXPAND_ARRAY_IF_NEEDED(
+		pool->inactiveDescriptorSets,
+		VkDescriptorSet,
+		pool->inactiveDescriptorSetCount + block->descriptorSetCount,
+		pool->inactiveDescriptorSetCapacity,
+		pool->inactiveDescriptorSetCount + block->descriptorSetCount
+	);
+
+	for (i = 0; i < block->descriptorSetCount; i += 1)
 	{
-		if (	a->descriptorImageInfo[i].imageLayout != b->descriptorImageInfo[i].imageLayout ||
-			a->descriptorImageInfo[i].imageView != b->descriptorImageInfo[i].imageView ||
-			a->descriptorImageInfo[i].sampler != b->descriptorImageInfo[i].sampler	)
-		{
-			return 0;
-		}
+		pool->inactiveDescriptorSets[pool->inactiveDescriptorSetCount] =
+			block->descriptorSets[i].descriptorSet;
+		pool->inactiveDescriptorSetCount += 1;
 	}
 
-	return 1;
+	VULKAN_INTERNAL_DestroyBuffer(renderer, block->buffer);
+	SDL_free(block->descriptorSets);
+	SDL_free(block);
 }
 
-static VkDescriptorSet VULKAN_INTERNAL_FetchImageDescriptorSet(
+/* Must be called with uniformBufferLock held.
+ * Takes an inactive set, adding a pool twice the size of the last when
+ * none are left.
+ */
+static VkDescriptorSet VULKAN_INTERNAL_AcquireUniformDescriptorSet(
 	VulkanRenderer *renderer,
-	ImageDescriptorSetCache *imageDescriptorSetCache,
-	ImageDescriptorSetData *imageDescriptorSetData
+	VulkanUniformBufferPool *pool
 ) {
-	uint32_t i;
-	uint64_t hashcode;
-	ImageDescriptorSetHashArray *arr;
-	VkDescriptorSet newDescriptorSet;
-	VkWriteDescriptorSet writeDescriptorSets[MAX_TEXTURE_SAMPLERS];
-	ImageDescriptorSetHashMap *map;
-
-	hashcode = ImageDescriptorSetHashTable_GetHashCode(
-		imageDescriptorSetData,
-		imageDescriptorSetCache->bindingCount
-	);
-	arr = &imageDescriptorSetCache->buckets[hashcode % NUM_DESCRIPTOR_SET_HASH_BUCKETS];
+	VkDescriptorPool descriptorPool;
 
-	for (i = 0; i < arr->count; i += 1)
+	if (pool->inactiveDescriptorSetCount == 0)
 	{
-		ImageDescriptorSetHashMap *e = &imageDescriptorSetCache->elements[arr->elements[i]];
-		if (ImageDescriptorSetDataEqual(
-			imageDescriptorSetData,
-			&e->descriptorSetData,
-			imageDescriptorSetCache->bindingCount
+		if (!VULKAN_INTERNAL_CreateDescriptorPool(
+			renderer,
+			VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
+			pool->nextPoolSize,
+			pool->nextPoolSize,
+			&descriptorPool
 		)) {
-			e->inactiveFrameCount = 0;
-			return e->descriptorSet;
+			return VK_NULL_HANDLE;
 		}
-	}
-
-	/* If no match exists, assign a new descriptor set and prepare it for update */
-	/* If no inactive descriptor sets remain, create a new pool and allocate new inactive sets */
 
-	if (imageDescriptorSetCache->inactiveDescriptorSetCount == 0)
-	{
-		imageDescriptorSetCache->imageDescriptorPoolCount += 1;
-		imageDescriptorSetCache->imageDescriptorPools = SDL_realloc(
-			imageDescriptorSetCache->imageDescriptorPools,
-			sizeof(VkDescriptorPool) * imageDescriptorSetCache->imageDescriptorPoolCount
+		EXPAND_ARRAY_IF_NEEDED(
+			pool->inactiveDescriptorSets,
+			VkDescriptorSet,
+			pool->nextPoolSize,
+			pool->inactiveDescriptorSetCapacity,
+			pool->nextPoolSize
 		);
 
-		VULKAN_INTERNAL_CreateDescriptorPool(
+		if (!VULKAN_INTERNAL_AllocateDescriptorSets(
 			renderer,
-			imageDescriptorSetCache->descriptorType,
-			imageDescriptorSetCache->nextPoolSize,
-			imageDescriptorSetCache->nextPoolSize * imageDescriptorSetCache->bindingCount,
-			&imageDescriptorSetCache->imageDescriptorPools[imageDescriptorSetCache->imageDescriptorPoolCount - 1]
-		);
-
-		imageDescriptorSetCache->inactiveDescriptorSetCapacity += imageDescriptorSetCache->nextPoolSize;
-
-		imageDescriptorSetCache->inactiveDescriptorSets = SDL_realloc(
-			imageDescriptorSetCache->inactiveDescriptorSets,
-			sizeof(VkDescriptorSet) * imageDescriptorSetCache->inactiveDescriptorSetCapacity
-		);
+			descriptorPool,
+			pool->descriptorSetLayout,
+			pool->nextPoolSize,
+			pool->inactiveDescriptorSets
+		)) {
+			renderer->vkDestroyDescriptorPool(
+				renderer->logicalDevice,
+				descriptorPool,
+				NULL
+			);
+			return VK_NULL_HANDLE;
+		}
 
-		VULKAN_INTERNAL_AllocateDescriptorSets(
-			renderer,
-			imageDescriptorSetCache->imageDescriptorPools[imageDescriptorSetCache->imageDescriptorPoolCount - 1],
-			imageDescriptorSetCache->descriptorSetLayout,
-			imageDescriptorSetCache->nextPoolSize,
-			imageDescriptorSetCache->inactiveDescriptorSets
+		pool->descriptorPoolCount += 1;
+		pool->descriptorPools = SDL_realloc(
+			pool->descriptorPools,
+			sizeof(VkDescriptorPool) * pool->descriptorPoolCount
 		);
+		pool->descriptorPools[pool->descriptorPoolCount - 1] = descriptorPool;
 
-		imageDescriptorSetCache->inactiveDescriptorSetCount = imageDescriptorSetCache->nextPoolSize;
+		pool->inactiveDescriptorSetCount = pool->nextPoolSize;
+		pool->nextPoolSize *= 2;
+	}
 
-		imageDescriptorSetCache->nextPoolSize *= 2;
+	pool->inactiveDescriptorSetCount -= 1;
+	return pool->inactiveDescriptorSets[pool->inactiveDescriptorSetCount];
+}
+
+/* Must be called with uniformBufferLock held */
+static VkDescriptorSet VULKAN_INTERNAL_FetchUniformDescriptorSet(
+	VulkanRenderer *renderer,
+	VulkanUniformBufferPool *pool,
+	VulkanUniformBlock *block,
+	VkDeviceSize range
+) {
+	VkDescriptorBufferInfo bufferInfo;
+	VkWriteDescriptorSet writeDescriptorSet;
+	VkDescriptorSet descriptorSet;
+	uint32_t i;
+
+	for (i = 0; i < block->descriptorSetCount; i += 1)
+	{
+		if (block->descriptorSets[i].range == range)
+		{
+			return block->descriptorSets[i].descriptorSet;
+		}
 	}
 
-	newDescriptorSet = imageDescriptorSetCache->inactiveDescriptorSets[imageDescriptorSetCache->inactiveDescriptorSetCount - 1];
-	imageDescriptorSetCache->inactiveDescriptorSetCount -= 1;
+	descriptorSet = VULKAN_INTERNAL_AcquireUniformDescriptorSet(renderer, pool);
 
-	for (i = 0; i < imageDescriptorSetCache->bindingCount; i += 1)
+	if (descriptorSet == VK_NULL_HANDLE)
 	{
-		writeDescriptorSets[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-		writeDescriptorSets[i].pNext = NULL;
-		writeDescriptorSets[i].descriptorCount = 1;
-		writeDescriptorSets[i].descriptorType = imageDescriptorSetCache->descriptorType;
-		writeDescriptorSets[i].dstArrayElement = 0;
-		writeDescriptorSets[i].dstBinding = i;
-		writeDescriptorSets[i].dstSet = newDescriptorSet;
-		writeDescriptorSets[i].pBufferInfo = NULL;
-		writeDescriptorSets[i].pImageInfo = &imageDescriptorSetData->descriptorImageInfo[i];
-		writeDescriptorSets[i].pTexelBufferView = NULL;
+		return VK_NULL_HANDLE;
 	}
 
+	bufferInfo.buffer = block->buffer->subBuffers[0]->buffer;
+	bufferInfo.offset = block->buffer->subBuffers[0]->bufferOffset;
+	bufferInfo.range = range;
+
+	writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+	writeDescriptorSet.pNext = NULL;
+	writeDescriptorSet.descriptorCount = 1;
+	writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+	writeDescriptorSet.dstArrayElement = 0;
+	writeDescriptorSet.dstBinding = 0;
+	writeDescriptorSet.dstSet = descriptorSet;
+	writeDescriptorSet.pBufferInfo = &bufferInfo;
+	writeDescriptorSet.pImageInfo = NULL;
+	writeDescriptorSet.pTexelBufferView = NULL;
+
 	renderer->vkUpdateDescriptorSets(
 		renderer->logicalDevice,
-		imageDescriptorSetCache->bindingCount,
-		writeDescriptorSets,
+		1,
+		&writeDescriptorSet,
 		0,
 		NULL
 	);
 
-	EXPAND_ELEMENTS_IF_NEEDED(arr, 2, uint32_t)
-	arr->elements[arr->count] = imageDescriptorSetCache->count;
-	arr->count += 1;
+	EXPAND_ARRAY_IF_NEEDED(
+		block->descriptorSets,
+		VulkanUniformDescriptorSet,
+		block->descriptorSetCount + 1,
+		block->descriptorSetCapacity,
+		block->descriptorSetCapacity * 2 + 1
+	);
 
-	if (imageDescriptorSetCache->count == imageDescriptorSetCache->capacity)
+	block->descriptorSets[block->descriptorSetCount].range = range;
+	block->descriptorSets[block->descriptorSetCount].descriptorSet = descriptorSet;
+	block->descriptorSetCount += 1;
+
+	return descriptorSet;
+}
+
+/* Splits a value returned by PushUniforms into the descriptor set of
+ * the block the data was written to and the offset within that block.
+ * The set is kept in the command buffer's binding, so only a change of
+ * block takes uniformBufferLock. Returns VK_NULL_HANDLE on failure.
+ */
+static VkDescriptorSet VULKAN_INTERNAL_FetchPushedUniformDescriptorSet(
+	VulkanRenderer *renderer,
+	VulkanUniformBufferPool *pool,
+	VulkanUniformBinding *binding,
+	VkDeviceSize blockSize,
+	uint32_t paramOffset,
+	uint32_t *dynamicOffset
+) {
+	uint32_t blockKey = paramOffset >> UBO_OFFSET_BITS;
+	uint32_t frameIndex = blockKey >> UBO_BLOCK_INDEX_BITS;
+	uint32_t blockIndex = blockKey & (UBO_MAX_BLOCKS - 1);
+	VulkanUniformBlockChain *chain;
+	VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+
+	*dynamicOffset = 0;
+
+	if (blockSize == 0 || blockSize > UBO_BUFFER_SIZE)
 	{
-		imageDescriptorSetCache->capacity *= 2;
+		return pool->dummyDescriptorSet;
+	}
 
-		imageDescriptorSetCache->elements = SDL_realloc(
-			imageDescriptorSetCache->elements,
-			sizeof(ImageDescriptorSetHashMap) * imageDescriptorSetCache->capacity
+	if (	binding->descriptorSet != VK_NULL_HANDLE &&
+		binding->blockKey == blockKey &&
+		binding->range == blockSize	)
+	{
+		*dynamicOffset = paramOffset & ((1u << UBO_OFFSET_BITS) - 1);
+		return binding->descriptorSet;
+	}
+
+	SDL_LockMutex(renderer->uniformBufferLock);
+
+	chain = &pool->chains[frameIndex];
+
+	/* Block 0 is never released, so offsets that were never pushed are safe */
+	if (frameIndex < renderer->framesInFlight && blockIndex < chain->blockCount)
+	{
+		descriptorSet = VULKAN_INTERNAL_FetchUniformDescriptorSet(
+			renderer,
+			pool,
+			chain->blocks[blockIndex],
+			blockSize
 		);
 	}
+	else
+	{
+		Refresh_LogError("Uniform offset does not refer to a live uniform block!");
+	}
 
-	map = &imageDescriptorSetCache->elements[imageDescriptorSetCache->count];
-	map->key = hashcode;
+	SDL_UnlockMutex(renderer->uniformBufferLock);
 
-	for (i = 0; i < imageDescriptorSetCache->bindingCount; i += 1)
+	if (descriptorSet == VK_NULL_HANDLE)
 	{
-		map->descriptorSetData.descriptorImageInfo[i].imageLayout =
-			imageDescriptorSetData->descriptorImageInfo[i].imageLayout;
-		map->descriptorSetData.descriptorImageInfo[i].imageView =
-			imageDescriptorSetData->descriptorImageInfo[i].imageView;
-		map->descriptorSetData.descriptorImageInfo[i].sampler =
-			imageDescriptorSetData->descriptorImageInfo[i].sampler;
+		Refresh_LogError("Failed to fetch uniform descriptor set!");
+		return VK_NULL_HANDLE;
 	}
 
-	map->descriptorSet = newDescriptorSet;
-	map->inactiveFrameCount = 0;
-	imageDescriptorSetCache->count += 1;
+	binding->blockKey = blockKey;
+	binding->range = blockSize;
+	binding->descriptorSet = descriptorSet;
 
-	return newDescriptorSet;
+	*dynamicOffset = paramOffset & ((1u << UBO_OFFSET_BITS) - 1);
+	return descriptorSet;
 }
 
-static void VULKAN_BindVertexSamplers(
-	Refresh_Renderer *driverData,
-	Refresh_CommandBuffer *commandBuffer,
-	Refresh_Texture **pTextures,
-	Refresh_Sampler **pSamplers
+/* Must be called with uniformBufferLock held.
+ * Carves size bytes out of the current frame's chain for one thread,
+ * moving to the next block when the current one is full.
+ */
+static uint8_t VULKAN_INTERNAL_ReserveUniformChunk(
+	VulkanRenderer *renderer,
+	VulkanUniformBufferPool *pool,
+	VulkanUniformChunk *chunk,
+	uint32_t size
 ) {
-	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
-	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
-	VulkanGraphicsPipeline *graphicsPipeline = vulkanCommandBuffer->currentGraphicsPipeline;
-
-	VulkanTexture *currentTexture;
-	uint32_t i, samplerCount;
-	ImageDescriptorSetData vertexSamplerDescriptorSetData;
+	VulkanUniformBlockChain *chain = &pool->chains[renderer->frameIndex];
+	VulkanUniformBlock *block;
 
-	if (graphicsPipeline->pipelineLayout->vertexSamplerDescriptorSetCache == NULL)
+	if (chain->offset + size > UBO_BUFFER_SIZE)
 	{
-		return;
-	}
+		if (chain->currentBlockIndex + 1 == chain->blockCount)
+		{
+			/* The block index has to fit in the pushed offset */
+			if (chain->blockCount == UBO_MAX_BLOCKS)
+			{
+				Refresh_LogError("Out of uniform blocks for this frame!");
+				return 0;
+			}
 
-	samplerCount = graphicsPipeline->pipelineLayout->vertexSamplerDescriptorSetCache->bindingCount;
+			block = VULKAN_INTERNAL_CreateUniformBlock(renderer, pool);
 
-	for (i = 0; i < samplerCount; i += 1)
-	{
-		currentTexture = (VulkanTexture*) pTextures[i];
-		vertexSamplerDescriptorSetData.descriptorImageInfo[i].imageView = currentTexture->view;
-		vertexSamplerDescriptorSetData.descriptorImageInfo[i].sampler = (VkSampler) pSamplers[i];
-		vertexSamplerDescriptorSetData.descriptorImageInfo[i].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+			if (block == NULL)
+			{
+				return 0;
+			}
+
+			EXPAND_ARRAY_IF_NEEDED(
+				chain->blocks,
+				VulkanUniformBlock*,
+				chain->blockCount + 1,
+				chain->blockCapacity,
+				chain->blockCapacity * 2
+			);
+
+			chain->blocks[chain->blockCount] = block;
+			chain->blockCount += 1;
+		}
+
+		chain->currentBlockIndex += 1;
+		chain->offset = 0;
 	}
 
-	graphicsPipeline->vertexSamplerDescriptorSet = VULKAN_INTERNAL_FetchImageDescriptorSet(
-		renderer,
-		graphicsPipeline->pipelineLayout->vertexSamplerDescriptorSetCache,
-		&vertexSamplerDescriptorSetData
-	);
+	chunk->block = chain->blocks[chain->currentBlockIndex];
+	chunk->epoch = SDL_AtomicGet(&pool->epoch);
+	chunk->blockKey =
+		(renderer->frameIndex << UBO_BLOCK_INDEX_BITS) |
+		chain->currentBlockIndex;
+	chunk->offset = chain->offset;
+	chunk->end = chain->offset + size;
+
+	chain->offset += size;
+
+	return 1;
 }
 
-static void VULKAN_BindFragmentSamplers(
-	Refresh_Renderer *driverData,
-	Refresh_CommandBuffer *commandBuffer,
-	Refresh_Texture **pTextures,
-	Refresh_Sampler **pSamplers
+/* Sub-allocates from the calling thread's chunk, only locking to reserve
+ * a new chunk. The block the data landed in is encoded above the offset,
+ * so draws bind exactly that block.
+ */
+static uint32_t VULKAN_INTERNAL_PushUniforms(
+	VulkanRenderer *renderer,
+	VulkanUniformBufferPool *pool,
+	VulkanUniformChunk *chunk,
+	VkDeviceSize blockSize,
+	void *data,
+	uint32_t dataLengthInBytes
 ) {
-	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
-	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
-	VulkanGraphicsPipeline *graphicsPipeline = vulkanCommandBuffer->currentGraphicsPipeline;
-	VulkanTexture *currentTexture;
+	VulkanSubBuffer *subBuffer;
+	uint32_t offset;
+	uint8_t reserved;
 
-	uint32_t i, samplerCount;
-	ImageDescriptorSetData fragmentSamplerDescriptorSetData;
+	if (blockSize > UBO_BUFFER_SIZE)
+	{
+		Refresh_LogError("Uniform block size is larger than a UBO block!");
+		return 0;
+	}
 
-	if (graphicsPipeline->pipelineLayout->fragmentSamplerDescriptorSetCache == NULL)
+	/* Overflowing the block would write into another thread's chunk */
+	if (dataLengthInBytes > blockSize)
 	{
-		return;
+		Refresh_LogError("Uniform data is larger than the pipeline's uniform block size!");
+		return 0;
 	}
 
-	samplerCount = graphicsPipeline->pipelineLayout->fragmentSamplerDescriptorSetCache->bindingCount;
+	if (blockSize == 0)
+	{
+		return 0;
+	}
 
-	for (i = 0; i < samplerCount; i += 1)
+	if (	chunk->block == NULL ||
+		chunk->epoch != SDL_AtomicGet(&pool->epoch) ||
+		chunk->offset + blockSize > chunk->end	)
 	{
-		currentTexture = (VulkanTexture*) pTextures[i];
-		fragmentSamplerDescriptorSetData.descriptorImageInfo[i].imageView = currentTexture->view;
-		fragmentSamplerDescriptorSetData.descriptorImageInfo[i].sampler = (VkSampler) pSamplers[i];
-		fragmentSamplerDescriptorSetData.descriptorImageInfo[i].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+		SDL_LockMutex(renderer->uniformBufferLock);
+		reserved = VULKAN_INTERNAL_ReserveUniformChunk(
+			renderer,
+			pool,
+			chunk,
+			(uint32_t) SDL_max(UBO_CHUNK_SIZE, blockSize)
+		);
+		SDL_UnlockMutex(renderer->uniformBufferLock);
+
+		if (!reserved)
+		{
+			return 0;
+		}
 	}
 
-	graphicsPipeline->fragmentSamplerDescriptorSet = VULKAN_INTERNAL_FetchImageDescriptorSet(
+	offset = chunk->offset;
+	chunk->offset += (uint32_t) blockSize;
+
+	/* Uniform blocks are never renamed, write straight into the mapping */
+	subBuffer = chunk->block->buffer->subBuffers[0];
+
+	SDL_memcpy(
+		subBuffer->allocation->mapPointer + subBuffer->offset + offset,
+		data,
+		dataLengthInBytes
+	);
+
+	VULKAN_INTERNAL_FlushSubBuffer(
 		renderer,
-		graphicsPipeline->pipelineLayout->fragmentSamplerDescriptorSetCache,
-		&fragmentSamplerDescriptorSetData
+		subBuffer,
+		offset,
+		dataLengthInBytes
 	);
+
+	return (chunk->blockKey << UBO_OFFSET_BITS) | offset;
 }
 
-static void VULKAN_GetBufferData(
-	Refresh_Renderer *driverData,
-	Refresh_Buffer *buffer,
-	void *data,
-	uint32_t dataLengthInBytes
+/* Called once the frame slot's previous work has completed.
+ * Blocks past the ones this slot needed recently are released.
+ */
+static void VULKAN_INTERNAL_ResetUniformBufferPool(
+	VulkanRenderer *renderer,
+	VulkanUniformBufferPool *pool
 ) {
-	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
-	VulkanBuffer *vulkanBuffer = (VulkanBuffer*) buffer;
-	uint8_t *dataPtr = (uint8_t*) data;
-	uint8_t *mapPointer;
+	VulkanUniformBlockChain *chain = &pool->chains[renderer->frameIndex];
+	uint32_t usedBlockCount = chain->currentBlockIndex + 1;
 
-	mapPointer =
-		vulkanBuffer->subBuffers[vulkanBuffer->currentSubBufferIndex]->allocation->mapPointer +
-		vulkanBuffer->subBuffers[vulkanBuffer->currentSubBufferIndex]->offset;
+	if (usedBlockCount < chain->blockCount)
+	{
+		chain->quietFrameCount += 1;
 
-	SDL_memcpy(
-		dataPtr,
-		mapPointer,
-		dataLengthInBytes
-	);
+		if (chain->quietFrameCount >= UBO_BLOCK_RELEASE_FRAMES)
+		{
+			chain->blockCount -= 1;
+			VULKAN_INTERNAL_DestroyUniformBlock(
+				renderer,
+				pool,
+				chain->blocks[chain->blockCount]
+			);
+			chain->quietFrameCount = 0;
+		}
+	}
+	else
+	{
+		chain->quietFrameCount = 0;
+	}
+
+	chain->currentBlockIndex = 0;
+	chain->offset = 0;
+
+	SDL_AtomicIncRef(&pool->epoch);
 }
 
-static void VULKAN_CopyTextureToBuffer(
-	Refresh_Renderer *driverData,
-	Refresh_CommandBuffer *commandBuffer,
-	Refresh_TextureSlice *textureSlice,
-	Refresh_Buffer *buffer
+static VulkanUniformBufferPool* VULKAN_INTERNAL_CreateUniformBufferPool(
+	VulkanRenderer *renderer,
+	VkDescriptorSetLayout descriptorSetLayout,
+	VulkanResourceAccessType resourceAccessType,
+	VulkanBuffer *dummyBuffer
 ) {
-	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
-	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
-	VulkanTexture *vulkanTexture = (VulkanTexture*) textureSlice->texture;
-	VulkanBuffer *vulkanBuffer = (VulkanBuffer*) buffer;
+	VulkanUniformBufferPool *pool = SDL_malloc(sizeof(VulkanUniformBufferPool));
+	VkDescriptorSetAllocateInfo allocateInfo;
+	VkDescriptorBufferInfo bufferInfo;
+	VkWriteDescriptorSet writeDescriptorSet;
+	VulkanUniformBlockChain *chain;
+	uint32_t i;
 
-	VulkanResourceAccessType prevResourceAccess;
-	VkBufferImageCopy imageCopy;
+	pool->descriptorSetLayout = descriptorSetLayout;
+	pool->resourceAccessType = resourceAccessType;
 
-	/* Cache this so we can restore it later */
-	prevResourceAccess = vulkanTexture->resourceAccessType;
+	/* Pipelines without uniforms bind the dummy buffer */
 
-	VULKAN_INTERNAL_ImageMemoryBarrier(
-		renderer,
-		vulkanCommandBuffer->commandBuffer,
-		RESOURCE_ACCESS_TRANSFER_READ,
-		VK_IMAGE_ASPECT_COLOR_BIT,
-		textureSlice->layer,
-		1,
-		textureSlice->level,
+	allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+	allocateInfo.pNext = NULL;
+	allocateInfo.descriptorPool = renderer->defaultDescriptorPool;
+	allocateInfo.descriptorSetCount = 1;
+	allocateInfo.pSetLayouts = &pool->descriptorSetLayout;
+
+	renderer->vkAllocateDescriptorSets(
+		renderer->logicalDevice,
+		&allocateInfo,
+		&pool->dummyDescriptorSet
+	);
+
+	bufferInfo.buffer = dummyBuffer->subBuffers[0]->buffer;
+	bufferInfo.offset = 0;
+	bufferInfo.range = dummyBuffer->subBuffers[0]->size;
+
+	writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+	writeDescriptorSet.pNext = NULL;
+	writeDescriptorSet.descriptorCount = 1;
+	writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+	writeDescriptorSet.dstArrayElement = 0;
+	writeDescriptorSet.dstBinding = 0;
+	writeDescriptorSet.dstSet = pool->dummyDescriptorSet;
+	writeDescriptorSet.pBufferInfo = &bufferInfo;
+	writeDescriptorSet.pImageInfo = NULL;
+	writeDescriptorSet.pTexelBufferView = NULL;
+
+	renderer->vkUpdateDescriptorSets(
+		renderer->logicalDevice,
 		1,
+		&writeDescriptorSet,
 		0,
-		vulkanTexture->image,
-		&vulkanTexture->resourceAccessType
+		NULL
 	);
 
-	/* Save texture data to buffer */
+	pool->descriptorPools = NULL;
+	pool->descriptorPoolCount = 0;
+	pool->nextPoolSize = DESCRIPTOR_POOL_STARTING_SIZE;
+	pool->inactiveDescriptorSets = NULL;
+	pool->inactiveDescriptorSetCount = 0;
+	pool->inactiveDescriptorSetCapacity = 0;
 
-	imageCopy.imageExtent.width = textureSlice->rectangle.w;
-	imageCopy.imageExtent.height = textureSlice->rectangle.h;
-	imageCopy.imageExtent.depth = 1;
-	imageCopy.bufferRowLength = textureSlice->rectangle.w;
-	imageCopy.bufferImageHeight = textureSlice->rectangle.h;
-	imageCopy.imageOffset.x = textureSlice->rectangle.x;
-	imageCopy.imageOffset.y = textureSlice->rectangle.y;
-	imageCopy.imageOffset.z = textureSlice->depth;
-	imageCopy.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-	imageCopy.imageSubresource.baseArrayLayer = textureSlice->layer;
-	imageCopy.imageSubresource.layerCount = 1;
-	imageCopy.imageSubresource.mipLevel = textureSlice->level;
-	imageCopy.bufferOffset = 0;
+	/* Every frame slot starts with one block */
 
-	renderer->vkCmdCopyImageToBuffer(
-		vulkanCommandBuffer->commandBuffer,
-		vulkanTexture->image,
-		AccessMap[vulkanTexture->resourceAccessType].imageLayout,
-		vulkanBuffer->subBuffers[vulkanBuffer->currentSubBufferIndex]->buffer,
-		1,
-		&imageCopy
-	);
+	for (i = 0; i < renderer->framesInFlight; i += 1)
+	{
+		chain = &pool->chains[i];
 
-	/* Restore the image layout */
+		chain->blockCapacity = 4;
+		chain->blocks = SDL_malloc(sizeof(VulkanUniformBlock*) * chain->blockCapacity);
+		chain->blocks[0] = VULKAN_INTERNAL_CreateUniformBlock(renderer, pool);
 
-	VULKAN_INTERNAL_ImageMemoryBarrier(
-		renderer,
-		vulkanCommandBuffer->commandBuffer,
-		prevResourceAccess,
-		VK_IMAGE_ASPECT_COLOR_BIT,
-		textureSlice->layer,
-		1,
-		textureSlice->level,
-		1,
-		0,
-		vulkanTexture->image,
-		&vulkanTexture->resourceAccessType
-	);
+		if (chain->blocks[0] == NULL)
+		{
+			return NULL;
+		}
+
+		chain->blockCount = 1;
+		chain->currentBlockIndex = 0;
+		chain->offset = 0;
+		chain->quietFrameCount = 0;
+	}
+
+	SDL_AtomicSet(&pool->epoch, 0);
+
+	return pool;
 }
 
-static void VULKAN_QueueDestroyTexture(
-	Refresh_Renderer *driverData,
-	Refresh_Texture *texture
+static void VULKAN_INTERNAL_DestroyUniformBufferPool(
+	VulkanRenderer *renderer,
+	VulkanUniformBufferPool *pool
 ) {
-	VulkanRenderer* renderer = (VulkanRenderer*)driverData;
-	VulkanTexture* vulkanTexture = (VulkanTexture*)texture;
+	uint32_t i, j;
 
-	SDL_LockMutex(renderer->disposeLock);
+	for (i = 0; i < renderer->framesInFlight; i += 1)
+	{
+		for (j = 0; j < pool->chains[i].blockCount; j += 1)
+		{
+			VULKAN_INTERNAL_DestroyUniformBlock(
+				renderer,
+				pool,
+				pool->chains[i].blocks[j]
+			);
+		}
+		SDL_free(pool->chains[i].blocks);
+	}
 
-	EXPAND_ARRAY_IF_NEEDED(
-		renderer->texturesToDestroy,
-		VulkanTexture*,
-		renderer->texturesToDestroyCount + 1,
-		renderer->texturesToDestroyCapacity,
-		renderer->texturesToDestroyCapacity * 2
-	)
+	/* Frees every block descriptor set along with its pool */
+	for (i = 0; i < pool->descriptorPoolCount; i += 1)
+	{
+		renderer->vkDestroyDescriptorPool(
+			renderer->logicalDevice,
+			pool->descriptorPools[i],
+			NULL
+		);
+	}
+	SDL_free(pool->descriptorPools);
+	SDL_free(pool->inactiveDescriptorSets);
 
-	renderer->texturesToDestroy[renderer->texturesToDestroyCount] = vulkanTexture;
-	renderer->texturesToDestroyCount += 1;
+	renderer->vkFreeDescriptorSets(
+		renderer->logicalDevice,
+		renderer->defaultDescriptorPool,
+		1,
+		&pool->dummyDescriptorSet
+	);
 
-	SDL_UnlockMutex(renderer->disposeLock);
+	SDL_free(pool);
 }
 
-static void VULKAN_QueueDestroySampler(
+static uint32_t VULKAN_PushVertexShaderUniforms(
 	Refresh_Renderer *driverData,
-	Refresh_Sampler *sampler
+	Refresh_GraphicsPipeline *pipeline,
+	void *data,
+	uint32_t dataLengthInBytes
 ) {
-	VulkanRenderer* renderer = (VulkanRenderer*)driverData;
-	VkSampler vulkanSampler = (VkSampler) sampler;
-
-	SDL_LockMutex(renderer->disposeLock);
-
-	EXPAND_ARRAY_IF_NEEDED(
-		renderer->samplersToDestroy,
-		VkSampler,
-		renderer->samplersToDestroyCount + 1,
-		renderer->samplersToDestroyCapacity,
-		renderer->samplersToDestroyCapacity * 2
-	)
-
-	renderer->samplersToDestroy[renderer->samplersToDestroyCount] = vulkanSampler;
-	renderer->samplersToDestroyCount += 1;
+	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
+	VulkanGraphicsPipeline* graphicsPipeline = (VulkanGraphicsPipeline*) pipeline;
+	VulkanCommandPool *commandPool = VULKAN_INTERNAL_FetchCommandPool(
+		renderer,
+		SDL_ThreadID()
+	);
 
-	SDL_UnlockMutex(renderer->disposeLock);
+	return VULKAN_INTERNAL_PushUniforms(
+		renderer,
+		renderer->vertexUniformBufferPool,
+		&commandPool->vertexUniformChunk,
+		graphicsPipeline->vertexUBOBlockSize,
+		data,
+		dataLengthInBytes
+	);
 }
 
-static void VULKAN_QueueDestroyBuffer(
+static uint32_t VULKAN_PushFragmentShaderUniforms(
 	Refresh_Renderer *driverData,
-	Refresh_Buffer *buffer
+	Refresh_GraphicsPipeline *pipeline,
+	void *data,
+	uint32_t dataLengthInBytes
 ) {
-	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
-	VulkanBuffer *vulkanBuffer = (VulkanBuffer*) buffer;
-
-	SDL_LockMutex(renderer->disposeLock);
+	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
+	VulkanGraphicsPipeline* graphicsPipeline = (VulkanGraphicsPipeline*) pipeline;
+	VulkanCommandPool *commandPool = VULKAN_INTERNAL_FetchCommandPool(
+		renderer,
+		SDL_ThreadID()
+	);
 
-	EXPAND_ARRAY_IF_NEEDED(
-		renderer->buffersToDestroy,
-		VulkanBuffer*,
-		renderer->buffersToDestroyCount + 1,
-		renderer->buffersToDestroyCapacity,
-		renderer->buffersToDestroyCapacity * 2
-	)
+	return VULKAN_INTERNAL_PushUniforms(
+		renderer,
+		renderer->fragmentUniformBufferPool,
+		&commandPool->fragmentUniformChunk,
+		graphicsPipeline->fragmentUBOBlockSize,
+		data,
+		dataLengthInBytes
+	);
+}
 
-	renderer->buffersToDestroy[
-		renderer->buffersToDestroyCount
-	] = vulkanBuffer;
-	renderer->buffersToDestroyCount += 1;
+static uint32_t VULKAN_PushComputeShaderUniforms(
+	Refresh_Renderer *driverData,
+	Refresh_ComputePipeline *pipeline,
+	void *data,
+	uint32_t dataLengthInBytes
+) {
+	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
+	VulkanComputePipeline* computePipeline = (VulkanComputePipeline*) pipeline;
+	VulkanCommandPool *commandPool = VULKAN_INTERNAL_FetchCommandPool(
+		renderer,
+		SDL_ThreadID()
+	);
 
-	SDL_UnlockMutex(renderer->disposeLock);
+	return VULKAN_INTERNAL_PushUniforms(
+		renderer,
+		renderer->computeUniformBufferPool,
+		&commandPool->computeUniformChunk,
+		computePipeline->computeUBOBlockSize,
+		data,
+		dataLengthInBytes
+	);
 }
 
-static void VULKAN_QueueDestroyRenderTarget(
+static void VULKAN_PushConstants(
 	Refresh_Renderer *driverData,
-	Refresh_RenderTarget *renderTarget
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_ShaderStageType stage,
+	void *data,
+	uint32_t dataLengthInBytes
 ) {
 	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
-	VulkanRenderTarget *vulkanRenderTarget = (VulkanRenderTarget*) renderTarget;
+	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+	VkPipelineLayout pipelineLayout;
+	VkShaderStageFlags stageFlags;
+	uint32_t offset;
+	uint32_t size;
 
-	SDL_LockMutex(renderer->disposeLock);
+	if (stage == REFRESH_SHADERSTAGE_COMPUTE)
+	{
+		if (vulkanCommandBuffer->currentComputePipeline == NULL)
+		{
+			Refresh_LogError("Pushing compute constants without a bound compute pipeline!");
+			return;
+		}
 
-	EXPAND_ARRAY_IF_NEEDED(
-		renderer->renderTargetsToDestroy,
-		VulkanRenderTarget*,
-		renderer->renderTargetsToDestroyCount + 1,
-		renderer->renderTargetsToDestroyCapacity,
-		renderer->renderTargetsToDestroyCapacity * 2
-	)
+		pipelineLayout = vulkanCommandBuffer->currentComputePipeline->pipelineLayout->pipelineLayout;
+		stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+		offset = 0;
+		size = vulkanCommandBuffer->currentComputePipeline->pipelineLayout->pushConstantSize;
+	}
+	else
+	{
+		if (vulkanCommandBuffer->currentGraphicsPipeline == NULL)
+		{
+			Refresh_LogError("Pushing graphics constants without a bound graphics pipeline!");
+			return;
+		}
 
-	renderer->renderTargetsToDestroy[renderer->renderTargetsToDestroyCount] = vulkanRenderTarget;
-	renderer->renderTargetsToDestroyCount += 1;
+		pipelineLayout = vulkanCommandBuffer->currentGraphicsPipeline->pipelineLayout->pipelineLayout;
 
-	SDL_UnlockMutex(renderer->disposeLock);
+		if (stage == REFRESH_SHADERSTAGE_VERTEX)
+		{
+			stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+			offset = 0;
+			size = vulkanCommandBuffer->currentGraphicsPipeline->pipelineLayout->vertexPushConstantSize;
+		}
+		else
+		{
+			stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+			offset = vulkanCommandBuffer->currentGraphicsPipeline->pipelineLayout->vertexPushConstantSize;
+			size = vulkanCommandBuffer->currentGraphicsPipeline->pipelineLayout->fragmentPushConstantSize;
+		}
+	}
+
+	if (dataLengthInBytes == 0 || (dataLengthInBytes & 3))
+	{
+		Refresh_LogError("Push constant data length must be a nonzero multiple of 4!");
+		return;
+	}
+
+	if (dataLengthInBytes > size)
+	{
+		Refresh_LogError(
+			"Push constant data of %u bytes exceeds the declared block size of %u bytes!",
+			dataLengthInBytes,
+			size
+		);
+		return;
+	}
+
+	renderer->vkCmdPushConstants(
+		vulkanCommandBuffer->commandBuffer,
+		pipelineLayout,
+		stageFlags,
+		offset,
+		dataLengthInBytes,
+		data
+	);
 }
 
-static void VULKAN_QueueDestroyFramebuffer(
-	Refresh_Renderer *driverData,
-	Refresh_Framebuffer *framebuffer
+static inline uint8_t BufferDescriptorSetDataEqual(
+	BufferDescriptorSetData *a,
+	BufferDescriptorSetData *b,
+	uint8_t bindingCount
 ) {
-	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
-	VulkanFramebuffer *vulkanFramebuffer = (VulkanFramebuffer*) framebuffer;
-
-	SDL_LockMutex(renderer->disposeLock);
+	uint32_t i;
 
-	EXPAND_ARRAY_IF_NEEDED(
-		renderer->framebuffersToDestroy,
-		VulkanFramebuffer*,
-		renderer->framebuffersToDestroyCount + 1,
-		renderer->framebuffersToDestroyCapacity,
-		renderer->framebuffersToDestroyCapacity * 2
-	)
+	for (i = 0; i < bindingCount; i += 1)
+	{
+		if (	a->descriptorBufferInfo[i].buffer != b->descriptorBufferInfo[i].buffer ||
+			a->descriptorBufferInfo[i].offset != b->descriptorBufferInfo[i].offset ||
+			a->descriptorBufferInfo[i].range != b->descriptorBufferInfo[i].range	)
+		{
+			return 0;
+		}
+	}
 
-	renderer->framebuffersToDestroy[renderer->framebuffersToDestroyCount] = vulkanFramebuffer;
-	renderer->framebuffersToDestroyCount += 1;
+	return 1;
+}
 
-	SDL_UnlockMutex(renderer->disposeLock);
+static inline uint8_t VULKAN_INTERNAL_DescriptorSetExpired(
+	uint32_t submission,
+	uint32_t lastUsedSubmission
+) {
+	return (uint32_t) (submission + 1 - lastUsedSubmission) >= DESCRIPTOR_SET_DEACTIVATE_FRAMES;
 }
 
-static void VULKAN_QueueDestroyShaderModule(
-	Refresh_Renderer *driverData,
-	Refresh_ShaderModule *shaderModule
+static void VULKAN_INTERNAL_DeactivateUnusedBufferDescriptorSets(
+	uint32_t submission,
+	BufferDescriptorSetCache *bufferDescriptorSetCache
 ) {
-	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
-	VkShaderModule vulkanShaderModule = (VkShaderModule) shaderModule;
+	uint32_t i, last;
 
-	SDL_LockMutex(renderer->disposeLock);
+	/* The list is ordered by last use, so stop at the first live entry */
+	while (	bufferDescriptorSetCache->lruHead != DESCRIPTOR_SET_INDEX_EMPTY &&
+		VULKAN_INTERNAL_DescriptorSetExpired(
+			submission,
+			bufferDescriptorSetCache->elements[bufferDescriptorSetCache->lruHead].lastUsedSubmission
+		)	)
+	{
+		i = bufferDescriptorSetCache->lruHead;
+		last = bufferDescriptorSetCache->count - 1;
 
-	EXPAND_ARRAY_IF_NEEDED(
-		renderer->shaderModulesToDestroy,
-		VkShaderModule,
-		renderer->shaderModulesToDestroyCount + 1,
-		renderer->shaderModulesToDestroyCapacity,
-		renderer->shaderModulesToDestroyCapacity * 2
-	)
+		DESCRIPTOR_SET_LRU_UNLINK(bufferDescriptorSetCache, i);
 
-	renderer->shaderModulesToDestroy[renderer->shaderModulesToDestroyCount] = vulkanShaderModule;
-	renderer->shaderModulesToDestroyCount += 1;
+		/* remove index from the table */
+		if (bufferDescriptorSetCache->elements[i].indexed)
+		{
+			DescriptorSetIndex_Remove(
+				&bufferDescriptorSetCache->index,
+				bufferDescriptorSetCache->elements[i].key,
+				i
+			);
+		}
 
-	SDL_UnlockMutex(renderer->disposeLock);
-}
+		/* remove element from table and place in inactive sets */
 
-static void VULKAN_QueueDestroyRenderPass(
-	Refresh_Renderer *driverData,
-	Refresh_RenderPass *renderPass
-) {
-	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
-	VkRenderPass vulkanRenderPass = (VkRenderPass) renderPass;
+		bufferDescriptorSetCache->inactiveDescriptorSets[bufferDescriptorSetCache->inactiveDescriptorSetCount] = bufferDescriptorSetCache->elements[i].descriptorSet;
+		bufferDescriptorSetCache->inactiveDescriptorSetCount += 1;
 
-	SDL_LockMutex(renderer->disposeLock);
+		/* move another descriptor set to fill the hole */
+		if (i < last)
+		{
+			bufferDescriptorSetCache->elements[i] = bufferDescriptorSetCache->elements[last];
 
-	EXPAND_ARRAY_IF_NEEDED(
-		renderer->renderPassesToDestroy,
-		VkRenderPass,
-		renderer->renderPassesToDestroyCount + 1,
-		renderer->renderPassesToDestroyCapacity,
-		renderer->renderPassesToDestroyCapacity * 2
-	)
+			/* update index in the table and the list */
+			if (bufferDescriptorSetCache->elements[i].indexed)
+			{
+				DescriptorSetIndex_Move(
+					&bufferDescriptorSetCache->index,
+					bufferDescriptorSetCache->elements[i].key,
+					last,
+					i
+				);
+			}
 
-	renderer->renderPassesToDestroy[renderer->renderPassesToDestroyCount] = vulkanRenderPass;
-	renderer->renderPassesToDestroyCount += 1;
+			DESCRIPTOR_SET_LRU_RELINK(bufferDescriptorSetCache, i);
+		}
 
-	SDL_UnlockMutex(renderer->disposeLock);
+		bufferDescriptorSetCache->count -= 1;
+	}
 }
 
-static void VULKAN_QueueDestroyComputePipeline(
-	Refresh_Renderer *driverData,
-	Refresh_ComputePipeline *computePipeline
+static void VULKAN_INTERNAL_DeactivateUnusedImageDescriptorSets(
+	uint32_t submission,
+	ImageDescriptorSetCache *imageDescriptorSetCache
 ) {
-	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
-	VulkanComputePipeline *vulkanComputePipeline = (VulkanComputePipeline*) computePipeline;
+	uint32_t i, last;
 
-	SDL_LockMutex(renderer->disposeLock);
+	/* The list is ordered by last use, so stop at the first live entry */
+	while (	imageDescriptorSetCache->lruHead != DESCRIPTOR_SET_INDEX_EMPTY &&
+		VULKAN_INTERNAL_DescriptorSetExpired(
+			submission,
+			imageDescriptorSetCache->elements[imageDescriptorSetCache->lruHead].lastUsedSubmission
+		)	)
+	{
+		i = imageDescriptorSetCache->lruHead;
+		last = imageDescriptorSetCache->count - 1;
 
-	EXPAND_ARRAY_IF_NEEDED(
-		renderer->computePipelinesToDestroy,
-		VulkanComputePipeline*,
-		renderer->computePipelinesToDestroyCount + 1,
-		renderer->computePipelinesToDestroyCapacity,
-		renderer->computePipelinesToDestroyCapacity * 2
-	)
+		DESCRIPTOR_SET_LRU_UNLINK(imageDescriptorSetCache, i);
 
-	renderer->computePipelinesToDestroy[renderer->computePipelinesToDestroyCount] = vulkanComputePipeline;
-	renderer->computePipelinesToDestroyCount += 1;
+		/* remove index from the table */
+		if (imageDescriptorSetCache->elements[i].indexed)
+		{
+			DescriptorSetIndex_Remove(
+				&imageDescriptorSetCache->index,
+				imageDescriptorSetCache->elements[i].key,
+				i
+			);
+		}
 
-	SDL_UnlockMutex(renderer->disposeLock);
-}
+		/* remove element from table and place in inactive sets */
 
-static void VULKAN_QueueDestroyGraphicsPipeline(
-	Refresh_Renderer *driverData,
-	Refresh_GraphicsPipeline *graphicsPipeline
-) {
-	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
-	VulkanGraphicsPipeline *vulkanGraphicsPipeline = (VulkanGraphicsPipeline*) graphicsPipeline;
+		imageDescriptorSetCache->inactiveDescriptorSets[imageDescriptorSetCache->inactiveDescriptorSetCount] = imageDescriptorSetCache->elements[i].descriptorSet;
+		imageDescriptorSetCache->inactiveDescriptorSetCount += 1;
 
-	SDL_LockMutex(renderer->disposeLock);
+		/* move another descriptor set to fill the hole */
+		if (i < last)
+		{
+			imageDescriptorSetCache->elements[i] = imageDescriptorSetCache->elements[last];
 
-	EXPAND_ARRAY_IF_NEEDED(
-		renderer->graphicsPipelinesToDestroy,
-		VulkanGraphicsPipeline*,
-		renderer->graphicsPipelinesToDestroyCount + 1,
-		renderer->graphicsPipelinesToDestroyCapacity,
-		renderer->graphicsPipelinesToDestroyCapacity * 2
-	)
+			/* update index in the table and the list */
+			if (imageDescriptorSetCache->elements[i].indexed)
+			{
+				DescriptorSetIndex_Move(
+					&imageDescriptorSetCache->index,
+					imageDescriptorSetCache->elements[i].key,
+					last,
+					i
+				);
+			}
 
-	renderer->graphicsPipelinesToDestroy[renderer->graphicsPipelinesToDestroyCount] = vulkanGraphicsPipeline;
-	renderer->graphicsPipelinesToDestroyCount += 1;
+			DESCRIPTOR_SET_LRU_RELINK(imageDescriptorSetCache, i);
+		}
 
-	SDL_UnlockMutex(renderer->disposeLock);
+		imageDescriptorSetCache->count -= 1;
+	}
 }
 
-static void VULKAN_BeginRenderPass(
-	Refresh_Renderer *driverData,
-	Refresh_CommandBuffer *commandBuffer,
-	Refresh_RenderPass *renderPass,
-	Refresh_Framebuffer *framebuffer,
-	Refresh_Rect *renderArea,
-	Refresh_Vec4 *pColorClearValues,
-	uint32_t colorClearCount,
-	Refresh_DepthStencilValue *depthStencilClearValue
+/* Runs on the thread owning the command pool, the first time it fetches
+ * a descriptor set after a submission. Only caches holding sets are
+ * visited, and a cache leaves the list once all of its sets have expired.
+ */
+static void VULKAN_INTERNAL_ResetDescriptorSetData(
+	VulkanCommandPool *commandPool,
+	uint32_t submission
 ) {
-	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
-	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
-	VulkanFramebuffer *vulkanFramebuffer = (VulkanFramebuffer*) framebuffer;
-
-	VkClearValue *clearValues;
-	uint32_t i;
-	uint32_t clearCount = colorClearCount;
-	VkImageAspectFlags depthAspectFlags;
-
-	/* Layout transitions */
+	int32_t i;
+	ImageDescriptorSetCache *imageDescriptorSetCache;
+	BufferDescriptorSetCache *bufferDescriptorSetCache;
 
-	for (i = 0; i < vulkanFramebuffer->colorTargetCount; i += 1)
+	for (i = commandPool->activeImageDescriptorSetCacheCount - 1; i >= 0; i -= 1)
 	{
-		VULKAN_INTERNAL_ImageMemoryBarrier(
-			renderer,
-			vulkanCommandBuffer->commandBuffer,
-			RESOURCE_ACCESS_COLOR_ATTACHMENT_READ_WRITE,
-			VK_IMAGE_ASPECT_COLOR_BIT,
-			0,
-			vulkanFramebuffer->colorTargets[i]->texture->layerCount,
-			0,
-			vulkanFramebuffer->colorTargets[i]->texture->levelCount,
-			0,
-			vulkanFramebuffer->colorTargets[i]->texture->image,
-			&vulkanFramebuffer->colorTargets[i]->texture->resourceAccessType
+		imageDescriptorSetCache = commandPool->activeImageDescriptorSetCaches[i];
+
+		VULKAN_INTERNAL_DeactivateUnusedImageDescriptorSets(
+			submission,
+			imageDescriptorSetCache
 		);
+
+		if (imageDescriptorSetCache->count == 0)
+		{
+			imageDescriptorSetCache->active = 0;
+			commandPool->activeImageDescriptorSetCaches[i] = commandPool->activeImageDescriptorSetCaches[commandPool->activeImageDescriptorSetCacheCount - 1];
+			commandPool->activeImageDescriptorSetCacheCount -= 1;
+		}
 	}
 
-	if (vulkanFramebuffer->depthStencilTarget != NULL)
+	for (i = commandPool->activeBufferDescriptorSetCacheCount - 1; i >= 0; i -= 1)
 	{
-		depthAspectFlags = VK_IMAGE_ASPECT_DEPTH_BIT;
-
-		if (IsStencilFormat(
-			vulkanFramebuffer->depthStencilTarget->texture->format
-		)) {
-			depthAspectFlags |= VK_IMAGE_ASPECT_STENCIL_BIT;
-		}
+		bufferDescriptorSetCache = commandPool->activeBufferDescriptorSetCaches[i];
 
-		VULKAN_INTERNAL_ImageMemoryBarrier(
-			renderer,
-			vulkanCommandBuffer->commandBuffer,
-			RESOURCE_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_WRITE,
-			depthAspectFlags,
-			0,
-			vulkanFramebuffer->depthStencilTarget->texture->layerCount,
-			0,
-			vulkanFramebuffer->depthStencilTarget->texture->levelCount,
-			0,
-			vulkanFramebuffer->depthStencilTarget->texture->image,
-			&vulkanFramebuffer->depthStencilTarget->texture->resourceAccessType
+		VULKAN_INTERNAL_DeactivateUnusedBufferDescriptorSets(
+			submission,
+			bufferDescriptorSetCache
 		);
 
-		clearCount += 1;
+		if (bufferDescriptorSetCache->count == 0)
+		{
+			bufferDescriptorSetCache->active = 0;
+			commandPool->activeBufferDescriptorSetCaches[i] = commandPool->activeBufferDescriptorSetCaches[commandPool->activeBufferDescriptorSetCacheCount - 1];
+			commandPool->activeBufferDescriptorSetCacheCount -= 1;
+		}
 	}
 
-	/* Set clear values */
+	commandPool->descriptorSetResetSubmission = submission;
+}
 
-	clearValues = SDL_stack_alloc(VkClearValue, clearCount);
+static BufferDescriptorSetCache* VULKAN_INTERNAL_FetchBufferDescriptorSetCache(
+	VulkanRenderer *renderer,
+	VulkanCommandPool *commandPool,
+	DescriptorSetCacheInfo *info
+) {
+	uint32_t i;
 
-	for (i = 0; i < colorClearCount; i += 1)
+	if (info->id >= commandPool->bufferDescriptorSetCacheCount)
 	{
-		clearValues[i].color.float32[0] = pColorClearValues[i].x;
-		clearValues[i].color.float32[1] = pColorClearValues[i].y;
-		clearValues[i].color.float32[2] = pColorClearValues[i].z;
-		clearValues[i].color.float32[3] = pColorClearValues[i].w;
+		commandPool->bufferDescriptorSetCaches = SDL_realloc(
+			commandPool->bufferDescriptorSetCaches,
+			sizeof(BufferDescriptorSetCache*) * (info->id + 1)
+		);
+
+		for (i = commandPool->bufferDescriptorSetCacheCount; i <= info->id; i += 1)
+		{
+			commandPool->bufferDescriptorSetCaches[i] = NULL;
+		}
+
+		commandPool->bufferDescriptorSetCacheCount = info->id + 1;
 	}
 
-	if (depthStencilClearValue != NULL)
+	if (commandPool->bufferDescriptorSetCaches[info->id] == NULL)
 	{
-		clearValues[colorClearCount].depthStencil.depth =
-			depthStencilClearValue->depth;
-		clearValues[colorClearCount].depthStencil.stencil =
-			depthStencilClearValue->stencil;
+		commandPool->bufferDescriptorSetCaches[info->id] =
+			VULKAN_INTERNAL_CreateBufferDescriptorSetCache(
+				renderer,
+				info
+			);
 	}
 
-	VkRenderPassBeginInfo renderPassBeginInfo;
-	renderPassBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-	renderPassBeginInfo.pNext = NULL;
-	renderPassBeginInfo.renderPass = (VkRenderPass) renderPass;
-	renderPassBeginInfo.framebuffer = vulkanFramebuffer->framebuffer;
-	renderPassBeginInfo.renderArea.extent.width = renderArea->w;
-	renderPassBeginInfo.renderArea.extent.height = renderArea->h;
-	renderPassBeginInfo.renderArea.offset.x = renderArea->x;
-	renderPassBeginInfo.renderArea.offset.y = renderArea->y;
-	renderPassBeginInfo.pClearValues = clearValues;
-	renderPassBeginInfo.clearValueCount = clearCount;
-
-	renderer->vkCmdBeginRenderPass(
-		vulkanCommandBuffer->commandBuffer,
-		&renderPassBeginInfo,
-		VK_SUBPASS_CONTENTS_INLINE
-	);
-
-	vulkanCommandBuffer->currentFramebuffer = vulkanFramebuffer;
-
-	SDL_stack_free(clearValues);
+	return commandPool->bufferDescriptorSetCaches[info->id];
 }
 
-static void VULKAN_EndRenderPass(
-	Refresh_Renderer *driverData,
-	Refresh_CommandBuffer *commandBuffer
+static ImageDescriptorSetCache* VULKAN_INTERNAL_FetchImageDescriptorSetCache(
+	VulkanRenderer *renderer,
+	VulkanCommandPool *commandPool,
+	DescriptorSetCacheInfo *info
 ) {
-	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
-	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
-	VulkanTexture *currentTexture;
-	VkImageAspectFlags depthAspectFlags;
 	uint32_t i;
 
-	renderer->vkCmdEndRenderPass(
-		vulkanCommandBuffer->commandBuffer
-	);
-
-	for (i = 0; i < vulkanCommandBuffer->currentFramebuffer->colorTargetCount; i += 1)
+	if (info->id >= commandPool->imageDescriptorSetCacheCount)
 	{
-		currentTexture = vulkanCommandBuffer->currentFramebuffer->colorTargets[i]->texture;
+		commandPool->imageDescriptorSetCaches = SDL_realloc(
+			commandPool->imageDescriptorSetCaches,
+			sizeof(ImageDescriptorSetCache*) * (info->id + 1)
+		);
 
-		if (currentTexture->usageFlags & VK_IMAGE_USAGE_SAMPLED_BIT)
+		for (i = commandPool->imageDescriptorSetCacheCount; i <= info->id; i += 1)
 		{
-			VULKAN_INTERNAL_ImageMemoryBarrier(
-				renderer,
-				vulkanCommandBuffer->commandBuffer,
-				RESOURCE_ACCESS_ANY_SHADER_READ_SAMPLED_IMAGE,
-				VK_IMAGE_ASPECT_COLOR_BIT,
-				0,
-				currentTexture->layerCount,
-				0,
-				currentTexture->levelCount,
-				0,
-				currentTexture->image,
-				&currentTexture->resourceAccessType
-			);
+			commandPool->imageDescriptorSetCaches[i] = NULL;
 		}
+
+		commandPool->imageDescriptorSetCacheCount = info->id + 1;
 	}
 
-	if (vulkanCommandBuffer->currentFramebuffer->depthStencilTarget != NULL)
+	if (commandPool->imageDescriptorSetCaches[info->id] == NULL)
 	{
-		currentTexture = vulkanCommandBuffer->currentFramebuffer->depthStencilTarget->texture;
-
-		if (currentTexture->usageFlags & VK_IMAGE_USAGE_SAMPLED_BIT)
-		{
-			depthAspectFlags = VK_IMAGE_ASPECT_DEPTH_BIT;
-
-			if (IsStencilFormat(
-				currentTexture->format
-			)) {
-				depthAspectFlags |= VK_IMAGE_ASPECT_STENCIL_BIT;
-			}
-
-			VULKAN_INTERNAL_ImageMemoryBarrier(
+		commandPool->imageDescriptorSetCaches[info->id] =
+			VULKAN_INTERNAL_CreateImageDescriptorSetCache(
 				renderer,
-				vulkanCommandBuffer->commandBuffer,
-				RESOURCE_ACCESS_ANY_SHADER_READ_SAMPLED_IMAGE,
-				depthAspectFlags,
-				0,
-				currentTexture->layerCount,
-				0,
-				currentTexture->levelCount,
-				0,
-				currentTexture->image,
-				&currentTexture->resourceAccessType
+				info
 			);
-		}
 	}
 
-	vulkanCommandBuffer->currentGraphicsPipeline = NULL;
-	vulkanCommandBuffer->currentFramebuffer = NULL;
+	return commandPool->imageDescriptorSetCaches[info->id];
 }
 
-static void VULKAN_BindGraphicsPipeline(
-	Refresh_Renderer *driverData,
-	Refresh_CommandBuffer *commandBuffer,
-	Refresh_GraphicsPipeline *graphicsPipeline
+/* FIXME: this can probably be cleverly folded into the same cache structure as image descriptors */
+static VkDescriptorSet VULKAN_INTERNAL_FetchBufferDescriptorSet(
+	VulkanRenderer *renderer,
+	VulkanCommandPool *commandPool,
+	DescriptorSetCacheInfo *info,
+	BufferDescriptorSetData *bufferDescriptorSetData
 ) {
-	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
-	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
-	VulkanGraphicsPipeline* pipeline = (VulkanGraphicsPipeline*) graphicsPipeline;
+	BufferDescriptorSetCache *bufferDescriptorSetCache;
+	uint32_t i, mask, slot, element;
+	uint32_t submission;
+	uint64_t hashcode;
+	VkDescriptorSet newDescriptorSet;
+	BufferDescriptorSetHashMap *map;
 
-	/* bind dummy sets */
-	if (pipeline->pipelineLayout->vertexSamplerDescriptorSetCache == NULL)
+	/* Caches are only touched by the owning thread, so no lock is needed */
+	if (SDL_AtomicGet(&commandPool->expirationPending))
 	{
-		pipeline->vertexSamplerDescriptorSet = renderer->emptyVertexSamplerDescriptorSet;
+		VULKAN_INTERNAL_ApplyDescriptorSetExpirations(commandPool);
 	}
 
-	if (pipeline->pipelineLayout->fragmentSamplerDescriptorSetCache == NULL)
+	submission = (uint32_t) SDL_AtomicGet(&renderer->recordingSubmission);
+
+	if (commandPool->descriptorSetResetSubmission != submission)
 	{
-		pipeline->fragmentSamplerDescriptorSet = renderer->emptyFragmentSamplerDescriptorSet;
+		VULKAN_INTERNAL_ResetDescriptorSetData(commandPool, submission);
 	}
 
-	renderer->vkCmdBindPipeline(
-		vulkanCommandBuffer->commandBuffer,
-		VK_PIPELINE_BIND_POINT_GRAPHICS,
-		pipeline->pipeline
+	bufferDescriptorSetCache = VULKAN_INTERNAL_FetchBufferDescriptorSetCache(
+		renderer,
+		commandPool,
+		info
 	);
 
-	vulkanCommandBuffer->currentGraphicsPipeline = pipeline;
+	hashcode = BufferDescriptorSetHashTable_GetHashCode(
+		bufferDescriptorSetData,
+		bufferDescriptorSetCache->bindingCount
+	);
+	mask = bufferDescriptorSetCache->index.slotCount - 1;
+	slot = (uint32_t) hashcode & mask;
+
+	while (bufferDescriptorSetCache->index.slots[slot].element != DESCRIPTOR_SET_INDEX_EMPTY)
+	{
+		if (bufferDescriptorSetCache->index.slots[slot].key == hashcode)
+		{
+			BufferDescriptorSetHashMap *e;
+
+			element = bufferDescriptorSetCache->index.slots[slot].element;
+			e = &bufferDescriptorSetCache->elements[element];
+
+			if (BufferDescriptorSetDataEqual(
+				bufferDescriptorSetData,
+				&e->descriptorSetData,
+				bufferDescriptorSetCache->bindingCount
+			)) {
+				e->lastUsedSubmission = submission + 1;
+
+				if (bufferDescriptorSetCache->lruTail != element)
+				{
+					DESCRIPTOR_SET_LRU_UNLINK(bufferDescriptorSetCache, element);
+					DESCRIPTOR_SET_LRU_APPEND(bufferDescriptorSetCache, element);
+				}
+
+				return e->descriptorSet;
+			}
+		}
+
+		slot = (slot + 1) & mask;
+	}
+
+	/* If no match exists, assign a new descriptor set and prepare it for update */
+	/* If no inactive descriptor sets remain, create a new pool and allocate new inactive sets */
+
+	if (bufferDescriptorSetCache->inactiveDescriptorSetCount == 0)
+	{
+		bufferDescriptorSetCache->bufferDescriptorPoolCount += 1;
+		bufferDescriptorSetCache->bufferDescriptorPools = SDL_realloc(
+			bufferDescriptorSetCache->bufferDescriptorPools,
+			sizeof(VkDescriptorPool) * bufferDescriptorSetCache->bufferDescriptorPoolCount
+		);
+
+		VULKAN_INTERNAL_CreateDescriptorPool(
+			renderer,
+			VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+			bufferDescriptorSetCache->nextPoolSize,
+			bufferDescriptorSetCache->nextPoolSize * bufferDescriptorSetCache->bindingCount,
+			&bufferDescriptorSetCache->bufferDescriptorPools[bufferDescriptorSetCache->bufferDescriptorPoolCount - 1]
+		);
+
+		bufferDescriptorSetCache->inactiveDescriptorSetCapacity += bufferDescriptorSetCache->nextPoolSize;
+
+		bufferDescriptorSetCache->inactiveDescriptorSets = SDL_realloc(
+			bufferDescriptorSetCache->inactiveDescriptorSets,
+			sizeof(VkDescriptorSet) * bufferDescriptorSetCache->inactiveDescriptorSetCapacity
+		);
+
+		VULKAN_INTERNAL_AllocateDescriptorSets(
+			renderer,
+			bufferDescriptorSetCache->bufferDescriptorPools[bufferDescriptorSetCache->bufferDescriptorPoolCount - 1],
+			bufferDescriptorSetCache->descriptorSetLayout,
+			bufferDescriptorSetCache->nextPoolSize,
+			bufferDescriptorSetCache->inactiveDescriptorSets
+		);
+
+		bufferDescriptorSetCache->inactiveDescriptorSetCount = bufferDescriptorSetCache->nextPoolSize;
+
+		bufferDescriptorSetCache->nextPoolSize *= 2;
+	}
+
+	newDescriptorSet = bufferDescriptorSetCache->inactiveDescriptorSets[bufferDescriptorSetCache->inactiveDescriptorSetCount - 1];
+	bufferDescriptorSetCache->inactiveDescriptorSetCount -= 1;
+
+	VULKAN_INTERNAL_UpdateCachedDescriptorSet(
+		renderer,
+		newDescriptorSet,
+		bufferDescriptorSetCache->descriptorUpdateTemplate,
+		bufferDescriptorSetCache->descriptorType,
+		bufferDescriptorSetCache->bindingCount,
+		NULL,
+		bufferDescriptorSetData->descriptorBufferInfo
+	);
+
+	DescriptorSetIndex_Insert(
+		&bufferDescriptorSetCache->index,
+		hashcode,
+		bufferDescriptorSetCache->count
+	);
+
+	if (bufferDescriptorSetCache->count == bufferDescriptorSetCache->capacity)
+	{
+		bufferDescriptorSetCache->capacity *= 2;
+
+		bufferDescriptorSetCache->elements = SDL_realloc(
+			bufferDescriptorSetCache->elements,
+			sizeof(BufferDescriptorSetHashMap) * bufferDescriptorSetCache->capacity
+		);
+	}
+
+	map = &bufferDescriptorSetCache->elements[bufferDescriptorSetCache->count];
+	map->key = hashcode;
+
+	for (i = 0; i < bufferDescriptorSetCache->bindingCount; i += 1)
+	{
+		map->descriptorSetData.descriptorBufferInfo[i].buffer =
+			bufferDescriptorSetData->descriptorBufferInfo[i].buffer;
+		map->descriptorSetData.descriptorBufferInfo[i].offset =
+			bufferDescriptorSetData->descriptorBufferInfo[i].offset;
+		map->descriptorSetData.descriptorBufferInfo[i].range =
+			bufferDescriptorSetData->descriptorBufferInfo[i].range;
+	}
+
+	map->descriptorSet = newDescriptorSet;
+	map->lastUsedSubmission = submission + 1;
+	map->indexed = 1;
+	DESCRIPTOR_SET_LRU_APPEND(bufferDescriptorSetCache, bufferDescriptorSetCache->count);
+	bufferDescriptorSetCache->count += 1;
+
+	if (!bufferDescriptorSetCache->active)
+	{
+		EXPAND_ARRAY_IF_NEEDED(
+			commandPool->activeBufferDescriptorSetCaches,
+			BufferDescriptorSetCache*,
+			commandPool->activeBufferDescriptorSetCacheCount + 1,
+			commandPool->activeBufferDescriptorSetCacheCapacity,
+			commandPool->activeBufferDescriptorSetCacheCapacity * 2
+		);
+
+		commandPool->activeBufferDescriptorSetCaches[commandPool->activeBufferDescriptorSetCacheCount] = bufferDescriptorSetCache;
+		commandPool->activeBufferDescriptorSetCacheCount += 1;
+		bufferDescriptorSetCache->active = 1;
+	}
+
+	return newDescriptorSet;
+}
+
+static inline uint8_t ImageDescriptorSetDataEqual(
+	ImageDescriptorSetData *a,
+	ImageDescriptorSetData *b,
+	uint8_t bindingCount
+) {
+	uint32_t i;
+
+	for (i = 0; i < bindingCount; i += 1)
+	{
+		if (	a->descriptorImageInfo[i].imageLayout != b->descriptorImageInfo[i].imageLayout ||
+			a->descriptorImageInfo[i].imageView != b->descriptorImageInfo[i].imageView ||
+			a->descriptorImageInfo[i].sampler != b->descriptorImageInfo[i].sampler	)
+		{
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+static VkDescriptorSet VULKAN_INTERNAL_FetchImageDescriptorSet(
+	VulkanRenderer *renderer,
+	VulkanCommandPool *commandPool,
+	DescriptorSetCacheInfo *info,
+	ImageDescriptorSetData *imageDescriptorSetData
+) {
+	ImageDescriptorSetCache *imageDescriptorSetCache;
+	uint32_t i, mask, slot, element;
+	uint32_t submission;
+	uint64_t hashcode;
+	VkDescriptorSet newDescriptorSet;
+	ImageDescriptorSetHashMap *map;
+
+	/* Caches are only touched by the owning thread, so no lock is needed */
+	if (SDL_AtomicGet(&commandPool->expirationPending))
+	{
+		VULKAN_INTERNAL_ApplyDescriptorSetExpirations(commandPool);
+	}
+
+	submission = (uint32_t) SDL_AtomicGet(&renderer->recordingSubmission);
+
+	if (commandPool->descriptorSetResetSubmission != submission)
+	{
+		VULKAN_INTERNAL_ResetDescriptorSetData(commandPool, submission);
+	}
+
+	imageDescriptorSetCache = VULKAN_INTERNAL_FetchImageDescriptorSetCache(
+		renderer,
+		commandPool,
+		info
+	);
+
+	hashcode = ImageDescriptorSetHashTable_GetHashCode(
+		imageDescriptorSetData,
+		imageDescriptorSetCache->bindingCount
+	);
+	mask = imageDescriptorSetCache->index.slotCount - 1;
+	slot = (uint32_t) hashcode & mask;
+
+	while (imageDescriptorSetCache->index.slots[slot].element != DESCRIPTOR_SET_INDEX_EMPTY)
+	{
+		if (imageDescriptorSetCache->index.slots[slot].key == hashcode)
+		{
+			ImageDescriptorSetHashMap *e;
+
+			element = imageDescriptorSetCache->index.slots[slot].element;
+			e = &imageDescriptorSetCache->elements[element];
+
+			if (ImageDescriptorSetDataEqual(
+				imageDescriptorSetData,
+				&e->descriptorSetData,
+				imageDescriptorSetCache->bindingCount
+			)) {
+				e->lastUsedSubmission = submission + 1;
+
+				if (imageDescriptorSetCache->lruTail != element)
+				{
+					DESCRIPTOR_SET_LRU_UNLINK(imageDescriptorSetCache, element);
+					DESCRIPTOR_SET_LRU_APPEND(imageDescriptorSetCache, element);
+				}
+
+				return e->descriptorSet;
+			}
+		}
+
+		slot = (slot + 1) & mask;
+	}
+
+	/* If no match exists, assign a new descriptor set and prepare it for update */
+	/* If no inactive descriptor sets remain, create a new pool and allocate new inactive sets */
+
+	if (imageDescriptorSetCache->inactiveDescriptorSetCount == 0)
+	{
+		imageDescriptorSetCache->imageDescriptorPoolCount += 1;
+		imageDescriptorSetCache->imageDescriptorPools = SDL_realloc(
+			imageDescriptorSetCache->imageDescriptorPools,
+			sizeof(VkDescriptorPool) * imageDescriptorSetCache->imageDescriptorPoolCount
+		);
+
+		VULKAN_INTERNAL_CreateDescriptorPool(
+			renderer,
+			imageDescriptorSetCache->descriptorType,
+			imageDescriptorSetCache->nextPoolSize,
+			imageDescriptorSetCache->nextPoolSize * imageDescriptorSetCache->bindingCount,
+			&imageDescriptorSetCache->imageDescriptorPools[imageDescriptorSetCache->imageDescriptorPoolCount - 1]
+		);
+
+		imageDescriptorSetCache->inactiveDescriptorSetCapacity += imageDescriptorSetCache->nextPoolSize;
+
+		imageDescriptorSetCache->inactiveDescriptorSets = SDL_realloc(
+			imageDescriptorSetCache->inactiveDescriptorSets,
+			sizeof(VkDescriptorSet) * imageDescriptorSetCache->inactiveDescriptorSetCapacity
+		);
+
+		VULKAN_INTERNAL_AllocateDescriptorSets(
+			renderer,
+			imageDescriptorSetCache->imageDescriptorPools[imageDescriptorSetCache->imageDescriptorPoolCount - 1],
+			imageDescriptorSetCache->descriptorSetLayout,
+			imageDescriptorSetCache->nextPoolSize,
+			imageDescriptorSetCache->inactiveDescriptorSets
+		);
+
+		imageDescriptorSetCache->inactiveDescriptorSetCount = imageDescriptorSetCache->nextPoolSize;
+
+		imageDescriptorSetCache->nextPoolSize *= 2;
+	}
+
+	newDescriptorSet = imageDescriptorSetCache->inactiveDescriptorSets[imageDescriptorSetCache->inactiveDescriptorSetCount - 1];
+	imageDescriptorSetCache->inactiveDescriptorSetCount -= 1;
+
+	VULKAN_INTERNAL_UpdateCachedDescriptorSet(
+		renderer,
+		newDescriptorSet,
+		imageDescriptorSetCache->descriptorUpdateTemplate,
+		imageDescriptorSetCache->descriptorType,
+		imageDescriptorSetCache->bindingCount,
+		imageDescriptorSetData->descriptorImageInfo,
+		NULL
+	);
+
+	DescriptorSetIndex_Insert(
+		&imageDescriptorSetCache->index,
+		hashcode,
+		imageDescriptorSetCache->count
+	);
+
+	if (imageDescriptorSetCache->count == imageDescriptorSetCache->capacity)
+	{
+		imageDescriptorSetCache->capacity *= 2;
+
+		imageDescriptorSetCache->elements = SDL_realloc(
+			imageDescriptorSetCache->elements,
+			sizeof(ImageDescriptorSetHashMap) * imageDescriptorSetCache->capacity
+		);
+	}
+
+	map = &imageDescriptorSetCache->elements[imageDescriptorSetCache->count];
+	map->key = hashcode;
+
+	for (i = 0; i < imageDescriptorSetCache->bindingCount; i += 1)
+	{
+		map->descriptorSetData.descriptorImageInfo[i].imageLayout =
+			imageDescriptorSetData->descriptorImageInfo[i].imageLayout;
+		map->descriptorSetData.descriptorImageInfo[i].imageView =
+			imageDescriptorSetData->descriptorImageInfo[i].imageView;
+		map->descriptorSetData.descriptorImageInfo[i].sampler =
+			imageDescriptorSetData->descriptorImageInfo[i].sampler;
+	}
+
+	map->descriptorSet = newDescriptorSet;
+	map->lastUsedSubmission = submission + 1;
+	map->indexed = 1;
+	DESCRIPTOR_SET_LRU_APPEND(imageDescriptorSetCache, imageDescriptorSetCache->count);
+	imageDescriptorSetCache->count += 1;
+
+	if (!imageDescriptorSetCache->active)
+	{
+		EXPAND_ARRAY_IF_NEEDED(
+			commandPool->activeImageDescriptorSetCaches,
+			ImageDescriptorSetCache*,
+			commandPool->activeImageDescriptorSetCacheCount + 1,
+			commandPool->activeImageDescriptorSetCacheCapacity,
+			commandPool->activeImageDescriptorSetCacheCapacity * 2
+		);
+
+		commandPool->activeImageDescriptorSetCaches[commandPool->activeImageDescriptorSetCacheCount] = imageDescriptorSetCache;
+		commandPool->activeImageDescriptorSetCacheCount += 1;
+		imageDescriptorSetCache->active = 1;
+	}
+
+	return newDescriptorSet;
+}
+
+static void VULKAN_BindVertexSamplers(
+	Refresh_Renderer *driverData,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_Texture **pTextures,
+	Refresh_Sampler **pSamplers
+) {
+	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
+	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+	VulkanGraphicsPipeline *graphicsPipeline = vulkanCommandBuffer->currentGraphicsPipeline;
+
+	VulkanTexture *currentTexture;
+	uint32_t i, samplerCount;
+	ImageDescriptorSetData vertexSamplerDescriptorSetData;
+
+	if (graphicsPipeline->pipelineLayout->vertexSamplerDescriptorSetCacheInfo == NULL)
+	{
+		return;
+	}
+
+	samplerCount = graphicsPipeline->pipelineLayout->vertexSamplerDescriptorSetCacheInfo->bindingCount;
+
+	for (i = 0; i < samplerCount; i += 1)
+	{
+		currentTexture = (VulkanTexture*) pTextures[i];
+		VULKAN_INTERNAL_TrackTexture(renderer, vulkanCommandBuffer, currentTexture);
+		vertexSamplerDescriptorSetData.descriptorImageInfo[i].imageView = currentTexture->view;
+		vertexSamplerDescriptorSetData.descriptorImageInfo[i].sampler = (VkSampler) pSamplers[i];
+		vertexSamplerDescriptorSetData.descriptorImageInfo[i].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+	}
+
+	vulkanCommandBuffer->vertexSamplerDescriptorSet = VULKAN_INTERNAL_FetchImageDescriptorSet(
+		renderer,
+		vulkanCommandBuffer->commandPool,
+		graphicsPipeline->pipelineLayout->vertexSamplerDescriptorSetCacheInfo,
+		&vertexSamplerDescriptorSetData
+	);
+}
+
+static void VULKAN_BindFragmentSamplers(
+	Refresh_Renderer *driverData,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_Texture **pTextures,
+	Refresh_Sampler **pSamplers
+) {
+	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
+	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+	VulkanGraphicsPipeline *graphicsPipeline = vulkanCommandBuffer->currentGraphicsPipeline;
+	VulkanTexture *currentTexture;
+
+	uint32_t i, samplerCount;
+	ImageDescriptorSetData fragmentSamplerDescriptorSetData;
+
+	if (graphicsPipeline->pipelineLayout->fragmentSamplerDescriptorSetCacheInfo == NULL)
+	{
+		return;
+	}
+
+	samplerCount = graphicsPipeline->pipelineLayout->fragmentSamplerDescriptorSetCacheInfo->bindingCount;
+
+	for (i = 0; i < samplerCount; i += 1)
+	{
+		currentTexture = (VulkanTexture*) pTextures[i];
+		VULKAN_INTERNAL_TrackTexture(renderer, vulkanCommandBuffer, currentTexture);
+		fragmentSamplerDescriptorSetData.descriptorImageInfo[i].imageView = currentTexture->view;
+		fragmentSamplerDescriptorSetData.descriptorImageInfo[i].sampler = (VkSampler) pSamplers[i];
+		fragmentSamplerDescriptorSetData.descriptorImageInfo[i].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+	}
+
+	vulkanCommandBuffer->fragmentSamplerDescriptorSet = VULKAN_INTERNAL_FetchImageDescriptorSet(
+		renderer,
+		vulkanCommandBuffer->commandPool,
+		graphicsPipeline->pipelineLayout->fragmentSamplerDescriptorSetCacheInfo,
+		&fragmentSamplerDescriptorSetData
+	);
+}
+
+/* Static buffers aren't host visible, so copy out through the staging
+ * buffer. Hard sync point!
+ */
+static void VULKAN_INTERNAL_ReadStaticBufferData(
+	VulkanRenderer *renderer,
+	VulkanBuffer *buffer,
+	void *data,
+	VkDeviceSize dataLength
+) {
+	VkCommandBuffer commandBuffer;
+	VkBufferCopy bufferCopy;
+	VulkanResourceAccessType prevResourceAccess;
+	VkDeviceSize stagingOffset;
+
+	SDL_LockMutex(renderer->stagingLock);
+
+	VULKAN_INTERNAL_MaybeExpandStagingBuffer(renderer, dataLength);
+	VULKAN_INTERNAL_MaybeBeginTransferCommandBuffer(renderer);
+
+	commandBuffer = renderer->transferCommandBuffers[renderer->frameIndex];
+	stagingOffset = renderer->textureStagingBufferOffset;
+	prevResourceAccess = buffer->resourceAccessType;
+
+	VULKAN_INTERNAL_BufferMemoryBarrier(
+		renderer,
+		commandBuffer,
+		RESOURCE_ACCESS_TRANSFER_READ,
+		buffer,
+		buffer->subBuffers[0]
+	);
+
+	bufferCopy.srcOffset = buffer->subBuffers[0]->bufferOffset;
+	bufferCopy.dstOffset = stagingOffset;
+	bufferCopy.size = dataLength;
+
+	renderer->vkCmdCopyBuffer(
+		commandBuffer,
+		buffer->subBuffers[0]->buffer,
+		renderer->textureStagingBuffers[renderer->frameIndex]->subBuffers[0]->buffer,
+		1,
+		&bufferCopy
+	);
+
+	VULKAN_INTERNAL_BufferMemoryBarrier(
+		renderer,
+		commandBuffer,
+		prevResourceAccess,
+		buffer,
+		buffer->subBuffers[0]
+	);
+
+	VULKAN_INTERNAL_FlushTransfers(renderer);
+
+	SDL_memcpy(
+		data,
+		renderer->textureStagingBuffers[renderer->frameIndex]->subBuffers[0]->allocation->mapPointer +
+			renderer->textureStagingBuffers[renderer->frameIndex]->subBuffers[0]->offset +
+			stagingOffset,
+		dataLength
+	);
+
+	SDL_UnlockMutex(renderer->stagingLock);
+}
+
+static void VULKAN_GetBufferData(
+	Refresh_Renderer *driverData,
+	Refresh_Buffer *buffer,
+	void *data,
+	uint32_t dataLengthInBytes
+) {
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+	VulkanBuffer *vulkanBuffer = (VulkanBuffer*) buffer;
+	uint8_t *dataPtr = (uint8_t*) data;
+	uint8_t *mapPointer;
+
+	if (vulkanBuffer->memoryUsage == VULKAN_BUFFER_MEMORY_DEVICE)
+	{
+		VULKAN_INTERNAL_ReadStaticBufferData(
+			renderer,
+			vulkanBuffer,
+			data,
+			dataLengthInBytes
+		);
+		return;
+	}
+
+	VULKAN_INTERNAL_InvalidateSubBuffer(
+		renderer,
+		vulkanBuffer->subBuffers[vulkanBuffer->currentSubBufferIndex],
+		0,
+		dataLengthInBytes
+	);
+
+	mapPointer =
+		vulkanBuffer->subBuffers[vulkanBuffer->currentSubBufferIndex]->allocation->mapPointer +
+		vulkanBuffer->subBuffers[vulkanBuffer->currentSubBufferIndex]->offset;
+
+	SDL_memcpy(
+		dataPtr,
+		mapPointer,
+		dataLengthInBytes
+	);
+}
+
+/* Finds the smallest idle pooled readback that fits, or makes a new one */
+static VulkanBufferReadback* VULKAN_INTERNAL_AcquireReadback(
+	VulkanRenderer *renderer,
+	VkDeviceSize size
+) {
+	VulkanBufferReadback *readback = NULL;
+	uint32_t i;
+
+	SDL_LockMutex(renderer->readbackLock);
+
+	for (i = 0; i < renderer->readbackCount; i += 1)
+	{
+		if (	!renderer->readbacks[i]->inUse &&
+			renderer->readbacks[i]->buffer->size >= size &&
+			(readback == NULL || renderer->readbacks[i]->buffer->size < readback->buffer->size)	)
+		{
+			readback = renderer->readbacks[i];
+		}
+	}
+
+	if (readback != NULL)
+	{
+		readback->inUse = 1;
+		SDL_UnlockMutex(renderer->readbackLock);
+		return readback;
+	}
+
+	SDL_UnlockMutex(renderer->readbackLock);
+
+	readback = (VulkanBufferReadback*) SDL_malloc(sizeof(VulkanBufferReadback));
+	readback->buffer = (VulkanBuffer*) SDL_malloc(sizeof(VulkanBuffer));
+
+	if (VULKAN_INTERNAL_CreateBuffer(
+		renderer,
+		VULKAN_INTERNAL_NextHighestAlignment(size, READBACK_BUFFER_MIN_SIZE),
+		RESOURCE_ACCESS_HOST_READ,
+		VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+		1,
+		VULKAN_BUFFER_MEMORY_READBACK,
+		readback->buffer
+	) != 1) {
+		Refresh_LogError("Failed to create readback buffer!");
+		SDL_free(readback->buffer);
+		SDL_free(readback);
+		return NULL;
+	}
+
+	readback->inUse = 1;
+
+	SDL_LockMutex(renderer->readbackLock);
+
+	EXPAND_ARRAY_IF_NEEDED(
+		renderer->readbacks,
+		VulkanBufferReadback*,
+		renderer->readbackCount + 1,
+		renderer->readbackCapacity,
+		renderer->readbackCapacity * 2
+	)
+
+	renderer->readbacks[renderer->readbackCount] = readback;
+	renderer->readbackCount += 1;
+
+	SDL_UnlockMutex(renderer->readbackLock);
+
+	return readback;
+}
+
+static Refresh_BufferReadback* VULKAN_GetBufferDataAsync(
+	Refresh_Renderer *driverData,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_Buffer *buffer,
+	uint32_t offsetInBytes,
+	uint32_t dataLengthInBytes
+) {
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+	VulkanBuffer *vulkanBuffer = (VulkanBuffer*) buffer;
+	VulkanSubBuffer *subBuffer;
+	VulkanBufferReadback *readback;
+	VulkanResourceAccessType prevResourceAccess;
+	VkBufferCopy bufferCopy;
+
+	if (dataLengthInBytes == 0)
+	{
+		Refresh_LogError("Readback size must not be zero!");
+		return NULL;
+	}
+
+	if (	offsetInBytes > vulkanBuffer->size ||
+		dataLengthInBytes > vulkanBuffer->size - offsetInBytes	)
+	{
+		Refresh_LogError("Readback range exceeds buffer size!");
+		return NULL;
+	}
+
+	readback = VULKAN_INTERNAL_AcquireReadback(renderer, dataLengthInBytes);
+
+	if (readback == NULL)
+	{
+		return NULL;
+	}
+
+	readback->size = dataLengthInBytes;
+	readback->commandBuffer = vulkanCommandBuffer;
+	readback->submission = 0;
+
+	/* Keep the sub-buffer alive and in place until the copy executes */
+	VULKAN_INTERNAL_MarkAsBound(renderer, vulkanBuffer);
+	subBuffer = vulkanBuffer->subBuffers[vulkanBuffer->currentSubBufferIndex];
+
+	prevResourceAccess = vulkanBuffer->resourceAccessType;
+
+	VULKAN_INTERNAL_BufferMemoryBarrier(
+		renderer,
+		vulkanCommandBuffer->commandBuffer,
+		RESOURCE_ACCESS_TRANSFER_READ,
+		vulkanBuffer,
+		subBuffer
+	);
+
+	VULKAN_INTERNAL_BufferMemoryBarrier(
+		renderer,
+		vulkanCommandBuffer->commandBuffer,
+		RESOURCE_ACCESS_TRANSFER_WRITE,
+		readback->buffer,
+		readback->buffer->subBuffers[0]
+	);
+
+	bufferCopy.srcOffset = subBuffer->bufferOffset + offsetInBytes;
+	bufferCopy.dstOffset = readback->buffer->subBuffers[0]->bufferOffset;
+	bufferCopy.size = dataLengthInBytes;
+
+	renderer->vkCmdCopyBuffer(
+		vulkanCommandBuffer->commandBuffer,
+		subBuffer->buffer,
+		readback->buffer->subBuffers[0]->buffer,
+		1,
+		&bufferCopy
+	);
+
+	/* Make the copy visible to the host once the fence signals */
+	VULKAN_INTERNAL_BufferMemoryBarrier(
+		renderer,
+		vulkanCommandBuffer->commandBuffer,
+		RESOURCE_ACCESS_HOST_READ,
+		readback->buffer,
+		readback->buffer->subBuffers[0]
+	);
+
+	VULKAN_INTERNAL_BufferMemoryBarrier(
+		renderer,
+		vulkanCommandBuffer->commandBuffer,
+		prevResourceAccess,
+		vulkanBuffer,
+		subBuffer
+	);
+
+	return (Refresh_BufferReadback*) readback;
+}
+
+static uint8_t VULKAN_QueryBufferReadback(
+	Refresh_Renderer *driverData,
+	Refresh_BufferReadback *readback,
+	void *data
+) {
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+	VulkanBufferReadback *vulkanReadback = (VulkanBufferReadback*) readback;
+	VulkanSubBuffer *subBuffer = vulkanReadback->buffer->subBuffers[0];
+	uint64_t submission;
+	uint32_t i;
+
+	SDL_LockMutex(renderer->readbackLock);
+	submission = vulkanReadback->submission;
+	SDL_UnlockMutex(renderer->readbackLock);
+
+	/* Not submitted yet */
+	if (submission == 0)
+	{
+		return 0;
+	}
+
+	/* Submissions no longer held by a frame were already waited on */
+	for (i = 0; i < renderer->framesInFlight; i += 1)
+	{
+		if (	renderer->frames[i].submission == submission &&
+			renderer->vkGetFenceStatus(
+				renderer->logicalDevice,
+				renderer->inFlightFences[i]
+			) != VK_SUCCESS	)
+		{
+			return 0;
+		}
+	}
+
+	VULKAN_INTERNAL_InvalidateSubBuffer(
+		renderer,
+		subBuffer,
+		0,
+		vulkanReadback->size
+	);
+
+	SDL_memcpy(
+		data,
+		subBuffer->allocation->mapPointer + subBuffer->offset,
+		vulkanReadback->size
+	);
+
+	SDL_LockMutex(renderer->readbackLock);
+	vulkanReadback->inUse = 0;
+	SDL_UnlockMutex(renderer->readbackLock);
+
+	return 1;
+}
+
+static void VULKAN_CopyTextureToBuffer(
+	Refresh_Renderer *driverData,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_TextureSlice *textureSlice,
+	Refresh_Buffer *buffer
+) {
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+	VulkanTexture *vulkanTexture = (VulkanTexture*) textureSlice->texture;
+	VulkanBuffer *vulkanBuffer = (VulkanBuffer*) buffer;
+
+	VulkanResourceAccessType prevResourceAccess;
+	VkBufferImageCopy imageCopy;
+
+	VULKAN_INTERNAL_TrackTexture(renderer, vulkanCommandBuffer, vulkanTexture);
+
+	/* Cache this so we can restore it later */
+	prevResourceAccess = vulkanTexture->resourceAccessType;
+
+	VULKAN_INTERNAL_ImageMemoryBarrier(
+		renderer,
+		vulkanCommandBuffer->commandBuffer,
+		RESOURCE_ACCESS_TRANSFER_READ,
+		VK_IMAGE_ASPECT_COLOR_BIT,
+		textureSlice->layer,
+		1,
+		textureSlice->level,
+		1,
+		0,
+		vulkanTexture->image,
+		&vulkanTexture->resourceAccessType
+	);
+
+	/* Save texture data to buffer */
+
+	imageCopy.imageExtent.width = textureSlice->rectangle.w;
+	imageCopy.imageExtent.height = textureSlice->rectangle.h;
+	imageCopy.imageExtent.depth = 1;
+	imageCopy.bufferRowLength = textureSlice->rectangle.w;
+	imageCopy.bufferImageHeight = textureSlice->rectangle.h;
+	imageCopy.imageOffset.x = textureSlice->rectangle.x;
+	imageCopy.imageOffset.y = textureSlice->rectangle.y;
+	imageCopy.imageOffset.z = textureSlice->depth;
+	imageCopy.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+	imageCopy.imageSubresource.baseArrayLayer = textureSlice->layer;
+	imageCopy.imageSubresource.layerCount = 1;
+	imageCopy.imageSubresource.mipLevel = textureSlice->level;
+	imageCopy.bufferOffset = vulkanBuffer->subBuffers[vulkanBuffer->currentSubBufferIndex]->bufferOffset;
+
+	renderer->vkCmdCopyImageToBuffer(
+		vulkanCommandBuffer->commandBuffer,
+		vulkanTexture->image,
+		AccessMap[vulkanTexture->resourceAccessType].imageLayout,
+		vulkanBuffer->subBuffers[vulkanBuffer->currentSubBufferIndex]->buffer,
+		1,
+		&imageCopy
+	);
+
+	/* Restore the image layout */
+
+	VULKAN_INTERNAL_ImageMemoryBarrier(
+		renderer,
+		vulkanCommandBuffer->commandBuffer,
+		prevResourceAccess,
+		VK_IMAGE_ASPECT_COLOR_BIT,
+		textureSlice->layer,
+		1,
+		textureSlice->level,
+		1,
+		0,
+		vulkanTexture->image,
+		&vulkanTexture->resourceAccessType
+	);
+}
+
+static void VULKAN_CopyBufferToBuffer(
+	Refresh_Renderer *driverData,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_Buffer *source,
+	Refresh_Buffer *destination,
+	Refresh_BufferCopy *pRegions,
+	uint32_t regionCount
+) {
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+	VulkanBuffer *srcBuffer = (VulkanBuffer*) source;
+	VulkanBuffer *dstBuffer = (VulkanBuffer*) destination;
+	VulkanSubBuffer *srcSubBuffer, *dstSubBuffer;
+	VulkanResourceAccessType prevResourceAccess;
+	VkBufferCopy *bufferCopies;
+	uint32_t i, j;
+
+	if (regionCount == 0)
+	{
+		Refresh_LogError("Buffer copy needs at least one region!");
+		return;
+	}
+
+	for (i = 0; i < regionCount; i += 1)
+	{
+		if (pRegions[i].size == 0)
+		{
+			Refresh_LogError("Buffer copy region size must not be zero!");
+			return;
+		}
+
+		/* Written this way so offset + size cannot wrap */
+		if (	pRegions[i].srcOffset > srcBuffer->size ||
+			pRegions[i].size > srcBuffer->size - pRegions[i].srcOffset ||
+			pRegions[i].dstOffset > dstBuffer->size ||
+			pRegions[i].size > dstBuffer->size - pRegions[i].dstOffset	)
+		{
+			Refresh_LogError("Buffer copy region exceeds buffer size!");
+			return;
+		}
+	}
+
+	/* vkCmdCopyBuffer forbids any source range overlapping any destination range */
+	if (srcBuffer == dstBuffer)
+	{
+		for (i = 0; i < regionCount; i += 1)
+		{
+			for (j = 0; j < regionCount; j += 1)
+			{
+				if (	pRegions[i].srcOffset < (VkDeviceSize) pRegions[j].dstOffset + pRegions[j].size &&
+					pRegions[j].dstOffset < (VkDeviceSize) pRegions[i].srcOffset + pRegions[i].size	)
+				{
+					Refresh_LogError("Buffer copy regions within one buffer must not overlap!");
+					return;
+				}
+			}
+		}
+	}
+
+	/* Keep both sub-buffers alive and in place until the copy executes */
+	VULKAN_INTERNAL_MarkAsBound(renderer, srcBuffer);
+	VULKAN_INTERNAL_MarkAsBound(renderer, dstBuffer);
+
+	srcSubBuffer = srcBuffer->subBuffers[srcBuffer->currentSubBufferIndex];
+	dstSubBuffer = dstBuffer->subBuffers[dstBuffer->currentSubBufferIndex];
+
+	/* Cache this so we can restore it later */
+	prevResourceAccess = srcBuffer->resourceAccessType;
+
+	VULKAN_INTERNAL_BufferMemoryBarrier(
+		renderer,
+		vulkanCommandBuffer->commandBuffer,
+		RESOURCE_ACCESS_TRANSFER_READ,
+		srcBuffer,
+		srcSubBuffer
+	);
+
+	/* For a copy within one buffer this makes it a transfer read-write */
+	VULKAN_INTERNAL_BufferMemoryBarrier(
+		renderer,
+		vulkanCommandBuffer->commandBuffer,
+		(srcBuffer == dstBuffer) ?
+			RESOURCE_ACCESS_MEMORY_TRANSFER_READ_WRITE :
+			RESOURCE_ACCESS_TRANSFER_WRITE,
+		dstBuffer,
+		dstSubBuffer
+	);
+
+	bufferCopies = SDL_stack_alloc(VkBufferCopy, regionCount);
+
+	for (i = 0; i < regionCount; i += 1)
+	{
+		bufferCopies[i].srcOffset = srcSubBuffer->bufferOffset + pRegions[i].srcOffset;
+		bufferCopies[i].dstOffset = dstSubBuffer->bufferOffset + pRegions[i].dstOffset;
+		bufferCopies[i].size = pRegions[i].size;
+	}
+
+	renderer->vkCmdCopyBuffer(
+		vulkanCommandBuffer->commandBuffer,
+		srcSubBuffer->buffer,
+		dstSubBuffer->buffer,
+		regionCount,
+		bufferCopies
+	);
+
+	SDL_stack_free(bufferCopies);
+
+	if (srcBuffer != dstBuffer)
+	{
+		VULKAN_INTERNAL_BufferMemoryBarrier(
+			renderer,
+			vulkanCommandBuffer->commandBuffer,
+			prevResourceAccess,
+			srcBuffer,
+			srcSubBuffer
+		);
+	}
+
+	VULKAN_INTERNAL_BufferReadBarrier(
+		renderer,
+		vulkanCommandBuffer->commandBuffer,
+		dstBuffer,
+		dstSubBuffer
+	);
+}
+
+static void VULKAN_FillBuffer(
+	Refresh_Renderer *driverData,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_Buffer *buffer,
+	uint32_t offsetInBytes,
+	uint32_t sizeInBytes,
+	uint32_t data
+) {
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+	VulkanBuffer *vulkanBuffer = (VulkanBuffer*) buffer;
+	VulkanSubBuffer *subBuffer;
+
+	if ((offsetInBytes | sizeInBytes) & 3)
+	{
+		Refresh_LogError("Fill offset and size must be multiples of 4!");
+		return;
+	}
+
+	if (sizeInBytes == 0)
+	{
+		Refresh_LogError("Fill size must not be zero!");
+		return;
+	}
+
+	if (	offsetInBytes > vulkanBuffer->size ||
+		sizeInBytes > vulkanBuffer->size - offsetInBytes	)
+	{
+		Refresh_LogError("Fill range exceeds buffer size!");
+		return;
+	}
+
+	VULKAN_INTERNAL_MarkAsBound(renderer, vulkanBuffer);
+	subBuffer = vulkanBuffer->subBuffers[vulkanBuffer->currentSubBufferIndex];
+
+	VULKAN_INTERNAL_BufferMemoryBarrier(
+		renderer,
+		vulkanCommandBuffer->commandBuffer,
+		RESOURCE_ACCESS_TRANSFER_WRITE,
+		vulkanBuffer,
+		subBuffer
+	);
+
+	renderer->vkCmdFillBuffer(
+		vulkanCommandBuffer->commandBuffer,
+		subBuffer->buffer,
+		subBuffer->bufferOffset + offsetInBytes,
+		sizeInBytes,
+		data
+	);
+
+	VULKAN_INTERNAL_BufferReadBarrier(
+		renderer,
+		vulkanCommandBuffer->commandBuffer,
+		vulkanBuffer,
+		subBuffer
+	);
+}
+
+static void VULKAN_QueueDestroyTexture(
+	Refresh_Renderer *driverData,
+	Refresh_Texture *texture
+) {
+	VulkanRenderer* renderer = (VulkanRenderer*)driverData;
+	VulkanTexture* vulkanTexture = (VulkanTexture*)texture;
+
+	SDL_LockMutex(renderer->disposeLock);
+
+	EXPAND_ARRAY_IF_NEEDED(
+		renderer->texturesToDestroy,
+		VulkanTexture*,
+		renderer->texturesToDestroyCount + 1,
+		renderer->texturesToDestroyCapacity,
+		renderer->texturesToDestroyCapacity * 2
+	)
+
+	renderer->texturesToDestroy[renderer->texturesToDestroyCount] = vulkanTexture;
+	renderer->texturesToDestroyCount += 1;
+
+	SDL_UnlockMutex(renderer->disposeLock);
+}
+
+static void VULKAN_QueueDestroySampler(
+	Refresh_Renderer *driverData,
+	Refresh_Sampler *sampler
+) {
+	VulkanRenderer* renderer = (VulkanRenderer*)driverData;
+	VkSampler vulkanSampler = (VkSampler) sampler;
+
+	SDL_LockMutex(renderer->disposeLock);
+
+	EXPAND_ARRAY_IF_NEEDED(
+		renderer->samplersToDestroy,
+		VkSampler,
+		renderer->samplersToDestroyCount + 1,
+		renderer->samplersToDestroyCapacity,
+		renderer->samplersToDestroyCapacity * 2
+	)
+
+	renderer->samplersToDestroy[renderer->samplersToDestroyCount] = vulkanSampler;
+	renderer->samplersToDestroyCount += 1;
+
+	SDL_UnlockMutex(renderer->disposeLock);
+}
+
+static void VULKAN_QueueDestroyBuffer(
+	Refresh_Renderer *driverData,
+	Refresh_Buffer *buffer
+) {
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+	VulkanBuffer *vulkanBuffer = (VulkanBuffer*) buffer;
+
+	SDL_LockMutex(renderer->disposeLock);
+
+	EXPAND_ARRAY_IF_NEEDED(
+		renderer->buffersToDestroy,
+		VulkanBuffer*,
+		renderer->buffersToDestroyCount + 1,
+		renderer->buffersToDestroyCapacity,
+		renderer->buffersToDestroyCapacity * 2
+	)
+
+	renderer->buffersToDestroy[
+		renderer->buffersToDestroyCount
+	] = vulkanBuffer;
+	renderer->buffersToDestroyCount += 1;
+
+	SDL_UnlockMutex(renderer->disposeLock);
+}
+
+static void VULKAN_QueueDestroyRenderTarget(
+	Refresh_Renderer *driverData,
+	Refresh_RenderTarget *renderTarget
+) {
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+	VulkanRenderTarget *vulkanRenderTarget = (VulkanRenderTarget*) renderTarget;
+
+	SDL_LockMutex(renderer->disposeLock);
+
+	EXPAND_ARRAY_IF_NEEDED(
+		renderer->renderTargetsToDestroy,
+		VulkanRenderTarget*,
+		renderer->renderTargetsToDestroyCount + 1,
+		renderer->renderTargetsToDestroyCapacity,
+		renderer->renderTargetsToDestroyCapacity * 2
+	)
+
+	renderer->renderTargetsToDestroy[renderer->renderTargetsToDestroyCount] = vulkanRenderTarget;
+	renderer->renderTargetsToDestroyCount += 1;
+
+	SDL_UnlockMutex(renderer->disposeLock);
+}
+
+static void VULKAN_QueueDestroyFramebuffer(
+	Refresh_Renderer *driverData,
+	Refresh_Framebuffer *framebuffer
+) {
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+	VulkanFramebuffer *vulkanFramebuffer = (VulkanFramebuffer*) framebuffer;
+
+	SDL_LockMutex(renderer->disposeLock);
+
+	EXPAND_ARRAY_IF_NEEDED(
+		renderer->framebuffersToDestroy,
+		VulkanFramebuffer*,
+		renderer->framebuffersToDestroyCount + 1,
+		renderer->framebuffersToDestroyCapacity,
+		renderer->framebuffersToDestroyCapacity * 2
+	)
+
+	renderer->framebuffersToDestroy[renderer->framebuffersToDestroyCount] = vulkanFramebuffer;
+	renderer->framebuffersToDestroyCount += 1;
+
+	SDL_UnlockMutex(renderer->disposeLock);
+}
+
+static void VULKAN_QueueDestroyShaderModule(
+	Refresh_Renderer *driverData,
+	Refresh_ShaderModule *shaderModule
+) {
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+	VkShaderModule vulkanShaderModule = (VkShaderModule) shaderModule;
+
+	SDL_LockMutex(renderer->disposeLock);
+
+	EXPAND_ARRAY_IF_NEEDED(
+		renderer->shaderModulesToDestroy,
+		VkShaderModule,
+		renderer->shaderModulesToDestroyCount + 1,
+		renderer->shaderModulesToDestroyCapacity,
+		renderer->shaderModulesToDestroyCapacity * 2
+	)
+
+	renderer->shaderModulesToDestroy[renderer->shaderModulesToDestroyCount] = vulkanShaderModule;
+	renderer->shaderModulesToDestroyCount += 1;
+
+	SDL_UnlockMutex(renderer->disposeLock);
+}
+
+static void VULKAN_QueueDestroyRenderPass(
+	Refresh_Renderer *driverData,
+	Refresh_RenderPass *renderPass
+) {
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+	VkRenderPass vulkanRenderPass = (VkRenderPass) renderPass;
+
+	SDL_LockMutex(renderer->disposeLock);
+
+	EXPAND_ARRAY_IF_NEEDED(
+		renderer->renderPassesToDestroy,
+		VkRenderPass,
+		renderer->renderPassesToDestroyCount + 1,
+		renderer->renderPassesToDestroyCapacity,
+		renderer->renderPassesToDestroyCapacity * 2
+	)
+
+	renderer->renderPassesToDestroy[renderer->renderPassesToDestroyCount] = vulkanRenderPass;
+	renderer->renderPassesToDestroyCount += 1;
+
+	SDL_UnlockMutex(renderer->disposeLock);
+}
+
+static void VULKAN_QueueDestroyComputePipeline(
+	Refresh_Renderer *driverData,
+	Refresh_ComputePipeline *computePipeline
+) {
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+	VulkanComputePipeline *vulkanComputePipeline = (VulkanComputePipeline*) computePipeline;
+
+	SDL_LockMutex(renderer->disposeLock);
+
+	EXPAND_ARRAY_IF_NEEDED(
+		renderer->computePipelinesToDestroy,
+		VulkanComputePipeline*,
+		renderer->computePipelinesToDestroyCount + 1,
+		renderer->computePipelinesToDestroyCapacity,
+		renderer->computePipelinesToDestroyCapacity * 2
+	)
+
+	renderer->computePipelinesToDestroy[renderer->computePipelinesToDestroyCount] = vulkanComputePipeline;
+	renderer->computePipelinesToDestroyCount += 1;
+
+	SDL_UnlockMutex(renderer->disposeLock);
+}
+
+static void VULKAN_QueueDestroyGraphicsPipeline(
+	Refresh_Renderer *driverData,
+	Refresh_GraphicsPipeline *graphicsPipeline
+) {
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+	VulkanGraphicsPipeline *vulkanGraphicsPipeline = (VulkanGraphicsPipeline*) graphicsPipeline;
+
+	SDL_LockMutex(renderer->disposeLock);
+
+	EXPAND_ARRAY_IF_NEEDED(
+		renderer->graphicsPipelinesToDestroy,
+		VulkanGraphicsPipeline*,
+		renderer->graphicsPipelinesToDestroyCount + 1,
+		renderer->graphicsPipelinesToDestroyCapacity,
+		renderer->graphicsPipelinesToDestroyCapacity * 2
+	)
+
+	renderer->graphicsPipelinesToDestroy[renderer->graphicsPipelinesToDestroyCount] = vulkanGraphicsPipeline;
+	renderer->graphicsPipelinesToDestroyCount += 1;
+
+	SDL_UnlockMutex(renderer->disposeLock);
+}
+
+static void VULKAN_BeginRenderPass(
+	Refresh_Renderer *driverData,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_RenderPass *renderPass,
+	Refresh_Framebuffer *framebuffer,
+	Refresh_Rect *renderArea,
+	Refresh_Vec4 *pColorClearValues,
+	uint32_t colorClearCount,
+	Refresh_DepthStencilValue *depthStencilClearValue
+) {
+	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
+	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+	VulkanFramebuffer *vulkanFramebuffer = (VulkanFramebuffer*) framebuffer;
+
+	VkClearValue *clearValues;
+	uint32_t i;
+	uint32_t clearCount = colorClearCount;
+	VkImageAspectFlags depthAspectFlags;
+
+	/* Layout transitions */
+
+	for (i = 0; i < vulkanFramebuffer->colorTargetCount; i += 1)
+	{
+		VULKAN_INTERNAL_ImageMemoryBarrier(
+			renderer,
+			vulkanCommandBuffer->commandBuffer,
+			RESOURCE_ACCESS_COLOR_ATTACHMENT_READ_WRITE,
+			VK_IMAGE_ASPECT_COLOR_BIT,
+			0,
+			vulkanFramebuffer->colorTargets[i]->texture->layerCount,
+			0,
+			vulkanFramebuffer->colorTargets[i]->texture->levelCount,
+			0,
+			vulkanFramebuffer->colorTargets[i]->texture->image,
+			&vulkanFramebuffer->colorTargets[i]->texture->resourceAccessType
+		);
+	}
+
+	if (vulkanFramebuffer->depthStencilTarget != NULL)
+	{
+		depthAspectFlags = VK_IMAGE_ASPECT_DEPTH_BIT;
+
+		if (IsStencilFormat(
+			vulkanFramebuffer->depthStencilTarget->texture->format
+		)) {
+			depthAspectFlags |= VK_IMAGE_ASPECT_STENCIL_BIT;
+		}
+
+		VULKAN_INTERNAL_ImageMemoryBarrier(
+			renderer,
+			vulkanCommandBuffer->commandBuffer,
+			RESOURCE_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_WRITE,
+			depthAspectFlags,
+			0,
+			vulkanFramebuffer->depthStencilTarget->texture->layerCount,
+			0,
+			vulkanFramebuffer->depthStencilTarget->texture->levelCount,
+			0,
+			vulkanFramebuffer->depthStencilTarget->texture->image,
+			&vulkanFramebuffer->depthStencilTarget->texture->resourceAccessType
+		);
+
+		clearCount += 1;
+	}
+
+	/* Set clear values */
+
+	clearValues = SDL_stack_alloc(VkClearValue, clearCount);
+
+	for (i = 0; i < colorClearCount; i += 1)
+	{
+		clearValues[i].color.float32[0] = pColorClearValues[i].x;
+		clearValues[i].color.float32[1] = pColorClearValues[i].y;
+		clearValues[i].color.float32[2] = pColorClearValues[i].z;
+		clearValues[i].color.float32[3] = pColorClearValues[i].w;
+	}
+
+	if (depthStencilClearValue != NULL)
+	{
+		clearValues[colorClearCount].depthStencil.depth =
+			depthStencilClearValue->depth;
+		clearValues[colorClearCount].depthStencil.stencil =
+			depthStencilClearValue->stencil;
+	}
+
+	VkRenderPassBeginInfo renderPassBeginInfo;
+	renderPassBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+	renderPassBeginInfo.pNext = NULL;
+	renderPassBeginInfo.renderPass = (VkRenderPass) renderPass;
+	renderPassBeginInfo.framebuffer = vulkanFramebuffer->framebuffer;
+	renderPassBeginInfo.renderArea.extent.width = renderArea->w;
+	renderPassBeginInfo.renderArea.extent.height = renderArea->h;
+	renderPassBeginInfo.renderArea.offset.x = renderArea->x;
+	renderPassBeginInfo.renderArea.offset.y = renderArea->y;
+	renderPassBeginInfo.pClearValues = clearValues;
+	renderPassBeginInfo.clearValueCount = clearCount;
+
+	renderer->vkCmdBeginRenderPass(
+		vulkanCommandBuffer->commandBuffer,
+		&renderPassBeginInfo,
+		VK_SUBPASS_CONTENTS_INLINE
+	);
+
+	vulkanCommandBuffer->currentFramebuffer = vulkanFramebuffer;
+
+	SDL_stack_free(clearValues);
+}
+
+static void VULKAN_EndRenderPass(
+	Refresh_Renderer *driverData,
+	Refresh_CommandBuffer *commandBuffer
+) {
+	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
+	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+	VulkanTexture *currentTexture;
+	VkImageAspectFlags depthAspectFlags;
+	uint32_t i;
+
+	renderer->vkCmdEndRenderPass(
+		vulkanCommandBuffer->commandBuffer
+	);
+
+	for (i = 0; i < vulkanCommandBuffer->currentFramebuffer->colorTargetCount; i += 1)
+	{
+		currentTexture = vulkanCommandBuffer->currentFramebuffer->colorTargets[i]->texture;
+
+		if (currentTexture->usageFlags & VK_IMAGE_USAGE_SAMPLED_BIT)
+		{
+			VULKAN_INTERNAL_ImageMemoryBarrier(
+				renderer,
+				vulkanCommandBuffer->commandBuffer,
+				RESOURCE_ACCESS_ANY_SHADER_READ_SAMPLED_IMAGE,
+				VK_IMAGE_ASPECT_COLOR_BIT,
+				0,
+				currentTexture->layerCount,
+				0,
+				currentTexture->levelCount,
+				0,
+				currentTexture->image,
+				&currentTexture->resourceAccessType
+			);
+		}
+	}
+
+	if (vulkanCommandBuffer->currentFramebuffer->depthStencilTarget != NULL)
+	{
+		currentTexture = vulkanCommandBuffer->currentFramebuffer->depthStencilTarget->texture;
+
+		if (currentTexture->usageFlags & VK_IMAGE_USAGE_SAMPLED_BIT)
+		{
+			depthAspectFlags = VK_IMAGE_ASPECT_DEPTH_BIT;
+
+			if (IsStencilFormat(
+				currentTexture->format
+			)) {
+				depthAspectFlags |= VK_IMAGE_ASPECT_STENCIL_BIT;
+			}
+
+			VULKAN_INTERNAL_ImageMemoryBarrier(
+				renderer,
+				vulkanCommandBuffer->commandBuffer,
+				RESOURCE_ACCESS_ANY_SHADER_READ_SAMPLED_IMAGE,
+				depthAspectFlags,
+				0,
+				currentTexture->layerCount,
+				0,
+				currentTexture->levelCount,
+				0,
+				currentTexture->image,
+				&currentTexture->resourceAccessType
+			);
+		}
+	}
+
+	vulkanCommandBuffer->currentGraphicsPipeline = NULL;
+	vulkanCommandBuffer->currentFramebuffer = NULL;
+}
+
+static void VULKAN_BindGraphicsPipeline(
+	Refresh_Renderer *driverData,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_GraphicsPipeline *graphicsPipeline
+) {
+	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
+	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+	VulkanGraphicsPipeline* pipeline = (VulkanGraphicsPipeline*) graphicsPipeline;
+
+	/* bind dummy sets */
+	if (pipeline->pipelineLayout->vertexSamplerDescriptorSetCacheInfo == NULL)
+	{
+		vulkanCommandBuffer->vertexSamplerDescriptorSet = renderer->emptyVertexSamplerDescriptorSet;
+	}
+
+	if (pipeline->pipelineLayout->fragmentSamplerDescriptorSetCacheInfo == NULL)
+	{
+		vulkanCommandBuffer->fragmentSamplerDescriptorSet = renderer->emptyFragmentSamplerDescriptorSet;
+	}
+
+	if (pipeline->pipeline == vulkanCommandBuffer->boundGraphicsPipeline)
+	{
+		vulkanCommandBuffer->stats.pipelineBindsElided += 1;
+	}
+	else
+	{
+		renderer->vkCmdBindPipeline(
+			vulkanCommandBuffer->commandBuffer,
+			VK_PIPELINE_BIND_POINT_GRAPHICS,
+			pipeline->pipeline
+		);
+		vulkanCommandBuffer->boundGraphicsPipeline = pipeline->pipeline;
+	}
+
+	vulkanCommandBuffer->currentGraphicsPipeline = pipeline;
+}
+
+/* Pins the texture in memory until the command buffer is submitted,
+ * since defragmentation would otherwise replace the image it recorded.
+ * Callers must read the image and view only after this returns.
+ */
+static void VULKAN_INTERNAL_TrackTexture(
+	VulkanRenderer *renderer,
+	VulkanCommandBuffer *commandBuffer,
+	VulkanTexture *texture
+) {
+	/* Another thread may interleave, which only adds a duplicate entry */
+	if (SDL_AtomicGetPtr(&texture->lastRecordingCommandBuffer) == commandBuffer)
+	{
+		return;
+	}
+
+	EXPAND_ARRAY_IF_NEEDED(
+		commandBuffer->recordedTextures,
+		VulkanTexture*,
+		commandBuffer->recordedTextureCount + 1,
+		commandBuffer->recordedTextureCapacity,
+		commandBuffer->recordedTextureCapacity * 2 + 8
+	);
+
+	commandBuffer->recordedTextures[commandBuffer->recordedTextureCount] = texture;
+	commandBuffer->recordedTextureCount += 1;
+
+	/* The defragmenter checks the pin and moves the texture in one hold
+	 * of the allocator lock, so after this it has either already replaced
+	 * the handles or will leave them alone.
+	 */
+	SDL_LockMutex(renderer->allocatorLock);
+	SDL_AtomicIncRef(&texture->recordingRefs);
+	SDL_UnlockMutex(renderer->allocatorLock);
+
+	SDL_AtomicSetPtr(&texture->lastRecordingCommandBuffer, commandBuffer);
+}
+
+/* Called once the command buffer is submitted. Its images are then kept
+ * alive by the frame it was submitted in, like any other disposed resource.
+ */
+static void VULKAN_INTERNAL_ReleaseRecordedTextures(
+	VulkanCommandBuffer *commandBuffer
+) {
+	VulkanTexture *texture;
+	uint32_t i;
+
+	for (i = 0; i < commandBuffer->recordedTextureCount; i += 1)
+	{
+		texture = commandBuffer->recordedTextures[i];
+
+		SDL_AtomicCASPtr(&texture->lastRecordingCommandBuffer, commandBuffer, NULL);
+		SDL_AtomicDecRef(&texture->recordingRefs);
+	}
+
+	commandBuffer->recordedTextureCount = 0;
+}
+
+static void VULKAN_INTERNAL_MarkAsBound(
+	VulkanRenderer* renderer,
+	VulkanBuffer* buf
+) {
+	VulkanSubBuffer *subbuf = buf->subBuffers[buf->currentSubBufferIndex];
+	subbuf->bound = renderer->frameIndex;
+
+	/* Don't rebind a bound buffer */
+	if (buf->bound) return;
+
+	buf->bound = 1;
+
+	SDL_LockMutex(renderer->boundBufferLock);
+
+	if (renderer->buffersInUseCount == renderer->buffersInUseCapacity)
+	{
+		renderer->buffersInUseCapacity *= 2;
+		renderer->buffersInUse = SDL_realloc(
+			renderer->buffersInUse,
+			sizeof(VulkanBuffer*) * renderer->buffersInUseCapacity
+		);
+	}
+
+	renderer->buffersInUse[renderer->buffersInUseCount] = buf;
+	renderer->buffersInUseCount += 1;
+
+	SDL_UnlockMutex(renderer->boundBufferLock);
+}
+
+static void VULKAN_BindVertexBuffers(
+	Refresh_Renderer *driverData,
+	Refresh_CommandBuffer *commandBuffer,
+	uint32_t firstBinding,
+	uint32_t bindingCount,
+	Refresh_Buffer **pBuffers,
+	uint64_t *pOffsets
+) {
+	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
+	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+
+	VkBuffer *buffers = SDL_stack_alloc(VkBuffer, bindingCount);
+	VkDeviceSize *offsets = SDL_stack_alloc(VkDeviceSize, bindingCount);
+	VulkanBuffer* currentBuffer;
+	uint32_t firstChanged = bindingCount;
+	uint32_t lastChanged = 0;
+	uint32_t i, binding;
+
+	for (i = 0; i < bindingCount; i += 1)
+	{
+		currentBuffer = (VulkanBuffer*) pBuffers[i];
+		buffers[i] = currentBuffer->subBuffers[currentBuffer->currentSubBufferIndex]->buffer;
+		offsets[i] = currentBuffer->subBuffers[currentBuffer->currentSubBufferIndex]->bufferOffset + pOffsets[i];
+		VULKAN_INTERNAL_MarkAsBound(renderer, currentBuffer);
+
+		/* Bindings past the tracked range are always rebound */
+		binding = firstBinding + i;
+		if (	binding >= MAX_BUFFER_BINDINGS ||
+			buffers[i] != vulkanCommandBuffer->boundVertexBuffers[binding] ||
+			offsets[i] != vulkanCommandBuffer->boundVertexBufferOffsets[binding]	)
+		{
+			if (firstChanged == bindingCount)
+			{
+				firstChanged = i;
+			}
+			lastChanged = i;
+
+			if (binding < MAX_BUFFER_BINDINGS)
+			{
+				vulkanCommandBuffer->boundVertexBuffers[binding] = buffers[i];
+				vulkanCommandBuffer->boundVertexBufferOffsets[binding] = offsets[i];
+			}
+		}
+	}
+
+	if (firstChanged == bindingCount)
+	{
+		vulkanCommandBuffer->stats.vertexBufferBindsElided += bindingCount;
+	}
+	else
+	{
+		vulkanCommandBuffer->stats.vertexBufferBindsElided +=
+			bindingCount - (lastChanged - firstChanged + 1);
+
+		renderer->vkCmdBindVertexBuffers(
+			vulkanCommandBuffer->commandBuffer,
+			firstBinding + firstChanged,
+			lastChanged - firstChanged + 1,
+			&buffers[firstChanged],
+			&offsets[firstChanged]
+		);
+	}
+
+	SDL_stack_free(offsets);
+	SDL_stack_free(buffers);
+}
+
+static void VULKAN_BindIndexBuffer(
+	Refresh_Renderer *driverData,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_Buffer *buffer,
+	uint64_t offset,
+	Refresh_IndexElementSize indexElementSize
+) {
+	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
+	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+	VulkanBuffer* vulkanBuffer = (VulkanBuffer*) buffer;
+	VulkanSubBuffer *subBuffer;
+	VkDeviceSize bufferOffset;
+	VkIndexType indexType = RefreshToVK_IndexType[indexElementSize];
+
+	VULKAN_INTERNAL_MarkAsBound(renderer, vulkanBuffer);
+
+	subBuffer = vulkanBuffer->subBuffers[vulkanBuffer->currentSubBufferIndex];
+	bufferOffset = subBuffer->bufferOffset + offset;
+
+	if (	subBuffer->buffer == vulkanCommandBuffer->boundIndexBuffer &&
+		bufferOffset == vulkanCommandBuffer->boundIndexBufferOffset &&
+		indexType == vulkanCommandBuffer->boundIndexType	)
+	{
+		vulkanCommandBuffer->stats.indexBufferBindsElided += 1;
+		return;
+	}
+
+	renderer->vkCmdBindIndexBuffer(
+		vulkanCommandBuffer->commandBuffer,
+		subBuffer->buffer,
+		bufferOffset,
+		indexType
+	);
+
+	vulkanCommandBuffer->boundIndexBuffer = subBuffer->buffer;
+	vulkanCommandBuffer->boundIndexBufferOffset = bufferOffset;
+	vulkanCommandBuffer->boundIndexType = indexType;
+}
+
+static void VULKAN_BindComputePipeline(
+	Refresh_Renderer *driverData,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_ComputePipeline *computePipeline
+) {
+	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
+	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+	VulkanComputePipeline *vulkanComputePipeline = (VulkanComputePipeline*) computePipeline;
+
+	/* bind dummy sets */
+	if (vulkanComputePipeline->pipelineLayout->bufferDescriptorSetCacheInfo == NULL)
+	{
+		vulkanCommandBuffer->computeBufferDescriptorSet = renderer->emptyComputeBufferDescriptorSet;
+	}
+
+	if (vulkanComputePipeline->pipelineLayout->imageDescriptorSetCacheInfo == NULL)
+	{
+		vulkanCommandBuffer->computeImageDescriptorSet = renderer->emptyComputeImageDescriptorSet;
+	}
+
+	if (vulkanComputePipeline->pipeline == vulkanCommandBuffer->boundComputePipeline)
+	{
+		vulkanCommandBuffer->stats.pipelineBindsElided += 1;
+	}
+	else
+	{
+		renderer->vkCmdBindPipeline(
+			vulkanCommandBuffer->commandBuffer,
+			VK_PIPELINE_BIND_POINT_COMPUTE,
+			vulkanComputePipeline->pipeline
+		);
+		vulkanCommandBuffer->boundComputePipeline = vulkanComputePipeline->pipeline;
+	}
+
+	vulkanCommandBuffer->currentComputePipeline = vulkanComputePipeline;
 }
 
-static void VULKAN_INTERNAL_MarkAsBound(
-	VulkanRenderer* renderer,
-	VulkanBuffer* buf
+static void VULKAN_BindComputeBuffers(
+	Refresh_Renderer *driverData,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_Buffer **pBuffers
 ) {
-	VulkanSubBuffer *subbuf = buf->subBuffers[buf->currentSubBufferIndex];
-	subbuf->bound = renderer->frameIndex;
+	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
+	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+	VulkanComputePipeline *computePipeline = vulkanCommandBuffer->currentComputePipeline;
 
-	/* Don't rebind a bound buffer */
-	if (buf->bound) return;
+	VulkanBuffer *currentBuffer;
+	BufferDescriptorSetData bufferDescriptorSetData;
+	uint32_t i;
 
-	buf->bound = 1;
+	if (computePipeline->pipelineLayout->bufferDescriptorSetCacheInfo == NULL)
+	{
+		return;
+	}
 
-	SDL_LockMutex(renderer->boundBufferLock);
+	for (i = 0; i < computePipeline->pipelineLayout->bufferDescriptorSetCacheInfo->bindingCount; i += 1)
+	{
+		currentBuffer = (VulkanBuffer*) pBuffers[i];
+
+		bufferDescriptorSetData.descriptorBufferInfo[i].buffer = currentBuffer->subBuffers[currentBuffer->currentSubBufferIndex]->buffer;
+		bufferDescriptorSetData.descriptorBufferInfo[i].offset = currentBuffer->subBuffers[currentBuffer->currentSubBufferIndex]->bufferOffset;
+		bufferDescriptorSetData.descriptorBufferInfo[i].range = currentBuffer->subBuffers[currentBuffer->currentSubBufferIndex]->size;
+
+		VULKAN_INTERNAL_MarkAsBound(renderer, currentBuffer);
+		vulkanCommandBuffer->boundComputeBuffers[i] = currentBuffer;
+	}
+
+	vulkanCommandBuffer->boundComputeBufferCount = computePipeline->pipelineLayout->bufferDescriptorSetCacheInfo->bindingCount;
+
+	vulkanCommandBuffer->computeBufferDescriptorSet =
+		VULKAN_INTERNAL_FetchBufferDescriptorSet(
+			renderer,
+			vulkanCommandBuffer->commandPool,
+			computePipeline->pipelineLayout->bufferDescriptorSetCacheInfo,
+			&bufferDescriptorSetData
+		);
+}
+
+static void VULKAN_BindComputeTextures(
+	Refresh_Renderer *driverData,
+	Refresh_CommandBuffer *commandBuffer,
+	Refresh_Texture **pTextures
+) {
+	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
+	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+	VulkanComputePipeline *computePipeline = vulkanCommandBuffer->currentComputePipeline;
+
+	VulkanTexture *currentTexture;
+	ImageDescriptorSetData imageDescriptorSetData;
+	uint32_t i;
+
+	if (computePipeline->pipelineLayout->imageDescriptorSetCacheInfo == NULL)
+	{
+		return;
+	}
+
+	for (i = 0; i < computePipeline->pipelineLayout->imageDescriptorSetCacheInfo->bindingCount; i += 1)
+	{
+		currentTexture = (VulkanTexture*) pTextures[i];
+		VULKAN_INTERNAL_TrackTexture(renderer, vulkanCommandBuffer, currentTexture);
+		imageDescriptorSetData.descriptorImageInfo[i].imageView = currentTexture->view;
+		imageDescriptorSetData.descriptorImageInfo[i].sampler = VK_NULL_HANDLE;
+		imageDescriptorSetData.descriptorImageInfo[i].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+	}
+
+	vulkanCommandBuffer->computeImageDescriptorSet =
+		VULKAN_INTERNAL_FetchImageDescriptorSet(
+			renderer,
+			vulkanCommandBuffer->commandPool,
+			computePipeline->pipelineLayout->imageDescriptorSetCacheInfo,
+			&imageDescriptorSetData
+		);
+}
+
+static void VULKAN_INTERNAL_AllocateCommandBuffers(
+	VulkanRenderer *renderer,
+	VulkanCommandPool *vulkanCommandPool,
+	uint32_t allocateCount
+) {
+	VkCommandBufferAllocateInfo allocateInfo;
+	VkResult vulkanResult;
+	uint32_t i;
+	VkCommandBuffer *commandBuffers = SDL_stack_alloc(VkCommandBuffer, allocateCount);
+	VulkanCommandBuffer *currentVulkanCommandBuffer;
+
+	vulkanCommandPool->inactiveCommandBufferCapacity += allocateCount;
+
+	vulkanCommandPool->inactiveCommandBuffers = SDL_realloc(
+		vulkanCommandPool->inactiveCommandBuffers,
+		sizeof(VulkanCommandBuffer*) *
+		vulkanCommandPool->inactiveCommandBufferCapacity
+	);
+
+	allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+	allocateInfo.pNext = NULL;
+	allocateInfo.commandPool = vulkanCommandPool->commandPool;
+	allocateInfo.commandBufferCount = allocateCount;
+	allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+
+	vulkanResult = renderer->vkAllocateCommandBuffers(
+		renderer->logicalDevice,
+		&allocateInfo,
+		commandBuffers
+	);
+
+	if (vulkanResult != VK_SUCCESS)
+	{
+		LogVulkanResultAsError("vkAllocateCommandBuffers", vulkanResult);
+		SDL_stack_free(commandBuffers);
+		return;
+	}
+
+	for (i = 0; i < allocateCount; i += 1)
+	{
+		currentVulkanCommandBuffer = SDL_malloc(sizeof(VulkanCommandBuffer));
+		currentVulkanCommandBuffer->commandPool = vulkanCommandPool;
+		currentVulkanCommandBuffer->commandBuffer = commandBuffers[i];
+		currentVulkanCommandBuffer->recordedTextures = NULL;
+		currentVulkanCommandBuffer->recordedTextureCount = 0;
+		currentVulkanCommandBuffer->recordedTextureCapacity = 0;
+		vulkanCommandPool->inactiveCommandBuffers[
+			vulkanCommandPool->inactiveCommandBufferCount
+		] = currentVulkanCommandBuffer;
+		vulkanCommandPool->inactiveCommandBufferCount += 1;
+	}
+
+	SDL_stack_free(commandBuffers);
+}
+
+static VulkanCommandPool* VULKAN_INTERNAL_FetchCommandPool(
+	VulkanRenderer *renderer,
+	SDL_threadID threadID
+) {
+	VulkanCommandPool *vulkanCommandPool;
+	VkCommandPoolCreateInfo commandPoolCreateInfo;
+	VkResult vulkanResult;
+	CommandPoolHash commandPoolHash;
+
+	commandPoolHash.threadID = threadID;
+
+	/* Another thread's first fetch may grow the table while we read it */
+	SDL_LockMutex(renderer->commandPoolLock);
+
+	vulkanCommandPool = CommandPoolHashTable_Fetch(
+		&renderer->commandPoolHashTable,
+		commandPoolHash
+	);
+
+	if (vulkanCommandPool != NULL)
+	{
+		SDL_UnlockMutex(renderer->commandPoolLock);
+		return vulkanCommandPool;
+	}
+
+	vulkanCommandPool = (VulkanCommandPool*) SDL_malloc(sizeof(VulkanCommandPool));
+
+	commandPoolCreateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+	commandPoolCreateInfo.pNext = NULL;
+	commandPoolCreateInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+	commandPoolCreateInfo.queueFamilyIndex = renderer->queueFamilyIndices.graphicsFamily;
+
+	vulkanResult = renderer->vkCreateCommandPool(
+		renderer->logicalDevice,
+		&commandPoolCreateInfo,
+		NULL,
+		&vulkanCommandPool->commandPool
+	);
+
+	if (vulkanResult != VK_SUCCESS)
+	{
+		SDL_UnlockMutex(renderer->commandPoolLock);
+		Refresh_LogError("Failed to create command pool!");
+		LogVulkanResultAsError("vkCreateCommandPool", vulkanResult);
+		SDL_free(vulkanCommandPool);
+		return NULL;
+	}
+
+	vulkanCommandPool->threadID = threadID;
+
+	vulkanCommandPool->inactiveCommandBufferCapacity = 0;
+	vulkanCommandPool->inactiveCommandBufferCount = 0;
+	vulkanCommandPool->inactiveCommandBuffers = NULL;
+
+	vulkanCommandPool->vertexUniformChunk.block = NULL;
+	vulkanCommandPool->fragmentUniformChunk.block = NULL;
+	vulkanCommandPool->computeUniformChunk.block = NULL;
+
+	vulkanCommandPool->imageDescriptorSetCaches = NULL;
+	vulkanCommandPool->imageDescriptorSetCacheCount = 0;
+	vulkanCommandPool->bufferDescriptorSetCaches = NULL;
+	vulkanCommandPool->bufferDescriptorSetCacheCount = 0;
+
+	vulkanCommandPool->activeImageDescriptorSetCacheCapacity = 16;
+	vulkanCommandPool->activeImageDescriptorSetCacheCount = 0;
+	vulkanCommandPool->activeImageDescriptorSetCaches = (ImageDescriptorSetCache**) SDL_malloc(
+		sizeof(ImageDescriptorSetCache*) *
+		vulkanCommandPool->activeImageDescriptorSetCacheCapacity
+	);
+
+	vulkanCommandPool->activeBufferDescriptorSetCacheCapacity = 16;
+	vulkanCommandPool->activeBufferDescriptorSetCacheCount = 0;
+	vulkanCommandPool->activeBufferDescriptorSetCaches = (BufferDescriptorSetCache**) SDL_malloc(
+		sizeof(BufferDescriptorSetCache*) *
+		vulkanCommandPool->activeBufferDescriptorSetCacheCapacity
+	);
+
+	vulkanCommandPool->descriptorSetResetSubmission =
+		(uint32_t) SDL_AtomicGet(&renderer->recordingSubmission);
+
+	vulkanCommandPool->expirationLock = SDL_CreateMutex();
+	SDL_AtomicSet(&vulkanCommandPool->expirationPending, 0);
+	vulkanCommandPool->expiredImageViews = NULL;
+	vulkanCommandPool->expiredImageViewCount = 0;
+	vulkanCommandPool->expiredImageViewCapacity = 0;
+	vulkanCommandPool->expiredBuffers = NULL;
+	vulkanCommandPool->expiredBufferCount = 0;
+	vulkanCommandPool->expiredBufferCapacity = 0;
+
+	VULKAN_INTERNAL_AllocateCommandBuffers(
+		renderer,
+		vulkanCommandPool,
+		2
+	);
+
+	CommandPoolHashTable_Insert(
+		&renderer->commandPoolHashTable,
+		commandPoolHash,
+		vulkanCommandPool
+	);
+
+	SDL_UnlockMutex(renderer->commandPoolLock);
+
+	return vulkanCommandPool;
+}
+
+static VulkanCommandBuffer* VULKAN_INTERNAL_GetInactiveCommandBufferFromPool(
+	VulkanRenderer *renderer,
+	SDL_threadID threadID
+) {
+	VulkanCommandPool *commandPool =
+		VULKAN_INTERNAL_FetchCommandPool(renderer, threadID);
+	VulkanCommandBuffer *commandBuffer;
+
+	if (commandPool->inactiveCommandBufferCount == 0)
+	{
+		VULKAN_INTERNAL_AllocateCommandBuffers(
+			renderer,
+			commandPool,
+			commandPool->inactiveCommandBufferCapacity
+		);
+	}
+
+	commandBuffer = commandPool->inactiveCommandBuffers[commandPool->inactiveCommandBufferCount - 1];
+	commandPool->inactiveCommandBufferCount -= 1;
+
+	return commandBuffer;
+}
+
+static Refresh_CommandBuffer* VULKAN_AcquireCommandBuffer(
+	Refresh_Renderer *driverData,
+	uint8_t fixed
+) {
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+	uint32_t i;
+
+	SDL_threadID threadID = SDL_ThreadID();
+
+	VulkanCommandBuffer *commandBuffer =
+		VULKAN_INTERNAL_GetInactiveCommandBufferFromPool(renderer, threadID);
+
+	/* State tracking */
+
+	commandBuffer->currentComputePipeline = NULL;
+	commandBuffer->currentGraphicsPipeline = NULL;
+	commandBuffer->currentFramebuffer = NULL;
+
+	/* init bound compute buffer array */
 
-	if (renderer->buffersInUseCount == renderer->buffersInUseCapacity)
+	for (i = 0; i < MAX_BUFFER_BINDINGS; i += 1)
 	{
-		renderer->buffersInUseCapacity *= 2;
-		renderer->buffersInUse = SDL_realloc(
-			renderer->buffersInUse,
-			sizeof(VulkanBuffer*) * renderer->buffersInUseCapacity
-		);
+		commandBuffer->boundComputeBuffers[i] = NULL;
 	}
+	commandBuffer->boundComputeBufferCount = 0;
 
-	renderer->buffersInUse[renderer->buffersInUseCount] = buf;
-	renderer->buffersInUseCount += 1;
-
-	SDL_UnlockMutex(renderer->boundBufferLock);
-}
+	commandBuffer->vertexSamplerDescriptorSet = renderer->emptyVertexSamplerDescriptorSet;
+	commandBuffer->fragmentSamplerDescriptorSet = renderer->emptyFragmentSamplerDescriptorSet;
+	commandBuffer->computeBufferDescriptorSet = renderer->emptyComputeBufferDescriptorSet;
+	commandBuffer->computeImageDescriptorSet = renderer->emptyComputeImageDescriptorSet;
 
-static void VULKAN_BindVertexBuffers(
-	Refresh_Renderer *driverData,
-	Refresh_CommandBuffer *commandBuffer,
-	uint32_t firstBinding,
-	uint32_t bindingCount,
-	Refresh_Buffer **pBuffers,
-	uint64_t *pOffsets
-) {
-	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
-	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
+	commandBuffer->vertexUniformBinding.descriptorSet = VK_NULL_HANDLE;
+	commandBuffer->fragmentUniformBinding.descriptorSet = VK_NULL_HANDLE;
+	commandBuffer->computeUniformBinding.descriptorSet = VK_NULL_HANDLE;
 
-	VkBuffer *buffers = SDL_stack_alloc(VkBuffer, bindingCount);
-	VulkanBuffer* currentBuffer;
-	uint32_t i;
+	/* Nothing is bound in a freshly begun command buffer */
 
-	for (i = 0; i < bindingCount; i += 1)
+	commandBuffer->boundGraphicsPipeline = VK_NULL_HANDLE;
+	commandBuffer->boundComputePipeline = VK_NULL_HANDLE;
+	for (i = 0; i < MAX_BUFFER_BINDINGS; i += 1)
 	{
-		currentBuffer = (VulkanBuffer*) pBuffers[i];
-		buffers[i] = currentBuffer->subBuffers[currentBuffer->currentSubBufferIndex]->buffer;
-		VULKAN_INTERNAL_MarkAsBound(renderer, currentBuffer);
+		commandBuffer->boundVertexBuffers[i] = VK_NULL_HANDLE;
+		commandBuffer->boundVertexBufferOffsets[i] = 0;
 	}
+	commandBuffer->boundIndexBuffer = VK_NULL_HANDLE;
+	commandBuffer->boundIndexBufferOffset = 0;
+	commandBuffer->boundIndexType = VK_INDEX_TYPE_UINT16;
+	SDL_zero(commandBuffer->boundGraphicsSets);
+	SDL_zero(commandBuffer->boundComputeSets);
+	SDL_zero(commandBuffer->stats);
 
-	renderer->vkCmdBindVertexBuffers(
-		vulkanCommandBuffer->commandBuffer,
-		firstBinding,
-		bindingCount,
-		buffers,
-		pOffsets
-	);
+	commandBuffer->fixed = fixed;
+	commandBuffer->submitted = 0;
 
-	SDL_stack_free(buffers);
+	VULKAN_INTERNAL_BeginCommandBuffer(renderer, commandBuffer);
+
+	return (Refresh_CommandBuffer*) commandBuffer;
 }
 
-static void VULKAN_BindIndexBuffer(
+static void VULKAN_GetCommandBufferStats(
 	Refresh_Renderer *driverData,
 	Refresh_CommandBuffer *commandBuffer,
-	Refresh_Buffer *buffer,
-	uint64_t offset,
-	Refresh_IndexElementSize indexElementSize
+	Refresh_CommandBufferStats *stats
 ) {
-	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
 	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
-	VulkanBuffer* vulkanBuffer = (VulkanBuffer*) buffer;
 
-	VULKAN_INTERNAL_MarkAsBound(renderer, vulkanBuffer);
-
-	renderer->vkCmdBindIndexBuffer(
-		vulkanCommandBuffer->commandBuffer,
-		vulkanBuffer->subBuffers[vulkanBuffer->currentSubBufferIndex]->buffer,
-		offset,
-		RefreshToVK_IndexType[indexElementSize]
-	);
+	*stats = vulkanCommandBuffer->stats;
 }
 
-static void VULKAN_BindComputePipeline(
+static void VULKAN_QueuePresent(
 	Refresh_Renderer *driverData,
 	Refresh_CommandBuffer *commandBuffer,
-	Refresh_ComputePipeline *computePipeline
+	Refresh_TextureSlice *textureSlice,
+	Refresh_Rect *destinationRectangle,
+	Refresh_Filter filter
 ) {
+	VkResult acquireResult;
+	uint32_t swapChainImageIndex;
+
+	Refresh_Rect dstRect;
+
 	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
 	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
-	VulkanComputePipeline *vulkanComputePipeline = (VulkanComputePipeline*) computePipeline;
+	VulkanTexture* vulkanTexture = (VulkanTexture*) textureSlice->texture;
 
-	/* bind dummy sets */
-	if (vulkanComputePipeline->pipelineLayout->bufferDescriptorSetCache == NULL)
+	if (renderer->headless)
+	{
+		Refresh_LogError("Cannot call QueuePresent in headless mode!");
+		return;
+	}
+
+	VULKAN_INTERNAL_TrackTexture(renderer, vulkanCommandBuffer, vulkanTexture);
+
+	acquireResult = renderer->vkAcquireNextImageKHR(
+		renderer->logicalDevice,
+		renderer->swapChain,
+		UINT64_MAX,
+		renderer->imageAvailableSemaphores[renderer->frameIndex],
+		VK_NULL_HANDLE,
+		&swapChainImageIndex
+	);
+
+	if (acquireResult != VK_SUCCESS && acquireResult != VK_SUBOPTIMAL_KHR)
 	{
-		vulkanComputePipeline->bufferDescriptorSet = renderer->emptyComputeBufferDescriptorSet;
+		/* Failed to acquire swapchain image, mark that we need a new one */
+		renderer->needNewSwapChain = 1;
+		return;
 	}
 
-	if (vulkanComputePipeline->pipelineLayout->imageDescriptorSetCache == NULL)
+	renderer->shouldPresent = 1;
+	renderer->swapChainImageAcquired = 1;
+	renderer->currentSwapChainIndex = swapChainImageIndex;
+	renderer->swapChainAcquireSemaphore = renderer->imageAvailableSemaphores[renderer->frameIndex];
+
+	if (destinationRectangle != NULL)
+	{
+		dstRect = *destinationRectangle;
+	}
+	else
 	{
-		vulkanComputePipeline->imageDescriptorSet = renderer->emptyComputeImageDescriptorSet;
+		dstRect.x = 0;
+		dstRect.y = 0;
+		dstRect.w = renderer->swapChainExtent.width;
+		dstRect.h = renderer->swapChainExtent.height;
 	}
 
-	renderer->vkCmdBindPipeline(
+	/* Blit! */
+
+	VULKAN_INTERNAL_BlitImage(
+		renderer,
 		vulkanCommandBuffer->commandBuffer,
-		VK_PIPELINE_BIND_POINT_COMPUTE,
-		vulkanComputePipeline->pipeline
+		&textureSlice->rectangle,
+		textureSlice->depth,
+		textureSlice->layer,
+		textureSlice->level,
+		vulkanTexture->image,
+		&vulkanTexture->resourceAccessType,
+		vulkanTexture->resourceAccessType,
+		&dstRect,
+		0,
+		0,
+		0,
+		renderer->swapChainImages[swapChainImageIndex],
+		&renderer->swapChainResourceAccessTypes[swapChainImageIndex],
+		RESOURCE_ACCESS_PRESENT,
+		RefreshToVK_Filter[filter]
 	);
-
-	vulkanCommandBuffer->currentComputePipeline = vulkanComputePipeline;
 }
 
-static void VULKAN_BindComputeBuffers(
-	Refresh_Renderer *driverData,
-	Refresh_CommandBuffer *commandBuffer,
-	Refresh_Buffer **pBuffers
+/* Memory Budget */
+
+/* Reads heap budget and usage from the driver when VK_EXT_memory_budget
+ * is enabled, otherwise reports the heap size and our own allocations.
+ * Must be called with allocatorLock held.
+ */
+static void VULKAN_INTERNAL_QueryHeapBudgets(
+	VulkanRenderer *renderer,
+	VkDeviceSize *budgets,
+	VkDeviceSize *usages
 ) {
-	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
-	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
-	VulkanComputePipeline *computePipeline = vulkanCommandBuffer->currentComputePipeline;
+	VkPhysicalDeviceMemoryBudgetPropertiesEXT budgetProperties;
+	VkPhysicalDeviceMemoryProperties2KHR memoryProperties;
+	uint32_t i, heapIndex;
 
-	VulkanBuffer *currentBuffer;
-	BufferDescriptorSetData bufferDescriptorSetData;
+	if (renderer->supportsMemoryBudget)
+	{
+		budgetProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+		budgetProperties.pNext = NULL;
+
+		memoryProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2_KHR;
+		memoryProperties.pNext = &budgetProperties;
+
+		renderer->vkGetPhysicalDeviceMemoryProperties2KHR(
+			renderer->physicalDevice,
+			&memoryProperties
+		);
+
+		for (i = 0; i < renderer->memoryProperties.memoryHeapCount; i += 1)
+		{
+			budgets[i] = budgetProperties.heapBudget[i];
+			usages[i] = budgetProperties.heapUsage[i];
+		}
+
+		return;
+	}
+
+	for (i = 0; i < renderer->memoryProperties.memoryHeapCount; i += 1)
+	{
+		budgets[i] = renderer->memoryProperties.memoryHeaps[i].size;
+		usages[i] = 0;
+	}
+
+	for (i = 0; i < renderer->memoryProperties.memoryTypeCount; i += 1)
+	{
+		heapIndex = renderer->memoryProperties.memoryTypes[i].heapIndex;
+		usages[heapIndex] += renderer->memoryAllocator->subAllocators[i].allocatedBytes;
+	}
+}
+
+/* Fires the budget callback once per heap each time its usage rises
+ * above the threshold. Called at the end of every submit.
+ */
+static void VULKAN_INTERNAL_CheckMemoryBudget(VulkanRenderer *renderer)
+{
+	VkDeviceSize budgets[VK_MAX_MEMORY_HEAPS];
+	VkDeviceSize usages[VK_MAX_MEMORY_HEAPS];
+	Refresh_MemoryBudgetFunc callback;
+	void *userdata;
+	uint32_t crossedHeaps = 0;
 	uint32_t i;
 
-	if (computePipeline->pipelineLayout->bufferDescriptorSetCache == NULL)
+	if (renderer->memoryBudgetCallback == NULL)
 	{
 		return;
 	}
 
-	for (i = 0; i < computePipeline->pipelineLayout->bufferDescriptorSetCache->bindingCount; i += 1)
-	{
-		currentBuffer = (VulkanBuffer*) pBuffers[i];
+	SDL_LockMutex(renderer->allocatorLock);
 
-		bufferDescriptorSetData.descriptorBufferInfo[i].buffer = currentBuffer->subBuffers[currentBuffer->currentSubBufferIndex]->buffer;
-		bufferDescriptorSetData.descriptorBufferInfo[i].offset = 0;
-		bufferDescriptorSetData.descriptorBufferInfo[i].range = currentBuffer->subBuffers[currentBuffer->currentSubBufferIndex]->size;
+	VULKAN_INTERNAL_QueryHeapBudgets(renderer, budgets, usages);
 
-		VULKAN_INTERNAL_MarkAsBound(renderer, currentBuffer);
-		vulkanCommandBuffer->boundComputeBuffers[i] = currentBuffer;
+	for (i = 0; i < renderer->memoryProperties.memoryHeapCount; i += 1)
+	{
+		if ((double) usages[i] > (double) budgets[i] * renderer->memoryBudgetThreshold)
+		{
+			if (!(renderer->memoryBudgetExceededHeaps & (1 << i)))
+			{
+				renderer->memoryBudgetExceededHeaps |= (1 << i);
+				crossedHeaps |= (1 << i);
+			}
+		}
+		else
+		{
+			renderer->memoryBudgetExceededHeaps &= ~(1 << i);
+		}
 	}
 
-	vulkanCommandBuffer->boundComputeBufferCount = computePipeline->pipelineLayout->bufferDescriptorSetCache->bindingCount;
+	callback = renderer->memoryBudgetCallback;
+	userdata = renderer->memoryBudgetUserdata;
 
-	computePipeline->bufferDescriptorSet =
-		VULKAN_INTERNAL_FetchBufferDescriptorSet(
-			renderer,
-			computePipeline->pipelineLayout->bufferDescriptorSetCache,
-			&bufferDescriptorSetData
-		);
+	SDL_UnlockMutex(renderer->allocatorLock);
+
+	/* Called without locks so the application may free resources */
+	for (i = 0; i < renderer->memoryProperties.memoryHeapCount; i += 1)
+	{
+		if (callback != NULL && (crossedHeaps & (1 << i)))
+		{
+			callback(userdata, i, usages[i], budgets[i]);
+		}
+	}
 }
 
-static void VULKAN_BindComputeTextures(
-	Refresh_Renderer *driverData,
-	Refresh_CommandBuffer *commandBuffer,
-	Refresh_Texture **pTextures
-) {
-	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
-	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
-	VulkanComputePipeline *computePipeline = vulkanCommandBuffer->currentComputePipeline;
+/* Memory Defragmentation */
 
-	VulkanTexture *currentTexture;
-	ImageDescriptorSetData imageDescriptorSetData;
-	uint32_t i;
+static void VULKAN_INTERNAL_ExpireImageDescriptorSets(
+	ImageDescriptorSetCache *imageDescriptorSetCache,
+	VkImageView imageView
+) {
+	uint32_t i, j;
 
-	if (computePipeline->pipelineLayout->imageDescriptorSetCache == NULL)
+	for (i = 0; i < imageDescriptorSetCache->count; i += 1)
 	{
-		return;
+		if (!imageDescriptorSetCache->elements[i].indexed)
+		{
+			continue;
+		}
+
+		for (j = 0; j < imageDescriptorSetCache->bindingCount; j += 1)
+		{
+			if (imageDescriptorSetCache->elements[i].descriptorSetData.descriptorImageInfo[j].imageView == imageView)
+			{
+				/* Stays in the list until its last submission has finished */
+				DescriptorSetIndex_Remove(
+					&imageDescriptorSetCache->index,
+					imageDescriptorSetCache->elements[i].key,
+					i
+				);
+				imageDescriptorSetCache->elements[i].indexed = 0;
+				break;
+			}
+		}
 	}
+}
+
+static void VULKAN_INTERNAL_ExpireBufferDescriptorSets(
+	BufferDescriptorSetCache *bufferDescriptorSetCache,
+	VkBuffer buffer
+) {
+	uint32_t i, j;
 
-	for (i = 0; i < computePipeline->pipelineLayout->imageDescriptorSetCache->bindingCount; i += 1)
+	for (i = 0; i < bufferDescriptorSetCache->count; i += 1)
 	{
-		currentTexture = (VulkanTexture*) pTextures[i];
-		imageDescriptorSetData.descriptorImageInfo[i].imageView = currentTexture->view;
-		imageDescriptorSetData.descriptorImageInfo[i].sampler = VK_NULL_HANDLE;
-		imageDescriptorSetData.descriptorImageInfo[i].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-	}
+		if (!bufferDescriptorSetCache->elements[i].indexed)
+		{
+			continue;
+		}
 
-	computePipeline->imageDescriptorSet =
-		VULKAN_INTERNAL_FetchImageDescriptorSet(
-			renderer,
-			computePipeline->pipelineLayout->imageDescriptorSetCache,
-			&imageDescriptorSetData
-		);
+		for (j = 0; j < bufferDescriptorSetCache->bindingCount; j += 1)
+		{
+			if (bufferDescriptorSetCache->elements[i].descriptorSetData.descriptorBufferInfo[j].buffer == buffer)
+			{
+				/* Stays in the list until its last submission has finished */
+				DescriptorSetIndex_Remove(
+					&bufferDescriptorSetCache->index,
+					bufferDescriptorSetCache->elements[i].key,
+					i
+				);
+				bufferDescriptorSetCache->elements[i].indexed = 0;
+				break;
+			}
+		}
+	}
 }
 
-static void VULKAN_INTERNAL_AllocateCommandBuffers(
+/*
+ * Cached sets that reference a relocated handle are taken out of the
+ * lookup table so the old handle value, which the driver may reuse once
+ * it is destroyed, can never match again. They are not rewritten: the
+ * set may still be in flight, so it is only returned to the inactive
+ * list once DESCRIPTOR_SET_DEACTIVATE_FRAMES have passed since its use.
+ *
+ * The caches belong to other threads, so the handles are only queued
+ * here. Each thread applies them before its next lookup.
+ */
+static void VULKAN_INTERNAL_ExpireDescriptorSets(
 	VulkanRenderer *renderer,
-	VulkanCommandPool *vulkanCommandPool,
-	uint32_t allocateCount
+	VkImageView view, /* may be VK_NULL_HANDLE */
+	VkBuffer buffer /* may be VK_NULL_HANDLE */
 ) {
-	VkCommandBufferAllocateInfo allocateInfo;
-	VkResult vulkanResult;
-	uint32_t i;
-	VkCommandBuffer *commandBuffers = SDL_stack_alloc(VkCommandBuffer, allocateCount);
-	VulkanCommandBuffer *currentVulkanCommandBuffer;
+	uint32_t i, j;
+	VulkanCommandPool *commandPool;
+
+	SDL_LockMutex(renderer->commandPoolLock);
+
+	for (i = 0; i < NUM_COMMAND_POOL_BUCKETS; i += 1)
+	{
+		for (j = 0; j < renderer->commandPoolHashTable.buckets[i].count; j += 1)
+		{
+			commandPool = renderer->commandPoolHashTable.buckets[i].elements[j].value;
+
+			SDL_LockMutex(commandPool->expirationLock);
+
+			if (view != VK_NULL_HANDLE)
+			{
+				EXPAND_ARRAY_IF_NEEDED(
+					commandPool->expiredImageViews,
+					VkImageView,
+					commandPool->expiredImageViewCount + 1,
+					commandPool->expiredImageViewCapacity,
+					commandPool->expiredImageViewCapacity * 2 + 4
+				);
+
+				commandPool->expiredImageViews[commandPool->expiredImageViewCount] = view;
+				commandPool->expiredImageViewCount += 1;
+			}
+
+			if (buffer != VK_NULL_HANDLE)
+			{
+				EXPAND_ARRAY_IF_NEEDED(
+					commandPool->expiredBuffers,
+					VkBuffer,
+					commandPool->expiredBufferCount + 1,
+					commandPool->expiredBufferCapacity,
+					commandPool->expiredBufferCapacity * 2 + 4
+				);
+
+				commandPool->expiredBuffers[commandPool->expiredBufferCount] = buffer;
+				commandPool->expiredBufferCount += 1;
+			}
 
-	vulkanCommandPool->inactiveCommandBufferCapacity += allocateCount;
+			SDL_AtomicSet(&commandPool->expirationPending, 1);
 
-	vulkanCommandPool->inactiveCommandBuffers = SDL_realloc(
-		vulkanCommandPool->inactiveCommandBuffers,
-		sizeof(VulkanCommandBuffer*) *
-		vulkanCommandPool->inactiveCommandBufferCapacity
-	);
+			SDL_UnlockMutex(commandPool->expirationLock);
+		}
+	}
 
-	allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-	allocateInfo.pNext = NULL;
-	allocateInfo.commandPool = vulkanCommandPool->commandPool;
-	allocateInfo.commandBufferCount = allocateCount;
-	allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+	SDL_UnlockMutex(renderer->commandPoolLock);
+}
 
-	vulkanResult = renderer->vkAllocateCommandBuffers(
-		renderer->logicalDevice,
-		&allocateInfo,
-		commandBuffers
-	);
+/* Runs on the thread owning the command pool, before it looks up a set */
+static void VULKAN_INTERNAL_ApplyDescriptorSetExpirations(
+	VulkanCommandPool *commandPool
+) {
+	uint32_t i, k;
 
-	if (vulkanResult != VK_SUCCESS)
+	SDL_LockMutex(commandPool->expirationLock);
+
+	/* Caches that hold no sets have nothing to expire */
+	for (i = 0; i < commandPool->expiredImageViewCount; i += 1)
 	{
-		LogVulkanResultAsError("vkAllocateCommandBuffers", vulkanResult);
-		SDL_stack_free(commandBuffers);
-		return;
+		for (k = 0; k < commandPool->activeImageDescriptorSetCacheCount; k += 1)
+		{
+			VULKAN_INTERNAL_ExpireImageDescriptorSets(
+				commandPool->activeImageDescriptorSetCaches[k],
+				commandPool->expiredImageViews[i]
+			);
+		}
 	}
 
-	for (i = 0; i < allocateCount; i += 1)
+	for (i = 0; i < commandPool->expiredBufferCount; i += 1)
 	{
-		currentVulkanCommandBuffer = SDL_malloc(sizeof(VulkanCommandBuffer));
-		currentVulkanCommandBuffer->commandPool = vulkanCommandPool;
-		currentVulkanCommandBuffer->commandBuffer = commandBuffers[i];
-		vulkanCommandPool->inactiveCommandBuffers[
-			vulkanCommandPool->inactiveCommandBufferCount
-		] = currentVulkanCommandBuffer;
-		vulkanCommandPool->inactiveCommandBufferCount += 1;
+		for (k = 0; k < commandPool->activeBufferDescriptorSetCacheCount; k += 1)
+		{
+			VULKAN_INTERNAL_ExpireBufferDescriptorSets(
+				commandPool->activeBufferDescriptorSetCaches[k],
+				commandPool->expiredBuffers[i]
+			);
+		}
 	}
 
-	SDL_stack_free(commandBuffers);
+	commandPool->expiredImageViewCount = 0;
+	commandPool->expiredBufferCount = 0;
+	SDL_AtomicSet(&commandPool->expirationPending, 0);
+
+	SDL_UnlockMutex(commandPool->expirationLock);
 }
 
-static VulkanCommandPool* VULKAN_INTERNAL_FetchCommandPool(
+/* Moves a texture to a new region of its memory type with a GPU copy.
+ * The old image is returned in pGhost so it can be destroyed once the
+ * copy and any in-flight work using it have finished.
+ */
+static uint8_t VULKAN_INTERNAL_RelocateTexture(
 	VulkanRenderer *renderer,
-	SDL_threadID threadID
+	VulkanTexture *texture,
+	VulkanTexture **pGhost
 ) {
-	VulkanCommandPool *vulkanCommandPool;
-	VkCommandPoolCreateInfo commandPoolCreateInfo;
+	VulkanMemorySubAllocator *allocator = texture->allocation->allocator;
+	uint32_t memoryTypeIndex = (uint32_t) (allocator - renderer->memoryAllocator->subAllocators);
+	VkImageCreateInfo imageCreateInfo;
+	VkImageViewCreateInfo imageViewCreateInfo;
+	VkImageMemoryRequirementsInfo2KHR imageRequirementsInfo;
+	VkMemoryRequirements2KHR memoryRequirements;
+	VkComponentMapping swizzle = IDENTITY_SWIZZLE;
+	VkImageAspectFlags aspectMask;
+	VkImageCopy *imageCopies;
+	VkCommandBuffer commandBuffer;
+	VkImage image;
+	VkImageView view;
+	VulkanMemoryRegion *region;
+	VkDeviceSize alignedOffset;
+	VulkanResourceAccessType originalAccess = texture->resourceAccessType;
+	VulkanResourceAccessType newAccess = RESOURCE_ACCESS_NONE;
+	VulkanTexture *ghost;
 	VkResult vulkanResult;
-	CommandPoolHash commandPoolHash;
-
-	commandPoolHash.threadID = threadID;
+	uint32_t i;
 
-	vulkanCommandPool = CommandPoolHashTable_Fetch(
-		&renderer->commandPoolHashTable,
-		commandPoolHash
-	);
+	if (IsDepthFormat(texture->format))
+	{
+		aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
 
-	if (vulkanCommandPool != NULL)
+		if (IsStencilFormat(texture->format))
+		{
+			aspectMask |= VK_IMAGE_ASPECT_STENCIL_BIT;
+		}
+	}
+	else
 	{
-		return vulkanCommandPool;
+		aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
 	}
 
-	vulkanCommandPool = (VulkanCommandPool*) SDL_malloc(sizeof(VulkanCommandPool));
+	imageCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+	imageCreateInfo.pNext = NULL;
+	imageCreateInfo.flags = 0;
+	imageCreateInfo.imageType = texture->is3D ? VK_IMAGE_TYPE_3D : VK_IMAGE_TYPE_2D;
+	imageCreateInfo.format = texture->format;
+	imageCreateInfo.extent.width = texture->dimensions.width;
+	imageCreateInfo.extent.height = texture->dimensions.height;
+	imageCreateInfo.extent.depth = texture->depth;
+	imageCreateInfo.mipLevels = texture->levelCount;
+	imageCreateInfo.arrayLayers = texture->layerCount;
+	imageCreateInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+	imageCreateInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+	imageCreateInfo.usage = texture->usageFlags;
+	imageCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+	imageCreateInfo.queueFamilyIndexCount = 0;
+	imageCreateInfo.pQueueFamilyIndices = NULL;
+	imageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
 
-	commandPoolCreateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
-	commandPoolCreateInfo.pNext = NULL;
-	commandPoolCreateInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
-	commandPoolCreateInfo.queueFamilyIndex = renderer->queueFamilyIndices.graphicsFamily;
+	if (texture->isCube)
+	{
+		imageCreateInfo.flags |= VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT;
+	}
+	else if (texture->is3D)
+	{
+		imageCreateInfo.flags |= VK_IMAGE_CREATE_2D_ARRAY_COMPATIBLE_BIT;
+	}
 
-	vulkanResult = renderer->vkCreateCommandPool(
+	vulkanResult = renderer->vkCreateImage(
 		renderer->logicalDevice,
-		&commandPoolCreateInfo,
+		&imageCreateInfo,
 		NULL,
-		&vulkanCommandPool->commandPool
+		&image
 	);
 
 	if (vulkanResult != VK_SUCCESS)
 	{
-		Refresh_LogError("Failed to create command pool!");
-		LogVulkanResultAsError("vkCreateCommandPool", vulkanResult);
-		return NULL;
+		LogVulkanResultAsError("vkCreateImage", vulkanResult);
+		return 0;
 	}
 
-	vulkanCommandPool->threadID = threadID;
+	imageRequirementsInfo.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_REQUIREMENTS_INFO_2_KHR;
+	imageRequirementsInfo.pNext = NULL;
+	imageRequirementsInfo.image = image;
 
-	vulkanCommandPool->inactiveCommandBufferCapacity = 0;
-	vulkanCommandPool->inactiveCommandBufferCount = 0;
-	vulkanCommandPool->inactiveCommandBuffers = NULL;
+	memoryRequirements.sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2_KHR;
+	memoryRequirements.pNext = NULL;
 
-	VULKAN_INTERNAL_AllocateCommandBuffers(
-		renderer,
-		vulkanCommandPool,
-		2
+	renderer->vkGetImageMemoryRequirements2KHR(
+		renderer->logicalDevice,
+		&imageRequirementsInfo,
+		&memoryRequirements
 	);
 
-	CommandPoolHashTable_Insert(
-		&renderer->commandPoolHashTable,
-		commandPoolHash,
-		vulkanCommandPool
+	region = NULL;
+
+	if (memoryRequirements.memoryRequirements.memoryTypeBits & (1 << memoryTypeIndex))
+	{
+		region = VULKAN_INTERNAL_SearchBestFitRegion(
+			allocator,
+			memoryRequirements.memoryRequirements.size,
+			memoryRequirements.memoryRequirements.alignment,
+			&alignedOffset
+		);
+	}
+
+	if (region == NULL)
+	{
+		renderer->vkDestroyImage(renderer->logicalDevice, image, NULL);
+		return 0;
+	}
+
+	region = VULKAN_INTERNAL_SplitFreeRegion(
+		renderer->memoryAllocator,
+		region,
+		alignedOffset,
+		memoryRequirements.memoryRequirements.size
 	);
 
-	return vulkanCommandPool;
-}
+	/* The ghost gives back the old size when it is destroyed */
+	VULKAN_INTERNAL_TrackResourceMemory(allocator, 0, region->size);
 
-static VulkanCommandBuffer* VULKAN_INTERNAL_GetInactiveCommandBufferFromPool(
-	VulkanRenderer *renderer,
-	SDL_threadID threadID
-) {
-	VulkanCommandPool *commandPool =
-		VULKAN_INTERNAL_FetchCommandPool(renderer, threadID);
-	VulkanCommandBuffer *commandBuffer;
+	SDL_LockMutex(region->allocation->memoryLock);
 
-	if (commandPool->inactiveCommandBufferCount == 0)
+	vulkanResult = renderer->vkBindImageMemory(
+		renderer->logicalDevice,
+		image,
+		region->allocation->memory,
+		region->offset
+	);
+
+	SDL_UnlockMutex(region->allocation->memoryLock);
+
+	if (vulkanResult != VK_SUCCESS)
 	{
-		VULKAN_INTERNAL_AllocateCommandBuffers(
-			renderer,
-			commandPool,
-			commandPool->inactiveCommandBufferCapacity
-		);
+		LogVulkanResultAsError("vkBindImageMemory", vulkanResult);
+		VULKAN_INTERNAL_UntrackResourceMemory(allocator, 0, region->size);
+		VULKAN_INTERNAL_FreeUsedRegion(renderer->memoryAllocator, region);
+		renderer->vkDestroyImage(renderer->logicalDevice, image, NULL);
+		return 0;
 	}
 
-	commandBuffer = commandPool->inactiveCommandBuffers[commandPool->inactiveCommandBufferCount - 1];
-	commandPool->inactiveCommandBufferCount -= 1;
+	imageViewCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+	imageViewCreateInfo.pNext = NULL;
+	imageViewCreateInfo.flags = 0;
+	imageViewCreateInfo.image = image;
+	if (texture->isCube)
+	{
+		imageViewCreateInfo.viewType = VK_IMAGE_VIEW_TYPE_CUBE;
+	}
+	else if (texture->is3D)
+	{
+		imageViewCreateInfo.viewType = VK_IMAGE_VIEW_TYPE_3D;
+	}
+	else
+	{
+		imageViewCreateInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+	}
+	imageViewCreateInfo.format = texture->format;
+	imageViewCreateInfo.components = swizzle;
+	imageViewCreateInfo.subresourceRange.aspectMask = aspectMask;
+	imageViewCreateInfo.subresourceRange.baseMipLevel = 0;
+	imageViewCreateInfo.subresourceRange.levelCount = texture->levelCount;
+	imageViewCreateInfo.subresourceRange.baseArrayLayer = 0;
+	imageViewCreateInfo.subresourceRange.layerCount = texture->layerCount;
 
-	return commandBuffer;
-}
+	vulkanResult = renderer->vkCreateImageView(
+		renderer->logicalDevice,
+		&imageViewCreateInfo,
+		NULL,
+		&view
+	);
 
-static Refresh_CommandBuffer* VULKAN_AcquireCommandBuffer(
-	Refresh_Renderer *driverData,
-	uint8_t fixed
-) {
-	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
-	uint32_t i;
+	if (vulkanResult != VK_SUCCESS)
+	{
+		LogVulkanResultAsError("vkCreateImageView", vulkanResult);
+		VULKAN_INTERNAL_UntrackResourceMemory(allocator, 0, region->size);
+		VULKAN_INTERNAL_FreeUsedRegion(renderer->memoryAllocator, region);
+		renderer->vkDestroyImage(renderer->logicalDevice, image, NULL);
+		return 0;
+	}
 
-	SDL_threadID threadID = SDL_ThreadID();
+	/* Textures that were never written have no contents to copy */
+	if (originalAccess != RESOURCE_ACCESS_NONE)
+	{
+		VULKAN_INTERNAL_MaybeBeginTransferCommandBuffer(renderer);
+		commandBuffer = renderer->transferCommandBuffers[renderer->frameIndex];
 
-	VulkanCommandBuffer *commandBuffer =
-		VULKAN_INTERNAL_GetInactiveCommandBufferFromPool(renderer, threadID);
+		VULKAN_INTERNAL_ImageMemoryBarrier(
+			renderer,
+			commandBuffer,
+			RESOURCE_ACCESS_TRANSFER_READ,
+			aspectMask,
+			0,
+			texture->layerCount,
+			0,
+			texture->levelCount,
+			0,
+			texture->image,
+			&texture->resourceAccessType
+		);
 
-	/* State tracking */
+		VULKAN_INTERNAL_ImageMemoryBarrier(
+			renderer,
+			commandBuffer,
+			RESOURCE_ACCESS_TRANSFER_WRITE,
+			aspectMask,
+			0,
+			texture->layerCount,
+			0,
+			texture->levelCount,
+			1,
+			image,
+			&newAccess
+		);
 
-	commandBuffer->currentComputePipeline = NULL;
-	commandBuffer->currentGraphicsPipeline = NULL;
-	commandBuffer->currentFramebuffer = NULL;
+		imageCopies = SDL_stack_alloc(VkImageCopy, texture->levelCount);
 
-	/* init bound compute buffer array */
+		for (i = 0; i < texture->levelCount; i += 1)
+		{
+			imageCopies[i].srcSubresource.aspectMask = aspectMask;
+			imageCopies[i].srcSubresource.mipLevel = i;
+			imageCopies[i].srcSubresource.baseArrayLayer = 0;
+			imageCopies[i].srcSubresource.layerCount = texture->layerCount;
+			imageCopies[i].srcOffset.x = 0;
+			imageCopies[i].srcOffset.y = 0;
+			imageCopies[i].srcOffset.z = 0;
+			imageCopies[i].dstSubresource = imageCopies[i].srcSubresource;
+			imageCopies[i].dstOffset = imageCopies[i].srcOffset;
+			imageCopies[i].extent.width = SDL_max(1, texture->dimensions.width >> i);
+			imageCopies[i].extent.height = SDL_max(1, texture->dimensions.height >> i);
+			imageCopies[i].extent.depth = SDL_max(1, texture->depth >> i);
+		}
 
-	for (i = 0; i < MAX_BUFFER_BINDINGS; i += 1)
-	{
-		commandBuffer->boundComputeBuffers[i] = NULL;
+		renderer->vkCmdCopyImage(
+			commandBuffer,
+			texture->image,
+			AccessMap[texture->resourceAccessType].imageLayout,
+			image,
+			AccessMap[newAccess].imageLayout,
+			texture->levelCount,
+			imageCopies
+		);
+
+		SDL_stack_free(imageCopies);
+
+		VULKAN_INTERNAL_ImageMemoryBarrier(
+			renderer,
+			commandBuffer,
+			originalAccess,
+			aspectMask,
+			0,
+			texture->layerCount,
+			0,
+			texture->levelCount,
+			0,
+			image,
+			&newAccess
+		);
 	}
-	commandBuffer->boundComputeBufferCount = 0;
 
-	commandBuffer->fixed = fixed;
-	commandBuffer->submitted = 0;
+	ghost = (VulkanTexture*) SDL_malloc(sizeof(VulkanTexture));
+	*ghost = *texture;
+	ghost->usedRegion->texture = NULL;
 
-	VULKAN_INTERNAL_BeginCommandBuffer(renderer, commandBuffer);
+	texture->allocation = region->allocation;
+	texture->usedRegion = region;
+	texture->offset = region->offset;
+	texture->memorySize = region->size;
+	texture->image = image;
+	texture->view = view;
+	texture->resourceAccessType = newAccess;
+	region->texture = texture;
 
-	return (Refresh_CommandBuffer*) commandBuffer;
+	*pGhost = ghost;
+	return 1;
 }
 
-static void VULKAN_QueuePresent(
-	Refresh_Renderer *driverData,
-	Refresh_CommandBuffer *commandBuffer,
-	Refresh_TextureSlice *textureSlice,
-	Refresh_Rect *destinationRectangle,
-	Refresh_Filter filter
+/* Moves an idle host-visible sub-buffer to a new region of its memory type.
+ * Sub-buffers not bound by any in-flight frame can be copied on the CPU,
+ * and later SetBufferData calls land in the new location right away.
+ */
+static uint8_t VULKAN_INTERNAL_RelocateSubBuffer(
+	VulkanRenderer *renderer,
+	VulkanBuffer *buffer,
+	uint32_t subBufferIndex,
+	VulkanBuffer **pGhost
 ) {
-	VkResult acquireResult;
-	uint32_t swapChainImageIndex;
+	VulkanSubBuffer *subBuffer = buffer->subBuffers[subBufferIndex];
+	VulkanMemorySubAllocator *allocator = subBuffer->allocation->allocator;
+	uint32_t memoryTypeIndex = (uint32_t) (allocator - renderer->memoryAllocator->subAllocators);
+	VkBufferCreateInfo bufferCreateInfo;
+	VkBufferMemoryRequirementsInfo2KHR bufferRequirementsInfo;
+	VkMemoryRequirements2KHR memoryRequirements;
+	VkBuffer vulkanBuffer;
+	VulkanMemoryRegion *region;
+	VkDeviceSize alignedOffset;
+	VulkanBuffer *ghost;
+	VkResult vulkanResult;
 
-	Refresh_Rect dstRect;
+	bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+	bufferCreateInfo.pNext = NULL;
+	bufferCreateInfo.flags = 0;
+	bufferCreateInfo.size = buffer->size;
+	bufferCreateInfo.usage = buffer->usage;
+	bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+	bufferCreateInfo.queueFamilyIndexCount = 1;
+	bufferCreateInfo.pQueueFamilyIndices = &renderer->queueFamilyIndices.graphicsFamily;
 
-	VulkanRenderer* renderer = (VulkanRenderer*) driverData;
-	VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer*) commandBuffer;
-	VulkanTexture* vulkanTexture = (VulkanTexture*) textureSlice->texture;
+	vulkanResult = renderer->vkCreateBuffer(
+		renderer->logicalDevice,
+		&bufferCreateInfo,
+		NULL,
+		&vulkanBuffer
+	);
 
-	if (renderer->headless)
+	if (vulkanResult != VK_SUCCESS)
 	{
-		Refresh_LogError("Cannot call QueuePresent in headless mode!");
-		return;
+		LogVulkanResultAsError("vkCreateBuffer", vulkanResult);
+		return 0;
 	}
 
-	acquireResult = renderer->vkAcquireNextImageKHR(
+	bufferRequirementsInfo.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_REQUIREMENTS_INFO_2_KHR;
+	bufferRequirementsInfo.pNext = NULL;
+	bufferRequirementsInfo.buffer = vulkanBuffer;
+
+	memoryRequirements.sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2_KHR;
+	memoryRequirements.pNext = NULL;
+
+	renderer->vkGetBufferMemoryRequirements2KHR(
 		renderer->logicalDevice,
-		renderer->swapChain,
-		UINT64_MAX,
-		renderer->imageAvailableSemaphore,
-		VK_NULL_HANDLE,
-		&swapChainImageIndex
+		&bufferRequirementsInfo,
+		&memoryRequirements
 	);
 
-	if (acquireResult != VK_SUCCESS && acquireResult != VK_SUBOPTIMAL_KHR)
+	region = NULL;
+
+	if (memoryRequirements.memoryRequirements.memoryTypeBits & (1 << memoryTypeIndex))
 	{
-		/* Failed to acquire swapchain image, mark that we need a new one */
-		renderer->needNewSwapChain = 1;
-		return;
+		region = VULKAN_INTERNAL_SearchBestFitRegion(
+			allocator,
+			memoryRequirements.memoryRequirements.size,
+			memoryRequirements.memoryRequirements.alignment,
+			&alignedOffset
+		);
 	}
 
-	renderer->shouldPresent = 1;
-	renderer->swapChainImageAcquired = 1;
-	renderer->currentSwapChainIndex = swapChainImageIndex;
+	if (region == NULL)
+	{
+		renderer->vkDestroyBuffer(renderer->logicalDevice, vulkanBuffer, NULL);
+		return 0;
+	}
 
-	if (destinationRectangle != NULL)
+	region = VULKAN_INTERNAL_SplitFreeRegion(
+		renderer->memoryAllocator,
+		region,
+		alignedOffset,
+		memoryRequirements.memoryRequirements.size
+	);
+
+	VULKAN_INTERNAL_TrackResourceMemory(allocator, 1, region->size);
+
+	SDL_LockMutex(region->allocation->memoryLock);
+
+	vulkanResult = renderer->vkBindBufferMemory(
+		renderer->logicalDevice,
+		vulkanBuffer,
+		region->allocation->memory,
+		region->offset
+	);
+
+	SDL_UnlockMutex(region->allocation->memoryLock);
+
+	if (vulkanResult != VK_SUCCESS)
 	{
-		dstRect = *destinationRectangle;
+		LogVulkanResultAsError("vkBindBufferMemory", vulkanResult);
+		VULKAN_INTERNAL_UntrackResourceMemory(allocator, 1, region->size);
+		VULKAN_INTERNAL_FreeUsedRegion(renderer->memoryAllocator, region);
+		renderer->vkDestroyBuffer(renderer->logicalDevice, vulkanBuffer, NULL);
+		return 0;
 	}
-	else
+
+	SDL_memcpy(
+		region->allocation->mapPointer + region->offset,
+		subBuffer->allocation->mapPointer + subBuffer->offset,
+		buffer->size
+	);
+
+	ghost = (VulkanBuffer*) SDL_malloc(sizeof(VulkanBuffer));
+	ghost->size = buffer->size;
+	ghost->subBufferCount = 1;
+	ghost->subBuffers = SDL_malloc(sizeof(VulkanSubBuffer*));
+	ghost->subBuffers[0] = SDL_malloc(sizeof(VulkanSubBuffer));
+	*ghost->subBuffers[0] = *subBuffer;
+	ghost->subBuffers[0]->usedRegion->buffer = NULL;
+	ghost->currentSubBufferIndex = 0;
+	ghost->resourceAccessType = buffer->resourceAccessType;
+	ghost->usage = buffer->usage;
+	ghost->bound = 0;
+	ghost->boundSubmitted = 0;
+	ghost->memoryUsage = VULKAN_BUFFER_MEMORY_HOST;
+	ghost->mapped = 0;
+
+	subBuffer->allocation = region->allocation;
+	subBuffer->usedRegion = region;
+	subBuffer->buffer = vulkanBuffer;
+	subBuffer->offset = region->offset;
+	subBuffer->size = region->size;
+	region->buffer = buffer;
+	region->subBufferIndex = subBufferIndex;
+
+	*pGhost = ghost;
+	return 1;
+}
+
+static uint8_t VULKAN_INTERNAL_IsRegionMovable(VulkanMemoryRegion *region)
+{
+	if (region->isFree)
 	{
-		dstRect.x = 0;
-		dstRect.y = 0;
-		dstRect.w = renderer->swapChainExtent.width;
-		dstRect.h = renderer->swapChainExtent.height;
+		return 0;
 	}
 
-	/* Blit! */
+	/* Textures recorded by unsubmitted command buffers have to stay put.
+	 * Render targets and bindless textures are referenced through views
+	 * and descriptors that are never rewritten, and exported handles are
+	 * held by the client, so those stay put too.
+	 */
+	if (region->texture != NULL)
+	{
+		return (
+			SDL_AtomicGet(&region->texture->recordingRefs) == 0 &&
+			!region->texture->handlesExported &&
+			region->texture->bindlessIndex == REFRESH_BINDLESS_INDEX_NONE &&
+			(region->texture->usageFlags & (
+				VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT |
+				VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT
+			)) == 0
+		);
+	}
 
-	VULKAN_INTERNAL_BlitImage(
-		renderer,
-		vulkanCommandBuffer->commandBuffer,
-		&textureSlice->rectangle,
-		textureSlice->depth,
-		textureSlice->layer,
-		textureSlice->level,
-		vulkanTexture->image,
-		&vulkanTexture->resourceAccessType,
-		vulkanTexture->resourceAccessType,
-		&dstRect,
-		0,
-		0,
-		0,
-		renderer->swapChainImages[swapChainImageIndex],
-		&renderer->swapChainResourceAccessTypes[swapChainImageIndex],
-		RESOURCE_ACCESS_PRESENT,
-		RefreshToVK_Filter[filter]
+	/* Sub-buffers in use by a frame in flight or the client have to stay put */
+	return (
+		region->buffer != NULL &&
+		region->buffer->memoryUsage == VULKAN_BUFFER_MEMORY_HOST &&
+		!region->buffer->mapped &&
+		region->allocation->mapPointer != NULL &&
+		region->buffer->subBuffers[region->subBufferIndex]->bound == -1
 	);
 }
 
-static void VULKAN_INTERNAL_DeactivateUnusedBufferDescriptorSets(
-	BufferDescriptorSetCache *bufferDescriptorSetCache
+/* The emptiest block below half usage. Block usage only changes when a
+ * region is split or freed, so the choice is kept until that happens.
+ */
+static VulkanMemoryAllocation* VULKAN_INTERNAL_SelectDefragmentSource(
+	VulkanMemorySubAllocator *allocator
 ) {
-	int32_t i, j;
-	BufferDescriptorSetHashArray *arr;
+	VulkanMemoryAllocation *allocation, *source = NULL;
+	uint32_t i;
 
-	for (i = bufferDescriptorSetCache->count - 1; i >= 0; i -= 1)
+	if (!allocator->defragmentSourceDirty)
 	{
-		bufferDescriptorSetCache->elements[i].inactiveFrameCount += 1;
+		return allocator->defragmentSource;
+	}
+
+	allocator->defragmentSourceDirty = 0;
 
-		if (bufferDescriptorSetCache->elements[i].inactiveFrameCount + 1 > DESCRIPTOR_SET_DEACTIVATE_FRAMES)
+	if (allocator->allocationCount >= 2)
+	{
+		for (i = 0; i < allocator->allocationCount; i += 1)
 		{
-			arr = &bufferDescriptorSetCache->buckets[bufferDescriptorSetCache->elements[i].key % NUM_DESCRIPTOR_SET_HASH_BUCKETS];
+			allocation = allocator->allocations[i];
 
-			/* remove index from bucket */
-			for (j = 0; j < arr->count; j += 1)
+			if (	allocation->usedRegionCount == 0 ||
+				allocation->usedBytes * 2 > allocation->size ||
+				(source != NULL && allocation->usedBytes >= source->usedBytes)	)
 			{
-				if (arr->elements[j] == i)
-				{
-					if (j < arr->count - 1)
-					{
-						arr->elements[j] = arr->elements[arr->count - 1];
-					}
-
-					arr->count -= 1;
-					break;
-				}
+				continue;
 			}
 
-			/* remove element from table and place in inactive sets */
+			source = allocation;
+		}
+	}
 
-			bufferDescriptorSetCache->inactiveDescriptorSets[bufferDescriptorSetCache->inactiveDescriptorSetCount] = bufferDescriptorSetCache->elements[i].descriptorSet;
-			bufferDescriptorSetCache->inactiveDescriptorSetCount += 1;
+	allocator->defragmentSource = source;
+	return source;
+}
 
-			/* move another descriptor set to fill the hole */
-			if (i < bufferDescriptorSetCache->count - 1)
-			{
-				bufferDescriptorSetCache->elements[i] = bufferDescriptorSetCache->elements[bufferDescriptorSetCache->count - 1];
+/*
+ * Incrementally evacuates the sparsest block of each memory type into
+ * fuller blocks, moving at most DEFRAGMENT_BYTES_PER_FRAME per call.
+ * Runs after submission so copies are recorded into the next frame's
+ * transfer commands, ahead of any command that uses the new handles.
+ * A memory type whose pass moves nothing, because its regions are pinned
+ * or the fuller blocks have no room, is skipped for a growing number of
+ * submissions instead of being retried every frame.
+ * Old handles are queued for destruction like any disposed resource,
+ * and emptied blocks are released by ReleaseEmptyAllocations.
+ */
+static void VULKAN_INTERNAL_DefragmentMemory(VulkanRenderer *renderer)
+{
+	VulkanMemorySubAllocator *allocator;
+	VulkanMemoryAllocation *source, *allocation;
+	VulkanMemoryRegion *region, *nextRegion;
+	VulkanTexture *ghostTexture;
+	VulkanBuffer *ghostBuffer;
+	VulkanTexture **ghostTextures = NULL;
+	VulkanBuffer **ghostBuffers = NULL;
+	uint32_t ghostTextureCount = 0;
+	uint32_t ghostBufferCount = 0;
+	VkDeviceSize budget = DEFRAGMENT_BYTES_PER_FRAME;
+	uint32_t i, j;
+	uint8_t moved, movedAny;
 
-				/* update index in bucket */
-				arr = &bufferDescriptorSetCache->buckets[bufferDescriptorSetCache->elements[i].key % NUM_DESCRIPTOR_SET_HASH_BUCKETS];
+	SDL_LockMutex(renderer->allocatorLock);
 
-				for (j = 0; j < arr->count; j += 1)
-				{
-					if (arr->elements[j] == bufferDescriptorSetCache->count - 1)
-					{
-						arr->elements[j] = i;
-						break;
-					}
-				}
-			}
+	if (!renderer->memoryAllocator->defragmentationEnabled)
+	{
+		SDL_UnlockMutex(renderer->allocatorLock);
+		return;
+	}
 
-			bufferDescriptorSetCache->count -= 1;
+	for (i = 0; i < VK_MAX_MEMORY_TYPES && budget > 0; i += 1)
+	{
+		allocator = &renderer->memoryAllocator->subAllocators[i];
+
+		if (allocator->defragmentBackoff > 0)
+		{
+			allocator->defragmentBackoff -= 1;
+			continue;
 		}
-	}
-}
 
-static void VULKAN_INTERNAL_DeactivateUnusedImageDescriptorSets(
-	ImageDescriptorSetCache *imageDescriptorSetCache
-) {
-	int32_t i, j;
-	ImageDescriptorSetHashArray *arr;
+		source = VULKAN_INTERNAL_SelectDefragmentSource(allocator);
 
-	for (i = imageDescriptorSetCache->count - 1; i >= 0; i -= 1)
-	{
-		imageDescriptorSetCache->elements[i].inactiveFrameCount += 1;
+		if (source == NULL)
+		{
+			continue;
+		}
 
-		if (imageDescriptorSetCache->elements[i].inactiveFrameCount + 1 > DESCRIPTOR_SET_DEACTIVATE_FRAMES)
+		/* Only move into fuller blocks, otherwise two sparse blocks could trade
+		 * resources back and forth. Hide the other free space while we work.
+		 */
+		for (j = 0; j < allocator->allocationCount; j += 1)
 		{
-			arr = &imageDescriptorSetCache->buckets[imageDescriptorSetCache->elements[i].key % NUM_DESCRIPTOR_SET_HASH_BUCKETS];
+			allocation = allocator->allocations[j];
 
-			/* remove index from bucket */
-			for (j = 0; j < arr->count; j += 1)
+			if (allocation->usedBytes > source->usedBytes)
 			{
-				if (arr->elements[j] == i)
-				{
-					if (j < arr->count - 1)
-					{
-						arr->elements[j] = arr->elements[arr->count - 1];
-					}
+				continue;
+			}
 
-					arr->count -= 1;
-					break;
+			for (region = allocation->firstRegion; region != NULL; region = region->nextPhysical)
+			{
+				if (region->isFree)
+				{
+					VULKAN_INTERNAL_RemoveFreeRegion(allocator, region);
+					region->isFree = 1;
 				}
 			}
+		}
 
-			/* remove element from table and place in inactive sets */
+		movedAny = 0;
 
-			imageDescriptorSetCache->inactiveDescriptorSets[imageDescriptorSetCache->inactiveDescriptorSetCount] = imageDescriptorSetCache->elements[i].descriptorSet;
-			imageDescriptorSetCache->inactiveDescriptorSetCount += 1;
+		for (region = source->firstRegion; region != NULL; region = nextRegion)
+		{
+			nextRegion = region->nextPhysical;
+
+			if (!VULKAN_INTERNAL_IsRegionMovable(region))
+			{
+				continue;
+			}
 
-			/* move another descriptor set to fill the hole */
-			if (i < imageDescriptorSetCache->count - 1)
+			/* Always allow one move so large resources aren't stuck forever */
+			if (region->size > budget && budget < DEFRAGMENT_BYTES_PER_FRAME)
 			{
-				imageDescriptorSetCache->elements[i] = imageDescriptorSetCache->elements[imageDescriptorSetCache->count - 1];
+				break;
+			}
 
-				/* update index in bucket */
-				arr = &imageDescriptorSetCache->buckets[imageDescriptorSetCache->elements[i].key % NUM_DESCRIPTOR_SET_HASH_BUCKETS];
+			if (region->texture != NULL)
+			{
+				moved = VULKAN_INTERNAL_RelocateTexture(
+					renderer,
+					region->texture,
+					&ghostTexture
+				);
 
-				for (j = 0; j < arr->count; j += 1)
+				if (moved)
 				{
-					if (arr->elements[j] == imageDescriptorSetCache->count - 1)
-					{
-						arr->elements[j] = i;
-						break;
-					}
+					ghostTextures = SDL_realloc(
+						ghostTextures,
+						sizeof(VulkanTexture*) * (ghostTextureCount + 1)
+					);
+					ghostTextures[ghostTextureCount] = ghostTexture;
+					ghostTextureCount += 1;
 				}
 			}
+			else
+			{
+				moved = VULKAN_INTERNAL_RelocateSubBuffer(
+					renderer,
+					region->buffer,
+					region->subBufferIndex,
+					&ghostBuffer
+				);
 
-			imageDescriptorSetCache->count -= 1;
-		}
-	}
-}
-
-static void VULKAN_INTERNAL_ResetDescriptorSetData(VulkanRenderer *renderer)
-{
-	uint32_t i, j;
-	VulkanGraphicsPipelineLayout *graphicsPipelineLayout;
-	VulkanComputePipelineLayout *computePipelineLayout;
-
-	for (i = 0; i < NUM_PIPELINE_LAYOUT_BUCKETS; i += 1)
-	{
-		for (j = 0; j < renderer->graphicsPipelineLayoutHashTable.buckets[i].count; j += 1)
-		{
-			graphicsPipelineLayout = renderer->graphicsPipelineLayoutHashTable.buckets[i].elements[j].value;
+				if (moved)
+				{
+					ghostBuffers = SDL_realloc(
+						ghostBuffers,
+						sizeof(VulkanBuffer*) * (ghostBufferCount + 1)
+					);
+					ghostBuffers[ghostBufferCount] = ghostBuffer;
+					ghostBufferCount += 1;
+				}
+			}
 
-			if (graphicsPipelineLayout->vertexSamplerDescriptorSetCache != NULL)
+			/* No room left in the fuller blocks */
+			if (!moved)
 			{
-				VULKAN_INTERNAL_DeactivateUnusedImageDescriptorSets(
-					graphicsPipelineLayout->vertexSamplerDescriptorSetCache
-				);
+				break;
 			}
 
-			if (graphicsPipelineLayout->fragmentSamplerDescriptorSetCache != NULL)
+			movedAny = 1;
+			budget = (region->size >= budget) ? 0 : budget - region->size;
+
+			if (budget == 0)
 			{
-				VULKAN_INTERNAL_DeactivateUnusedImageDescriptorSets(
-					graphicsPipelineLayout->fragmentSamplerDescriptorSetCache
-				);
+				break;
 			}
 		}
 
-		for (j = 0; j < renderer->computePipelineLayoutHashTable.buckets[i].count; j += 1)
+		for (j = 0; j < allocator->allocationCount; j += 1)
 		{
-			computePipelineLayout = renderer->computePipelineLayoutHashTable.buckets[i].elements[j].value;
+			allocation = allocator->allocations[j];
 
-			if (computePipelineLayout->bufferDescriptorSetCache != NULL)
+			if (allocation->usedBytes > source->usedBytes)
 			{
-				VULKAN_INTERNAL_DeactivateUnusedBufferDescriptorSets(
-					computePipelineLayout->bufferDescriptorSetCache
-				);
+				continue;
 			}
 
-			if (computePipelineLayout->imageDescriptorSetCache != NULL)
+			for (region = allocation->firstRegion; region != NULL; region = region->nextPhysical)
 			{
-				VULKAN_INTERNAL_DeactivateUnusedImageDescriptorSets(
-					computePipelineLayout->imageDescriptorSetCache
-				);
+				if (region->isFree)
+				{
+					VULKAN_INTERNAL_InsertFreeRegion(allocator, region);
+				}
 			}
 		}
+
+		if (movedAny)
+		{
+			allocator->defragmentBackoffLength = DEFRAGMENT_BACKOFF_FRAMES;
+		}
+		else
+		{
+			allocator->defragmentBackoff = allocator->defragmentBackoffLength;
+			allocator->defragmentBackoffLength = SDL_min(
+				allocator->defragmentBackoffLength * 2,
+				DEFRAGMENT_MAX_BACKOFF_FRAMES
+			);
+		}
+	}
+
+	SDL_UnlockMutex(renderer->allocatorLock);
+
+	if (ghostTextureCount == 0 && ghostBufferCount == 0)
+	{
+		return;
+	}
+
+	for (i = 0; i < ghostTextureCount; i += 1)
+	{
+		VULKAN_INTERNAL_ExpireDescriptorSets(
+			renderer,
+			ghostTextures[i]->view,
+			VK_NULL_HANDLE
+		);
+	}
+
+	for (i = 0; i < ghostBufferCount; i += 1)
+	{
+		VULKAN_INTERNAL_ExpireDescriptorSets(
+			renderer,
+			VK_NULL_HANDLE,
+			ghostBuffers[i]->subBuffers[0]->buffer
+		);
+	}
+
+	SDL_LockMutex(renderer->disposeLock);
+
+	EXPAND_ARRAY_IF_NEEDED(
+		renderer->texturesToDestroy,
+		VulkanTexture*,
+		renderer->texturesToDestroyCount + ghostTextureCount,
+		renderer->texturesToDestroyCapacity,
+		renderer->texturesToDestroyCount + ghostTextureCount
+	)
+
+	for (i = 0; i < ghostTextureCount; i += 1)
+	{
+		renderer->texturesToDestroy[renderer->texturesToDestroyCount] = ghostTextures[i];
+		renderer->texturesToDestroyCount += 1;
 	}
+
+	EXPAND_ARRAY_IF_NEEDED(
+		renderer->buffersToDestroy,
+		VulkanBuffer*,
+		renderer->buffersToDestroyCount + ghostBufferCount,
+		renderer->buffersToDestroyCapacity,
+		renderer->buffersToDestroyCount + ghostBufferCount
+	)
+
+	for (i = 0; i < ghostBufferCount; i += 1)
+	{
+		renderer->buffersToDestroy[renderer->buffersToDestroyCount] = ghostBuffers[i];
+		renderer->buffersToDestroyCount += 1;
+	}
+
+	SDL_UnlockMutex(renderer->disposeLock);
+
+	SDL_free(ghostTextures);
+	SDL_free(ghostBuffers);
 }
 
 static void VULKAN_INTERNAL_ResetCommandBuffer(
@@ -8163,6 +13417,29 @@ static void VULKAN_INTERNAL_ResetCommandBuffer(
 	commandPool->inactiveCommandBufferCount += 1;
 }
 
+/* Debug mode only. Mapped memory is flushed on unmap, so the GPU could
+ * read data the client has not finished writing.
+ */
+static void VULKAN_INTERNAL_CheckMappedBuffersInUse(VulkanRenderer *renderer)
+{
+	uint32_t i;
+
+	SDL_LockMutex(renderer->boundBufferLock);
+
+	for (i = 0; i < renderer->buffersInUseCount; i += 1)
+	{
+		if (renderer->buffersInUse[i]->mapped)
+		{
+			Refresh_LogError(
+				"Buffer %p is submitted while mapped, call Refresh_UnmapBuffer first!",
+				(void*) renderer->buffersInUse[i]
+			);
+		}
+	}
+
+	SDL_UnlockMutex(renderer->boundBufferLock);
+}
+
 static void VULKAN_Submit(
     Refresh_Renderer *driverData,
 	uint32_t commandBufferCount,
@@ -8173,7 +13450,8 @@ static void VULKAN_Submit(
 	VkResult vulkanResult, presentResult = VK_SUCCESS;
 	VulkanCommandBuffer *currentCommandBuffer;
 	VkCommandBuffer *commandBuffers;
-	uint32_t i;
+	VulkanBufferReadback *readback;
+	uint32_t i, j;
 	uint8_t present;
 
 	VkPipelineStageFlags waitStages[2];
@@ -8192,10 +13470,10 @@ static void VULKAN_Submit(
 		transferSubmitInfo.pWaitDstStageMask = NULL;
 		transferSubmitInfo.pWaitSemaphores = NULL;
 		transferSubmitInfo.waitSemaphoreCount = 0;
-		transferSubmitInfo.pSignalSemaphores = &renderer->transferFinishedSemaphore;
+		transferSubmitInfo.pSignalSemaphores = &renderer->transferFinishedSemaphores[renderer->frameIndex];
 		transferSubmitInfo.signalSemaphoreCount = 1;
 
-		waitSemaphores[waitSemaphoreCount] = renderer->transferFinishedSemaphore;
+		waitSemaphores[waitSemaphoreCount] = renderer->transferFinishedSemaphores[renderer->frameIndex];
 		waitStages[waitSemaphoreCount] = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
 		waitSemaphoreCount += 1;
 	}
@@ -8211,6 +13489,11 @@ static void VULKAN_Submit(
 		commandBuffers[i] = currentCommandBuffer->commandBuffer;
 	}
 
+	if (renderer->debugMode)
+	{
+		VULKAN_INTERNAL_CheckMappedBuffersInUse(renderer);
+	}
+
 	submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
 	submitInfo.pNext = NULL;
 	submitInfo.commandBufferCount = commandBufferCount;
@@ -8218,60 +13501,29 @@ static void VULKAN_Submit(
 
 	if (present)
 	{
-		waitSemaphores[waitSemaphoreCount] = renderer->imageAvailableSemaphore;
+		/* Other submits may have advanced frameIndex since the acquire */
+		waitSemaphores[waitSemaphoreCount] = renderer->swapChainAcquireSemaphore;
 		waitStages[waitSemaphoreCount] = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
 		waitSemaphoreCount += 1;
 
 		submitInfo.pWaitDstStageMask = waitStages;
 		submitInfo.signalSemaphoreCount = 1;
-		submitInfo.pSignalSemaphores = &renderer->renderFinishedSemaphore;
+		submitInfo.pSignalSemaphores = &renderer->renderFinishedSemaphores[renderer->frameIndex];
 	}
 	else
-	{
-		submitInfo.pWaitDstStageMask = waitStages;
-		submitInfo.signalSemaphoreCount = 0;
-		submitInfo.pSignalSemaphores = NULL;
-	}
-
-	submitInfo.waitSemaphoreCount = waitSemaphoreCount;
-	submitInfo.pWaitSemaphores = waitSemaphores;
-
-	/* Wait for the previous submission to complete */
-	vulkanResult = renderer->vkWaitForFences(
-		renderer->logicalDevice,
-		1,
-		&renderer->inFlightFence,
-		VK_TRUE,
-		UINT64_MAX
-	);
-
-	if (vulkanResult != VK_SUCCESS)
-	{
-		LogVulkanResultAsError("vkWaitForFences", vulkanResult);
-		return;
-	}
-
-	VULKAN_INTERNAL_PostWorkCleanup(renderer);
-
-	/* Reset the previously submitted command buffers */
-	for (i = 0; i < renderer->submittedCommandBufferCount; i += 1)
-	{
-		if (!renderer->submittedCommandBuffers[i]->fixed)
-		{
-			VULKAN_INTERNAL_ResetCommandBuffer(
-				renderer,
-				renderer->submittedCommandBuffers[i]
-			);
-		}
+	{
+		submitInfo.pWaitDstStageMask = waitStages;
+		submitInfo.signalSemaphoreCount = 0;
+		submitInfo.pSignalSemaphores = NULL;
 	}
-	renderer->submittedCommandBufferCount = 0;
 
-	/* Prepare the command buffer fence for submission */
-	renderer->vkResetFences(
-		renderer->logicalDevice,
-		1,
-		&renderer->inFlightFence
-	);
+	submitInfo.waitSemaphoreCount = waitSemaphoreCount;
+	submitInfo.pWaitSemaphores = waitSemaphores;
+
+	/* Readbacks look frames up by submission, so tag the frame first */
+	renderer->submissionCount += 1;
+	renderer->frames[renderer->frameIndex].submission = renderer->submissionCount;
+	SDL_AtomicSet(&renderer->recordingSubmission, (int) (uint32_t) renderer->submissionCount);
 
 	if (renderer->pendingTransfer)
 	{
@@ -8286,55 +13538,86 @@ static void VULKAN_Submit(
 		if (vulkanResult != VK_SUCCESS)
 		{
 			LogVulkanResultAsError("vkQueueSubmit", vulkanResult);
+			SDL_stack_free(commandBuffers);
 			return;
 		}
 	}
 
+	/* This frame's fence was waited on when the frame began.
+	 * Reset it as late as possible so a failed submit can't strand it.
+	 */
+	renderer->vkResetFences(
+		renderer->logicalDevice,
+		1,
+		&renderer->inFlightFences[renderer->frameIndex]
+	);
+
 	/* Submit the commands, finally. */
 	vulkanResult = renderer->vkQueueSubmit(
 		renderer->graphicsQueue,
 		1,
 		&submitInfo,
-		renderer->inFlightFence
+		renderer->inFlightFences[renderer->frameIndex]
 	);
 
 	if (vulkanResult != VK_SUCCESS)
 	{
 		LogVulkanResultAsError("vkQueueSubmit", vulkanResult);
-		return;
-	}
-
-	if (renderer->submittedCommandBufferCount >= renderer->submittedCommandBufferCapacity)
-	{
-		renderer->submittedCommandBufferCapacity *= 2;
 
-		renderer->submittedCommandBuffers = SDL_realloc(
-			renderer->submittedCommandBuffers,
-			sizeof(VulkanCommandBuffer*) * renderer->submittedCommandBufferCapacity
+		/* An empty submit signals the fence once earlier work is done,
+		 * so the next wait on this frame slot doesn't block forever
+		 */
+		renderer->vkQueueSubmit(
+			renderer->graphicsQueue,
+			0,
+			NULL,
+			renderer->inFlightFences[renderer->frameIndex]
 		);
+
+		SDL_stack_free(commandBuffers);
+		return;
 	}
 
-	/* Mark command buffers as submitted */
+	VULKAN_INTERNAL_TrackSubmittedWork(
+		renderer,
+		renderer->frameIndex,
+		commandBufferCount,
+		pCommandBuffers
+	);
+
+	/* Fixed command buffers are submitted again, so they keep their textures */
 	for (i = 0; i < commandBufferCount; i += 1)
 	{
-		((VulkanCommandBuffer*)pCommandBuffers[i])->submitted = 1;
-		renderer->submittedCommandBuffers[renderer->submittedCommandBufferCount] = (VulkanCommandBuffer*) pCommandBuffers[i];
+		currentCommandBuffer = (VulkanCommandBuffer*) pCommandBuffers[i];
+
+		if (!currentCommandBuffer->fixed)
+		{
+			VULKAN_INTERNAL_ReleaseRecordedTextures(currentCommandBuffer);
+		}
 	}
-	renderer->submittedCommandBufferCount = commandBufferCount;
 
-	/* Reset UBOs */
+	/* Tie recorded readbacks to this submission's fence */
+	SDL_LockMutex(renderer->readbackLock);
+	for (i = 0; i < renderer->readbackCount; i += 1)
+	{
+		readback = renderer->readbacks[i];
 
-	SDL_LockMutex(renderer->uniformBufferLock);
-	renderer->vertexUBOOffset = UBO_BUFFER_SIZE * renderer->frameIndex;
-	renderer->vertexUBOBlockIncrement = 0;
-	renderer->fragmentUBOOffset = UBO_BUFFER_SIZE * renderer->frameIndex;
-	renderer->fragmentUBOBlockIncrement = 0;
-	renderer->computeUBOOffset = UBO_BUFFER_SIZE * renderer->frameIndex;
-	renderer->computeUBOBlockIncrement = 0;
-	SDL_UnlockMutex(renderer->uniformBufferLock);
+		if (!readback->inUse || readback->commandBuffer == NULL)
+		{
+			continue;
+		}
 
-	/* Reset descriptor set data */
-	VULKAN_INTERNAL_ResetDescriptorSetData(renderer);
+		for (j = 0; j < commandBufferCount; j += 1)
+		{
+			if (readback->commandBuffer == (VulkanCommandBuffer*) pCommandBuffers[j])
+			{
+				readback->commandBuffer = NULL;
+				readback->submission = renderer->submissionCount;
+				break;
+			}
+		}
+	}
+	SDL_UnlockMutex(renderer->readbackLock);
 
 	/* Present, if applicable */
 
@@ -8343,7 +13626,7 @@ static void VULKAN_Submit(
 		presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
 		presentInfo.pNext = NULL;
 		presentInfo.waitSemaphoreCount = 1;
-		presentInfo.pWaitSemaphores = &renderer->renderFinishedSemaphore;
+		presentInfo.pWaitSemaphores = &renderer->renderFinishedSemaphores[renderer->frameIndex];
 		presentInfo.swapchainCount = 1;
 		presentInfo.pSwapchains = &renderer->swapChain;
 		presentInfo.pImageIndices = &renderer->currentSwapChainIndex;
@@ -8365,6 +13648,44 @@ static void VULKAN_Submit(
 	renderer->pendingTransfer = 0;
 	renderer->textureStagingBufferOffset = 0;
 
+	/* Move to the next frame, which can only be reused once its
+	 * previous submission, framesInFlight submissions ago, is done
+	 */
+	renderer->frameIndex = (renderer->frameIndex + 1) % renderer->framesInFlight;
+
+	vulkanResult = renderer->vkWaitForFences(
+		renderer->logicalDevice,
+		1,
+		&renderer->inFlightFences[renderer->frameIndex],
+		VK_TRUE,
+		UINT64_MAX
+	);
+
+	if (vulkanResult != VK_SUCCESS)
+	{
+		LogVulkanResultAsError("vkWaitForFences", vulkanResult);
+		SDL_stack_free(commandBuffers);
+		return;
+	}
+
+	VULKAN_INTERNAL_PostWorkCleanup(renderer, renderer->frameIndex);
+
+	/* Other frames may have finished too, release them early */
+	VULKAN_INTERNAL_CleanupFinishedFrames(renderer);
+
+	/* Reset UBOs */
+
+	SDL_LockMutex(renderer->uniformBufferLock);
+	VULKAN_INTERNAL_ResetUniformBufferPool(renderer, renderer->vertexUniformBufferPool);
+	VULKAN_INTERNAL_ResetUniformBufferPool(renderer, renderer->fragmentUniformBufferPool);
+	VULKAN_INTERNAL_ResetUniformBufferPool(renderer, renderer->computeUniformBufferPool);
+	SDL_UnlockMutex(renderer->uniformBufferLock);
+
+	/* Descriptor sets are evicted by each thread on its next fetch */
+
+	VULKAN_INTERNAL_DefragmentMemory(renderer);
+	VULKAN_INTERNAL_CheckMemoryBudget(renderer);
+
 	SDL_stack_free(commandBuffers);
 }
 
@@ -8375,8 +13696,8 @@ static void VULKAN_Wait(
 
 	renderer->vkWaitForFences(
 		renderer->logicalDevice,
-		1,
-		&renderer->inFlightFence,
+		renderer->framesInFlight,
+		renderer->inFlightFences,
 		VK_TRUE,
 		UINT64_MAX
 	);
@@ -8392,9 +13713,216 @@ static void VULKAN_GetTextureHandles(
 	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
 	VulkanTexture *vulkanTexture = (VulkanTexture*) texture;
 
+	/* The defragmenter moves textures under the allocator lock */
+	SDL_LockMutex(renderer->allocatorLock);
+
+	vulkanTexture->handlesExported = 1;
+
 	handles->rendererType = REFRESH_RENDERER_TYPE_VULKAN;
 	handles->texture.vulkan.image = vulkanTexture->image;
 	handles->texture.vulkan.view = vulkanTexture->view;
+
+	SDL_UnlockMutex(renderer->allocatorLock);
+}
+
+static uint32_t VULKAN_GetTextureBindlessIndex(
+	Refresh_Renderer *driverData,
+	Refresh_Texture *texture
+) {
+	return ((VulkanTexture*) texture)->bindlessIndex;
+}
+
+static uint32_t VULKAN_GetSamplerBindlessIndex(
+	Refresh_Renderer *driverData,
+	Refresh_Sampler *sampler
+) {
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+	uint32_t index;
+
+	if (!renderer->supportsBindless)
+	{
+		return REFRESH_BINDLESS_INDEX_NONE;
+	}
+
+	SDL_LockMutex(renderer->bindlessLock);
+	index = VULKAN_INTERNAL_FindBindlessSampler(renderer, (VkSampler) sampler);
+	SDL_UnlockMutex(renderer->bindlessLock);
+
+	return index;
+}
+
+static void VULKAN_SetMemoryPlacementPolicy(
+	Refresh_Renderer *driverData,
+	Refresh_MemoryPlacementPolicy policy
+) {
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+
+	SDL_LockMutex(renderer->allocatorLock);
+	renderer->memoryAllocator->placementPolicy = policy;
+	SDL_UnlockMutex(renderer->allocatorLock);
+}
+
+static void VULKAN_SetMemoryDefragmentation(
+	Refresh_Renderer *driverData,
+	uint8_t enabled
+) {
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+
+	SDL_LockMutex(renderer->allocatorLock);
+	renderer->memoryAllocator->defragmentationEnabled = enabled;
+	SDL_UnlockMutex(renderer->allocatorLock);
+}
+
+static void VULKAN_GetMemoryStats(
+	Refresh_Renderer *driverData,
+	Refresh_MemoryHeapStats *pStats,
+	uint32_t *pCount
+) {
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+	VulkanMemorySubAllocator *allocator;
+	VkDeviceSize budgets[VK_MAX_MEMORY_HEAPS];
+	VkDeviceSize usages[VK_MAX_MEMORY_HEAPS];
+	Refresh_MemoryHeapStats *stats;
+	uint32_t i, count;
+
+	if (pStats == NULL)
+	{
+		*pCount = renderer->memoryProperties.memoryHeapCount;
+		return;
+	}
+
+	count = SDL_min(*pCount, renderer->memoryProperties.memoryHeapCount);
+
+	SDL_LockMutex(renderer->allocatorLock);
+
+	VULKAN_INTERNAL_QueryHeapBudgets(renderer, budgets, usages);
+
+	for (i = 0; i < count; i += 1)
+	{
+		pStats[i].heapIndex = i;
+		pStats[i].deviceLocal = (
+			renderer->memoryProperties.memoryHeaps[i].flags &
+			VK_MEMORY_HEAP_DEVICE_LOCAL_BIT
+		) != 0;
+		pStats[i].budget = budgets[i];
+		pStats[i].usage = usages[i];
+		pStats[i].blockCount = 0;
+		pStats[i].allocatedBytes = 0;
+		pStats[i].textureBytes = 0;
+		pStats[i].bufferBytes = 0;
+	}
+
+	for (i = 0; i < renderer->memoryProperties.memoryTypeCount; i += 1)
+	{
+		if (renderer->memoryProperties.memoryTypes[i].heapIndex >= count)
+		{
+			continue;
+		}
+
+		allocator = &renderer->memoryAllocator->subAllocators[i];
+		stats = &pStats[renderer->memoryProperties.memoryTypes[i].heapIndex];
+
+		stats->blockCount += allocator->allocationCount + allocator->dedicatedAllocationCount;
+		stats->allocatedBytes += allocator->allocatedBytes;
+		stats->textureBytes += allocator->textureBytes;
+		stats->bufferBytes += allocator->bufferBytes;
+	}
+
+	SDL_UnlockMutex(renderer->allocatorLock);
+
+	*pCount = count;
+}
+
+static void VULKAN_SetMemoryBudgetCallback(
+	Refresh_Renderer *driverData,
+	float threshold,
+	Refresh_MemoryBudgetFunc callback,
+	void *userdata
+) {
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+
+	SDL_LockMutex(renderer->allocatorLock);
+	renderer->memoryBudgetCallback = callback;
+	renderer->memoryBudgetUserdata = userdata;
+	renderer->memoryBudgetThreshold = threshold;
+	renderer->memoryBudgetExceededHeaps = 0;
+	SDL_UnlockMutex(renderer->allocatorLock);
+}
+
+static void VULKAN_GetMemoryFragmentationStats(
+	Refresh_Renderer *driverData,
+	Refresh_MemoryFragmentationStats *pStats,
+	uint32_t *pCount
+) {
+	VulkanRenderer *renderer = (VulkanRenderer*) driverData;
+	VulkanMemorySubAllocator *allocator;
+	VulkanMemoryRegion *region;
+	Refresh_MemoryFragmentationStats *stats;
+	uint32_t i, j, firstLevel, secondLevel;
+	uint32_t count = 0;
+
+	SDL_LockMutex(renderer->allocatorLock);
+
+	for (i = 0; i < renderer->memoryProperties.memoryTypeCount; i += 1)
+	{
+		allocator = &renderer->memoryAllocator->subAllocators[i];
+
+		if (allocator->allocationCount == 0)
+		{
+			continue;
+		}
+
+		if (pStats == NULL)
+		{
+			count += 1;
+			continue;
+		}
+
+		if (count >= *pCount)
+		{
+			break;
+		}
+
+		stats = &pStats[count];
+		count += 1;
+
+		stats->memoryTypeIndex = i;
+		stats->blockCount = allocator->allocationCount;
+		stats->totalBlockBytes = 0;
+		stats->totalFreeBytes = allocator->totalFreeBytes;
+		stats->largestFreeBlock = 0;
+		stats->freeRegionCount = allocator->freeRegionCount;
+		stats->externalFragmentation = 0.0f;
+
+		for (j = 0; j < allocator->allocationCount; j += 1)
+		{
+			stats->totalBlockBytes += allocator->allocations[j]->size;
+		}
+
+		/* The largest free region lives in the highest non-empty list */
+		if (allocator->firstLevelBitmap != 0)
+		{
+			firstLevel = VULKAN_INTERNAL_HighestBitIndex(allocator->firstLevelBitmap);
+			secondLevel = VULKAN_INTERNAL_HighestBitIndex(allocator->secondLevelBitmaps[firstLevel]);
+
+			for (
+				region = allocator->freeLists[firstLevel][secondLevel];
+				region != NULL;
+				region = region->nextFree
+			) {
+				stats->largestFreeBlock = SDL_max(stats->largestFreeBlock, region->size);
+			}
+
+			stats->externalFragmentation = 1.0f - (
+				(float) stats->largestFreeBlock /
+				(float) stats->totalFreeBytes
+			);
+		}
+	}
+
+	SDL_UnlockMutex(renderer->allocatorLock);
+
+	*pCount = count;
 }
 
 /* Device instantiation */
@@ -8916,6 +14444,10 @@ static uint8_t VULKAN_INTERNAL_CreateLogicalDevice(
 
 	VkDeviceCreateInfo deviceCreateInfo;
 	VkPhysicalDeviceFeatures deviceFeatures;
+	VkPhysicalDeviceFeatures supportedFeatures;
+	VkPhysicalDeviceMultiDrawFeaturesEXT multiDrawFeatures;
+	VkPhysicalDeviceDescriptorIndexingFeaturesEXT descriptorIndexingFeatures;
+	void *deviceCreateInfoNext;
 
 	VkDeviceQueueCreateInfo queueCreateInfos[2];
 	VkDeviceQueueCreateInfo queueCreateInfoGraphics;
@@ -8956,10 +14488,39 @@ static uint8_t VULKAN_INTERNAL_CreateLogicalDevice(
 	deviceFeatures.occlusionQueryPrecise = VK_TRUE;
 	deviceFeatures.fillModeNonSolid = VK_TRUE;
 
+	renderer->vkGetPhysicalDeviceFeatures(
+		renderer->physicalDevice,
+		&supportedFeatures
+	);
+
+	/* Optional, indirect draws fall back to one draw per command */
+	renderer->supportsMultiDrawIndirect = supportedFeatures.multiDrawIndirect;
+	deviceFeatures.multiDrawIndirect = supportedFeatures.multiDrawIndirect;
+
+	multiDrawFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MULTI_DRAW_FEATURES_EXT;
+	multiDrawFeatures.pNext = NULL;
+	multiDrawFeatures.multiDraw = VK_TRUE;
+
+	deviceCreateInfoNext = renderer->supportsMultiDraw ? &multiDrawFeatures : NULL;
+
+	if (renderer->supportsBindless)
+	{
+		SDL_zero(descriptorIndexingFeatures);
+		descriptorIndexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+		descriptorIndexingFeatures.pNext = deviceCreateInfoNext;
+		descriptorIndexingFeatures.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+		descriptorIndexingFeatures.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+		descriptorIndexingFeatures.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+		descriptorIndexingFeatures.descriptorBindingPartiallyBound = VK_TRUE;
+		descriptorIndexingFeatures.runtimeDescriptorArray = VK_TRUE;
+
+		deviceCreateInfoNext = &descriptorIndexingFeatures;
+	}
+
 	/* creating the logical device */
 
 	deviceCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
-	deviceCreateInfo.pNext = NULL;
+	deviceCreateInfo.pNext = deviceCreateInfoNext;
 	deviceCreateInfo.flags = 0;
 	deviceCreateInfo.queueCreateInfoCount = queueInfoCount;
 	deviceCreateInfo.pQueueCreateInfos = queueCreateInfos;
@@ -9058,6 +14619,111 @@ static void VULKAN_INTERNAL_LoadEntryPoints(
 	#include "Refresh_Driver_Vulkan_vkfuncs.h"
 }
 
+static uint8_t VULKAN_INTERNAL_CreateBindlessDescriptorSet(
+	VulkanRenderer *renderer
+) {
+	VkResult vulkanResult;
+	VkDescriptorSetLayoutBinding layoutBindings[2];
+	VkDescriptorBindingFlagsEXT bindingFlags[2];
+	VkDescriptorSetLayoutBindingFlagsCreateInfoEXT bindingFlagsCreateInfo;
+	VkDescriptorSetLayoutCreateInfo setLayoutCreateInfo;
+	VkDescriptorPoolSize poolSizes[2];
+	VkDescriptorPoolCreateInfo descriptorPoolInfo;
+	VkDescriptorSetAllocateInfo descriptorAllocateInfo;
+
+	layoutBindings[0].binding = 0;
+	layoutBindings[0].descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+	layoutBindings[0].descriptorCount = renderer->bindlessTextureIndices.capacity;
+	layoutBindings[0].stageFlags = VK_SHADER_STAGE_ALL;
+	layoutBindings[0].pImmutableSamplers = NULL;
+
+	layoutBindings[1].binding = 1;
+	layoutBindings[1].descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER;
+	layoutBindings[1].descriptorCount = renderer->bindlessSamplerIndices.capacity;
+	layoutBindings[1].stageFlags = VK_SHADER_STAGE_ALL;
+	layoutBindings[1].pImmutableSamplers = NULL;
+
+	/* Slots are written while other slots are in use and may stay empty */
+	bindingFlags[0] =
+		VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT |
+		VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT |
+		VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT_EXT;
+	bindingFlags[1] = bindingFlags[0];
+
+	bindingFlagsCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT;
+	bindingFlagsCreateInfo.pNext = NULL;
+	bindingFlagsCreateInfo.bindingCount = 2;
+	bindingFlagsCreateInfo.pBindingFlags = bindingFlags;
+
+	setLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+	setLayoutCreateInfo.pNext = &bindingFlagsCreateInfo;
+	setLayoutCreateInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT;
+	setLayoutCreateInfo.bindingCount = 2;
+	setLayoutCreateInfo.pBindings = layoutBindings;
+
+	vulkanResult = renderer->vkCreateDescriptorSetLayout(
+		renderer->logicalDevice,
+		&setLayoutCreateInfo,
+		NULL,
+		&renderer->bindlessDescriptorSetLayout
+	);
+
+	if (vulkanResult != VK_SUCCESS)
+	{
+		LogVulkanResultAsError("vkCreateDescriptorSetLayout", vulkanResult);
+		return 0;
+	}
+
+	poolSizes[0].type = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+	poolSizes[0].descriptorCount = renderer->bindlessTextureIndices.capacity;
+	poolSizes[1].type = VK_DESCRIPTOR_TYPE_SAMPLER;
+	poolSizes[1].descriptorCount = renderer->bindlessSamplerIndices.capacity;
+
+	descriptorPoolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+	descriptorPoolInfo.pNext = NULL;
+	descriptorPoolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT;
+	descriptorPoolInfo.maxSets = 1;
+	descriptorPoolInfo.poolSizeCount = 2;
+	descriptorPoolInfo.pPoolSizes = poolSizes;
+
+	vulkanResult = renderer->vkCreateDescriptorPool(
+		renderer->logicalDevice,
+		&descriptorPoolInfo,
+		NULL,
+		&renderer->bindlessDescriptorPool
+	);
+
+	if (vulkanResult != VK_SUCCESS)
+	{
+		LogVulkanResultAsError("vkCreateDescriptorPool", vulkanResult);
+		return 0;
+	}
+
+	descriptorAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+	descriptorAllocateInfo.pNext = NULL;
+	descriptorAllocateInfo.descriptorPool = renderer->bindlessDescriptorPool;
+	descriptorAllocateInfo.descriptorSetCount = 1;
+	descriptorAllocateInfo.pSetLayouts = &renderer->bindlessDescriptorSetLayout;
+
+	vulkanResult = renderer->vkAllocateDescriptorSets(
+		renderer->logicalDevice,
+		&descriptorAllocateInfo,
+		&renderer->bindlessDescriptorSet
+	);
+
+	if (vulkanResult != VK_SUCCESS)
+	{
+		LogVulkanResultAsError("vkAllocateDescriptorSets", vulkanResult);
+		return 0;
+	}
+
+	renderer->bindlessSamplers = (VkSampler*) SDL_malloc(
+		sizeof(VkSampler) * renderer->bindlessSamplerIndices.capacity
+	);
+
+	return 1;
+}
+
 /* Expects a partially initialized VulkanRenderer */
 static Refresh_Device* VULKAN_INTERNAL_CreateDevice(
 	VulkanRenderer *renderer
@@ -9066,6 +14732,7 @@ static Refresh_Device* VULKAN_INTERNAL_CreateDevice(
 
     VkResult vulkanResult;
 	uint32_t i;
+	VulkanFrame *frame;
 
     /* Variables: Create fence and semaphores */
 	VkFenceCreateInfo fenceInfo;
@@ -9112,6 +14779,7 @@ static Refresh_Device* VULKAN_INTERNAL_CreateDevice(
 	renderer->needNewSwapChain = 0;
 	renderer->shouldPresent = 0;
 	renderer->swapChainImageAcquired = 0;
+	renderer->swapChainAcquireSemaphore = VK_NULL_HANDLE;
 
 	/*
 	 * Create fence and semaphores
@@ -9123,58 +14791,62 @@ static Refresh_Device* VULKAN_INTERNAL_CreateDevice(
 
 	semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
 	semaphoreInfo.pNext = NULL;
-	semaphoreInfo.flags = 0;
-
-	vulkanResult = renderer->vkCreateSemaphore(
-		renderer->logicalDevice,
-		&semaphoreInfo,
-		NULL,
-		&renderer->transferFinishedSemaphore
-	);
+	semaphoreInfo.flags = 0;
 
-	if (vulkanResult != VK_SUCCESS)
+	for (i = 0; i < renderer->framesInFlight; i += 1)
 	{
-		LogVulkanResultAsError("vkCreateSemaphore", vulkanResult);
-		return NULL;
-	}
+		vulkanResult = renderer->vkCreateSemaphore(
+			renderer->logicalDevice,
+			&semaphoreInfo,
+			NULL,
+			&renderer->transferFinishedSemaphores[i]
+		);
 
-	vulkanResult = renderer->vkCreateSemaphore(
-		renderer->logicalDevice,
-		&semaphoreInfo,
-		NULL,
-		&renderer->imageAvailableSemaphore
-	);
+		if (vulkanResult != VK_SUCCESS)
+		{
+			LogVulkanResultAsError("vkCreateSemaphore", vulkanResult);
+			return NULL;
+		}
 
-	if (vulkanResult != VK_SUCCESS)
-	{
-		LogVulkanResultAsError("vkCreateSemaphore", vulkanResult);
-		return NULL;
-	}
+		vulkanResult = renderer->vkCreateSemaphore(
+			renderer->logicalDevice,
+			&semaphoreInfo,
+			NULL,
+			&renderer->imageAvailableSemaphores[i]
+		);
 
-	vulkanResult = renderer->vkCreateSemaphore(
-		renderer->logicalDevice,
-		&semaphoreInfo,
-		NULL,
-		&renderer->renderFinishedSemaphore
-	);
+		if (vulkanResult != VK_SUCCESS)
+		{
+			LogVulkanResultAsError("vkCreateSemaphore", vulkanResult);
+			return NULL;
+		}
 
-	if (vulkanResult != VK_SUCCESS)
-	{
-		LogVulkanResultAsError("vkCreateSemaphore", vulkanResult);
-		return NULL;
-	}
+		vulkanResult = renderer->vkCreateSemaphore(
+			renderer->logicalDevice,
+			&semaphoreInfo,
+			NULL,
+			&renderer->renderFinishedSemaphores[i]
+		);
 
-	vulkanResult = renderer->vkCreateFence(
-		renderer->logicalDevice,
-		&fenceInfo,
-		NULL,
-		&renderer->inFlightFence
-	);
+		if (vulkanResult != VK_SUCCESS)
+		{
+			LogVulkanResultAsError("vkCreateSemaphore", vulkanResult);
+			return NULL;
+		}
 
-	if (vulkanResult != VK_SUCCESS)
-	{
-		LogVulkanResultAsError("vkCreateFence", vulkanResult);
-		return NULL;
+		/* Signaled, so the first use of each frame doesn't block */
+		vulkanResult = renderer->vkCreateFence(
+			renderer->logicalDevice,
+			&fenceInfo,
+			NULL,
+			&renderer->inFlightFences[i]
+		);
+
+		if (vulkanResult != VK_SUCCESS)
+		{
+			LogVulkanResultAsError("vkCreateFence", vulkanResult);
+			return NULL;
+		}
 	}
 
 	/* Threading */
@@ -9182,9 +14854,11 @@ static Refresh_Device* VULKAN_INTERNAL_CreateDevice(
 	renderer->allocatorLock = SDL_CreateMutex();
 	renderer->disposeLock = SDL_CreateMutex();
 	renderer->uniformBufferLock = SDL_CreateMutex();
-	renderer->descriptorSetLock = SDL_CreateMutex();
 	renderer->boundBufferLock = SDL_CreateMutex();
 	renderer->stagingLock = SDL_CreateMutex();
+	renderer->readbackLock = SDL_CreateMutex();
+	renderer->bindlessLock = SDL_CreateMutex();
+	renderer->commandPoolLock = SDL_CreateMutex();
 
 	/* Transfer buffer */
 
@@ -9208,7 +14882,7 @@ static Refresh_Device* VULKAN_INTERNAL_CreateDevice(
 
 	transferCommandBufferAllocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
 	transferCommandBufferAllocateInfo.pNext = NULL;
-	transferCommandBufferAllocateInfo.commandBufferCount = 2;
+	transferCommandBufferAllocateInfo.commandBufferCount = renderer->framesInFlight;
 	transferCommandBufferAllocateInfo.commandPool = renderer->transferCommandPool;
 	transferCommandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
 
@@ -9226,13 +14900,14 @@ static Refresh_Device* VULKAN_INTERNAL_CreateDevice(
 
 	renderer->pendingTransfer = 0;
 
-	/*
-	 * Create submitted command buffer list
-	 */
+	renderer->submissionCount = 0;
+	SDL_AtomicSet(&renderer->recordingSubmission, 0);
+
+	/* Readback pool */
 
-	renderer->submittedCommandBufferCapacity = 16;
-	renderer->submittedCommandBufferCount = 0;
-	renderer->submittedCommandBuffers = SDL_malloc(sizeof(VulkanCommandBuffer*) * renderer->submittedCommandBufferCapacity);
+	renderer->readbackCapacity = READBACK_POOL_STARTING_SIZE;
+	renderer->readbackCount = 0;
+	renderer->readbacks = SDL_malloc(sizeof(VulkanBufferReadback*) * renderer->readbackCapacity);
 
 	/* Memory Allocator */
 
@@ -9245,64 +14920,51 @@ static Refresh_Device* VULKAN_INTERNAL_CreateDevice(
 		renderer->memoryAllocator->subAllocators[i].nextAllocationSize = STARTING_ALLOCATION_SIZE;
 		renderer->memoryAllocator->subAllocators[i].allocations = NULL;
 		renderer->memoryAllocator->subAllocators[i].allocationCount = 0;
-		renderer->memoryAllocator->subAllocators[i].sortedFreeRegions = SDL_malloc(
-			sizeof(VulkanMemoryFreeRegion*) * 4
-		);
-		renderer->memoryAllocator->subAllocators[i].sortedFreeRegionCount = 0;
-		renderer->memoryAllocator->subAllocators[i].sortedFreeRegionCapacity = 4;
-	}
-
-	/* UBO Data */
-
-	renderer->vertexUBO = (VulkanBuffer*) SDL_malloc(sizeof(VulkanBuffer));
-
-	if (!VULKAN_INTERNAL_CreateBuffer(
-		renderer,
-		UBO_ACTUAL_SIZE,
-		RESOURCE_ACCESS_VERTEX_SHADER_READ_UNIFORM_BUFFER,
-		VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-		1,
-		renderer->vertexUBO
-	)) {
-		Refresh_LogError("Failed to create vertex UBO!");
-		return NULL;
-	}
-
-	renderer->fragmentUBO = (VulkanBuffer*) SDL_malloc(sizeof(VulkanBuffer));
-
-	if (!VULKAN_INTERNAL_CreateBuffer(
-		renderer,
-		UBO_ACTUAL_SIZE,
-		RESOURCE_ACCESS_FRAGMENT_SHADER_READ_UNIFORM_BUFFER,
-		VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-		1,
-		renderer->fragmentUBO
-	)) {
-		Refresh_LogError("Failed to create fragment UBO!");
-		return NULL;
-	}
-
-	renderer->computeUBO = (VulkanBuffer*) SDL_malloc(sizeof(VulkanBuffer));
-
-	if (!VULKAN_INTERNAL_CreateBuffer(
-		renderer,
-		UBO_ACTUAL_SIZE,
-		RESOURCE_ACCESS_COMPUTE_SHADER_READ_UNIFORM_BUFFER,
-		VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-		1,
-		renderer->computeUBO
-	)) {
-		Refresh_LogError("Failed to create compute UBO!");
-		return NULL;
-	}
+		renderer->memoryAllocator->subAllocators[i].firstLevelBitmap = 0;
+		SDL_zero(renderer->memoryAllocator->subAllocators[i].secondLevelBitmaps);
+		SDL_zero(renderer->memoryAllocator->subAllocators[i].freeLists);
+		renderer->memoryAllocator->subAllocators[i].totalFreeBytes = 0;
+		renderer->memoryAllocator->subAllocators[i].freeRegionCount = 0;
+		renderer->memoryAllocator->subAllocators[i].allocatedBytes = 0;
+		renderer->memoryAllocator->subAllocators[i].dedicatedAllocationCount = 0;
+		renderer->memoryAllocator->subAllocators[i].textureBytes = 0;
+		renderer->memoryAllocator->subAllocators[i].bufferBytes = 0;
+		renderer->memoryAllocator->subAllocators[i].defragmentSource = NULL;
+		renderer->memoryAllocator->subAllocators[i].defragmentSourceDirty = 1;
+		renderer->memoryAllocator->subAllocators[i].defragmentBackoff = 0;
+		renderer->memoryAllocator->subAllocators[i].defragmentBackoffLength = DEFRAGMENT_BACKOFF_FRAMES;
+	}
+
+	renderer->memoryAllocator->bufferArenas.nextAllocationSize = BUFFER_ARENA_SIZE;
+	renderer->memoryAllocator->bufferArenas.allocations = NULL;
+	renderer->memoryAllocator->bufferArenas.allocationCount = 0;
+	renderer->memoryAllocator->bufferArenas.firstLevelBitmap = 0;
+	SDL_zero(renderer->memoryAllocator->bufferArenas.secondLevelBitmaps);
+	SDL_zero(renderer->memoryAllocator->bufferArenas.freeLists);
+	renderer->memoryAllocator->bufferArenas.totalFreeBytes = 0;
+	renderer->memoryAllocator->bufferArenas.freeRegionCount = 0;
+	renderer->memoryAllocator->bufferArenas.allocatedBytes = 0;
+	renderer->memoryAllocator->bufferArenas.dedicatedAllocationCount = 0;
+	renderer->memoryAllocator->bufferArenas.textureBytes = 0;
+	renderer->memoryAllocator->bufferArenas.bufferBytes = 0;
+	renderer->memoryAllocator->bufferArenas.defragmentSource = NULL;
+	renderer->memoryAllocator->bufferArenas.defragmentSourceDirty = 1;
+	renderer->memoryAllocator->bufferArenas.defragmentBackoff = 0;
+	renderer->memoryAllocator->bufferArenas.defragmentBackoffLength = DEFRAGMENT_BACKOFF_FRAMES;
+
+	renderer->memoryAllocator->placementPolicy = REFRESH_MEMORYPLACEMENTPOLICY_BESTFIT;
+	renderer->memoryAllocator->defragmentationEnabled = 0;
+
+	renderer->memoryBudgetCallback = NULL;
+	renderer->memoryBudgetUserdata = NULL;
+	renderer->memoryBudgetThreshold = 1.0f;
+	renderer->memoryBudgetExceededHeaps = 0;
+
+	renderer->memoryAllocator->regionPool = NULL;
+	renderer->memoryAllocator->regionPoolChunks = NULL;
+	renderer->memoryAllocator->regionPoolChunkCount = 0;
 
 	renderer->minUBOAlignment = renderer->physicalDeviceProperties.properties.limits.minUniformBufferOffsetAlignment;
-	renderer->vertexUBOOffset = 0;
-	renderer->vertexUBOBlockIncrement = 0;
-	renderer->fragmentUBOOffset = 0;
-	renderer->fragmentUBOBlockIncrement = 0;
-	renderer->computeUBOOffset = 0;
-	renderer->computeUBOBlockIncrement = 0;
 
 	/* Set up UBO layouts */
 
@@ -9436,8 +15098,8 @@ static Refresh_Device* VULKAN_INTERNAL_CreateDevice(
 	poolSizes[0].descriptorCount = 2;
 	poolSizes[0].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
 
-	/* UBO descriptor sets */
-	poolSizes[1].descriptorCount = UBO_POOL_SIZE;
+	/* dummy UBO descriptor sets, block sets live in each uniform pool */
+	poolSizes[1].descriptorCount = 3;
 	poolSizes[1].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
 
 	poolSizes[2].descriptorCount = 1;
@@ -9449,7 +15111,7 @@ static Refresh_Device* VULKAN_INTERNAL_CreateDevice(
 	defaultDescriptorPoolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
 	defaultDescriptorPoolInfo.pNext = NULL;
 	defaultDescriptorPoolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
-	defaultDescriptorPoolInfo.maxSets = UBO_POOL_SIZE + 2 + 1 + 1;
+	defaultDescriptorPoolInfo.maxSets = 3 + 2 + 1 + 1;
 	defaultDescriptorPoolInfo.poolSizeCount = 4;
 	defaultDescriptorPoolInfo.pPoolSizes = poolSizes;
 
@@ -9496,6 +15158,34 @@ static Refresh_Device* VULKAN_INTERNAL_CreateDevice(
 		&renderer->emptyComputeImageDescriptorSet
 	);
 
+	/* Bindless descriptors */
+
+	renderer->bindlessDescriptorPool = VK_NULL_HANDLE;
+	renderer->bindlessDescriptorSetLayout = VK_NULL_HANDLE;
+	renderer->bindlessDescriptorSet = VK_NULL_HANDLE;
+	renderer->bindlessSamplers = NULL;
+
+	renderer->bindlessTextureIndices.nextIndex = 0;
+	renderer->bindlessTextureIndices.freeIndexCount = 0;
+	renderer->bindlessTextureIndices.freeIndexCapacity = BINDLESS_FREE_INDEX_STARTING_SIZE;
+	renderer->bindlessTextureIndices.freeIndices = (uint32_t*) SDL_malloc(
+		sizeof(uint32_t) * BINDLESS_FREE_INDEX_STARTING_SIZE
+	);
+
+	renderer->bindlessSamplerIndices.nextIndex = 0;
+	renderer->bindlessSamplerIndices.freeIndexCount = 0;
+	renderer->bindlessSamplerIndices.freeIndexCapacity = BINDLESS_FREE_INDEX_STARTING_SIZE;
+	renderer->bindlessSamplerIndices.freeIndices = (uint32_t*) SDL_malloc(
+		sizeof(uint32_t) * BINDLESS_FREE_INDEX_STARTING_SIZE
+	);
+
+	if (	renderer->supportsBindless &&
+		!VULKAN_INTERNAL_CreateBindlessDescriptorSet(renderer)	)
+	{
+		Refresh_LogError("Failed to create bindless descriptor set!");
+		return NULL;
+	}
+
 	/* Initialize buffer space */
 
 	renderer->buffersInUseCapacity = 32;
@@ -9504,26 +15194,24 @@ static Refresh_Device* VULKAN_INTERNAL_CreateDevice(
 		sizeof(VulkanBuffer*) * renderer->buffersInUseCapacity
 	);
 
-	renderer->submittedBufferCapacity = 32;
-	renderer->submittedBufferCount = 0;
-	renderer->submittedBuffers = (VulkanBuffer**)SDL_malloc(
-		sizeof(VulkanBuffer*) * renderer->submittedBufferCapacity
-	);
-
-	/* Staging Buffer */
+	/* Staging Buffers, one per frame so uploads never overwrite in-flight data */
 
-	renderer->textureStagingBuffer = (VulkanBuffer*) SDL_malloc(sizeof(VulkanBuffer));
+	for (i = 0; i < renderer->framesInFlight; i += 1)
+	{
+		renderer->textureStagingBuffers[i] = (VulkanBuffer*) SDL_malloc(sizeof(VulkanBuffer));
 
-	if (!VULKAN_INTERNAL_CreateBuffer(
-		renderer,
-		TEXTURE_STAGING_SIZE,
-		RESOURCE_ACCESS_MEMORY_TRANSFER_READ_WRITE,
-		VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-		1,
-		renderer->textureStagingBuffer
-	)) {
-		Refresh_LogError("Failed to create texture staging buffer!");
-		return NULL;
+		if (!VULKAN_INTERNAL_CreateBuffer(
+			renderer,
+			TEXTURE_STAGING_SIZE,
+			RESOURCE_ACCESS_MEMORY_TRANSFER_READ_WRITE,
+			VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+			1,
+			VULKAN_BUFFER_MEMORY_HOST,
+			renderer->textureStagingBuffers[i]
+		)) {
+			Refresh_LogError("Failed to create texture staging buffer!");
+			return NULL;
+		}
 	}
 
 	renderer->textureStagingBufferOffset = 0;
@@ -9538,6 +15226,7 @@ static Refresh_Device* VULKAN_INTERNAL_CreateDevice(
 		RESOURCE_ACCESS_VERTEX_SHADER_READ_UNIFORM_BUFFER,
 		VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
 		1,
+		VULKAN_BUFFER_MEMORY_HOST,
 		renderer->dummyVertexUniformBuffer
 	)) {
 		Refresh_LogError("Failed to create dummy vertex uniform buffer!");
@@ -9552,6 +15241,7 @@ static Refresh_Device* VULKAN_INTERNAL_CreateDevice(
 		RESOURCE_ACCESS_FRAGMENT_SHADER_READ_UNIFORM_BUFFER,
 		VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
 		1,
+		VULKAN_BUFFER_MEMORY_HOST,
 		renderer->dummyFragmentUniformBuffer
 	)) {
 		Refresh_LogError("Failed to create dummy fragment uniform buffer!");
@@ -9566,12 +15256,44 @@ static Refresh_Device* VULKAN_INTERNAL_CreateDevice(
 		RESOURCE_ACCESS_COMPUTE_SHADER_READ_UNIFORM_BUFFER,
 		VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
 		1,
+		VULKAN_BUFFER_MEMORY_HOST,
 		renderer->dummyComputeUniformBuffer
 	)) {
 		Refresh_LogError("Fialed to create dummy compute uniform buffer!");
 		return NULL;
 	}
 
+	/* UBO Data */
+
+	renderer->vertexUniformBufferPool = VULKAN_INTERNAL_CreateUniformBufferPool(
+		renderer,
+		renderer->vertexParamLayout,
+		RESOURCE_ACCESS_VERTEX_SHADER_READ_UNIFORM_BUFFER,
+		renderer->dummyVertexUniformBuffer
+	);
+
+	renderer->fragmentUniformBufferPool = VULKAN_INTERNAL_CreateUniformBufferPool(
+		renderer,
+		renderer->fragmentParamLayout,
+		RESOURCE_ACCESS_FRAGMENT_SHADER_READ_UNIFORM_BUFFER,
+		renderer->dummyFragmentUniformBuffer
+	);
+
+	renderer->computeUniformBufferPool = VULKAN_INTERNAL_CreateUniformBufferPool(
+		renderer,
+		renderer->computeParamLayout,
+		RESOURCE_ACCESS_COMPUTE_SHADER_READ_UNIFORM_BUFFER,
+		renderer->dummyComputeUniformBuffer
+	);
+
+	if (	renderer->vertexUniformBufferPool == NULL ||
+		renderer->fragmentUniformBufferPool == NULL ||
+		renderer->computeUniformBufferPool == NULL	)
+	{
+		Refresh_LogError("Failed to create UBO pools!");
+		return NULL;
+	}
+
 	/* Initialize caches */
 
 	for (i = 0; i < NUM_COMMAND_POOL_BUCKETS; i += 1)
@@ -9602,6 +15324,9 @@ static Refresh_Device* VULKAN_INTERNAL_CreateDevice(
 		renderer->descriptorSetLayoutHashTable.buckets[i].capacity = 0;
 	}
 
+	SDL_AtomicSet(&renderer->imageDescriptorSetCacheInfoCount, 0);
+	SDL_AtomicSet(&renderer->bufferDescriptorSetCacheInfoCount, 0);
+
 	/* Deferred destroy storage */
 
 	renderer->renderTargetsToDestroyCapacity = 16;
@@ -9612,14 +15337,6 @@ static Refresh_Device* VULKAN_INTERNAL_CreateDevice(
 		renderer->renderTargetsToDestroyCapacity
 	);
 
-	renderer->submittedRenderTargetsToDestroyCapacity = 16;
-	renderer->submittedRenderTargetsToDestroyCount = 0;
-
-	renderer->submittedRenderTargetsToDestroy = (VulkanRenderTarget**) SDL_malloc(
-		sizeof(VulkanRenderTarget*) *
-		renderer->submittedRenderTargetsToDestroyCapacity
-	);
-
 	renderer->texturesToDestroyCapacity = 16;
 	renderer->texturesToDestroyCount = 0;
 
@@ -9628,14 +15345,6 @@ static Refresh_Device* VULKAN_INTERNAL_CreateDevice(
 		renderer->texturesToDestroyCapacity
 	);
 
-	renderer->submittedTexturesToDestroyCapacity = 16;
-	renderer->submittedTexturesToDestroyCount = 0;
-
-	renderer->submittedTexturesToDestroy = (VulkanTexture**)SDL_malloc(
-		sizeof(VulkanTexture*) *
-		renderer->submittedTexturesToDestroyCapacity
-	);
-
 	renderer->buffersToDestroyCapacity = 16;
 	renderer->buffersToDestroyCount = 0;
 
@@ -9644,14 +15353,6 @@ static Refresh_Device* VULKAN_INTERNAL_CreateDevice(
 		renderer->buffersToDestroyCapacity
 	);
 
-	renderer->submittedBuffersToDestroyCapacity = 16;
-	renderer->submittedBuffersToDestroyCount = 0;
-
-	renderer->submittedBuffersToDestroy = (VulkanBuffer**) SDL_malloc(
-		sizeof(VulkanBuffer*) *
-		renderer->submittedBuffersToDestroyCapacity
-	);
-
 	renderer->graphicsPipelinesToDestroyCapacity = 16;
 	renderer->graphicsPipelinesToDestroyCount = 0;
 
@@ -9660,14 +15361,6 @@ static Refresh_Device* VULKAN_INTERNAL_CreateDevice(
 		renderer->graphicsPipelinesToDestroyCapacity
 	);
 
-	renderer->submittedGraphicsPipelinesToDestroyCapacity = 16;
-	renderer->submittedGraphicsPipelinesToDestroyCount = 0;
-
-	renderer->submittedGraphicsPipelinesToDestroy = (VulkanGraphicsPipeline**) SDL_malloc(
-		sizeof(VulkanGraphicsPipeline*) *
-		renderer->submittedGraphicsPipelinesToDestroyCapacity
-	);
-
 	renderer->computePipelinesToDestroyCapacity = 16;
 	renderer->computePipelinesToDestroyCount = 0;
 
@@ -9676,14 +15369,6 @@ static Refresh_Device* VULKAN_INTERNAL_CreateDevice(
 		renderer->computePipelinesToDestroyCapacity
 	);
 
-	renderer->submittedComputePipelinesToDestroyCapacity = 16;
-	renderer->submittedComputePipelinesToDestroyCount = 0;
-
-	renderer->submittedComputePipelinesToDestroy = (VulkanComputePipeline**) SDL_malloc(
-		sizeof(VulkanComputePipeline*) *
-		renderer->submittedComputePipelinesToDestroyCapacity
-	);
-
 	renderer->shaderModulesToDestroyCapacity = 16;
 	renderer->shaderModulesToDestroyCount = 0;
 
@@ -9692,14 +15377,6 @@ static Refresh_Device* VULKAN_INTERNAL_CreateDevice(
 		renderer->shaderModulesToDestroyCapacity
 	);
 
-	renderer->submittedShaderModulesToDestroyCapacity = 16;
-	renderer->submittedShaderModulesToDestroyCount = 0;
-
-	renderer->submittedShaderModulesToDestroy = (VkShaderModule*) SDL_malloc(
-		sizeof(VkShaderModule) *
-		renderer->submittedShaderModulesToDestroyCapacity
-	);
-
 	renderer->samplersToDestroyCapacity = 16;
 	renderer->samplersToDestroyCount = 0;
 
@@ -9708,14 +15385,6 @@ static Refresh_Device* VULKAN_INTERNAL_CreateDevice(
 		renderer->samplersToDestroyCapacity
 	);
 
-	renderer->submittedSamplersToDestroyCapacity = 16;
-	renderer->submittedSamplersToDestroyCount = 0;
-
-	renderer->submittedSamplersToDestroy = (VkSampler*) SDL_malloc(
-		sizeof(VkSampler) *
-		renderer->submittedSamplersToDestroyCapacity
-	);
-
 	renderer->framebuffersToDestroyCapacity = 16;
 	renderer->framebuffersToDestroyCount = 0;
 
@@ -9724,14 +15393,6 @@ static Refresh_Device* VULKAN_INTERNAL_CreateDevice(
 		renderer->framebuffersToDestroyCapacity
 	);
 
-	renderer->submittedFramebuffersToDestroyCapacity = 16;
-	renderer->submittedFramebuffersToDestroyCount = 0;
-
-	renderer->submittedFramebuffersToDestroy = (VulkanFramebuffer**) SDL_malloc(
-		sizeof(VulkanFramebuffer*) *
-		renderer->submittedFramebuffersToDestroyCapacity
-	);
-
 	renderer->renderPassesToDestroyCapacity = 16;
 	renderer->renderPassesToDestroyCount = 0;
 
@@ -9740,13 +15401,91 @@ static Refresh_Device* VULKAN_INTERNAL_CreateDevice(
 		renderer->renderPassesToDestroyCapacity
 	);
 
-	renderer->submittedRenderPassesToDestroyCapacity = 16;
-	renderer->submittedRenderPassesToDestroyCount = 0;
+	/* Per-frame submission tracking */
 
-	renderer->submittedRenderPassesToDestroy = (VkRenderPass*) SDL_malloc(
-		sizeof(VkRenderPass) *
-		renderer->submittedRenderPassesToDestroyCapacity
-	);
+	for (i = 0; i < renderer->framesInFlight; i += 1)
+	{
+		frame = &renderer->frames[i];
+		frame->submission = 0;
+		frame->needsCleanup = 0;
+
+		frame->submittedCommandBufferCapacity = 16;
+		frame->submittedCommandBufferCount = 0;
+		frame->submittedCommandBuffers = (VulkanCommandBuffer**) SDL_malloc(
+			sizeof(VulkanCommandBuffer*) *
+			frame->submittedCommandBufferCapacity
+		);
+
+		frame->submittedBufferCapacity = 32;
+		frame->submittedBufferCount = 0;
+		frame->submittedBuffers = (VulkanBuffer**) SDL_malloc(
+			sizeof(VulkanBuffer*) *
+			frame->submittedBufferCapacity
+		);
+
+		frame->submittedRenderTargetsToDestroyCapacity = 16;
+		frame->submittedRenderTargetsToDestroyCount = 0;
+		frame->submittedRenderTargetsToDestroy = (VulkanRenderTarget**) SDL_malloc(
+			sizeof(VulkanRenderTarget*) *
+			frame->submittedRenderTargetsToDestroyCapacity
+		);
+
+		frame->submittedTexturesToDestroyCapacity = 16;
+		frame->submittedTexturesToDestroyCount = 0;
+		frame->submittedTexturesToDestroy = (VulkanTexture**) SDL_malloc(
+			sizeof(VulkanTexture*) *
+			frame->submittedTexturesToDestroyCapacity
+		);
+
+		frame->submittedBuffersToDestroyCapacity = 16;
+		frame->submittedBuffersToDestroyCount = 0;
+		frame->submittedBuffersToDestroy = (VulkanBuffer**) SDL_malloc(
+			sizeof(VulkanBuffer*) *
+			frame->submittedBuffersToDestroyCapacity
+		);
+
+		frame->submittedGraphicsPipelinesToDestroyCapacity = 16;
+		frame->submittedGraphicsPipelinesToDestroyCount = 0;
+		frame->submittedGraphicsPipelinesToDestroy = (VulkanGraphicsPipeline**) SDL_malloc(
+			sizeof(VulkanGraphicsPipeline*) *
+			frame->submittedGraphicsPipelinesToDestroyCapacity
+		);
+
+		frame->submittedComputePipelinesToDestroyCapacity = 16;
+		frame->submittedComputePipelinesToDestroyCount = 0;
+		frame->submittedComputePipelinesToDestroy = (VulkanComputePipeline**) SDL_malloc(
+			sizeof(VulkanComputePipeline*) *
+			frame->submittedComputePipelinesToDestroyCapacity
+		);
+
+		frame->submittedShaderModulesToDestroyCapacity = 16;
+		frame->submittedShaderModulesToDestroyCount = 0;
+		frame->submittedShaderModulesToDestroy = (VkShaderModule*) SDL_malloc(
+			sizeof(VkShaderModule) *
+			frame->submittedShaderModulesToDestroyCapacity
+		);
+
+		frame->submittedSamplersToDestroyCapacity = 16;
+		frame->submittedSamplersToDestroyCount = 0;
+		frame->submittedSamplersToDestroy = (VkSampler*) SDL_malloc(
+			sizeof(VkSampler) *
+			frame->submittedSamplersToDestroyCapacity
+		);
+
+		frame->submittedFramebuffersToDestroyCapacity = 16;
+		frame->submittedFramebuffersToDestroyCount = 0;
+		frame->submittedFramebuffersToDestroy = (VulkanFramebuffer**) SDL_malloc(
+			sizeof(VulkanFramebuffer*) *
+			frame->submittedFramebuffersToDestroyCapacity
+		);
+
+		frame->submittedRenderPassesToDestroyCapacity = 16;
+		frame->submittedRenderPassesToDestroyCount = 0;
+		frame->submittedRenderPassesToDestroy = (VkRenderPass*) SDL_malloc(
+			sizeof(VkRenderPass) *
+			frame->submittedRenderPassesToDestroyCapacity
+		);
+	}
 
 	renderer->frameIndex = 0;
 
@@ -9758,6 +15497,20 @@ static Refresh_Device* VULKAN_CreateDevice(
 	uint8_t debugMode
 ) {
 	VulkanRenderer *renderer = (VulkanRenderer*) SDL_malloc(sizeof(VulkanRenderer));
+	const char *memoryBudgetExtensionName = VK_EXT_MEMORY_BUDGET_EXTENSION_NAME;
+	const char *multiDrawExtensionName = VK_EXT_MULTI_DRAW_EXTENSION_NAME;
+	const char *bindlessExtensionNames[] =
+	{
+		VK_KHR_MAINTENANCE3_EXTENSION_NAME,
+		VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME
+	};
+	VkPhysicalDeviceMultiDrawFeaturesEXT multiDrawFeatures;
+	VkPhysicalDeviceDescriptorIndexingFeaturesEXT descriptorIndexingFeatures;
+	VkPhysicalDeviceDescriptorIndexingPropertiesEXT descriptorIndexingProperties;
+	VkPhysicalDeviceFeatures2KHR features;
+	VkPhysicalDeviceProperties2 properties;
+	const char **enabledDeviceExtensionNames;
+	uint32_t enabledDeviceExtensionCount;
 
 	VULKAN_INTERNAL_LoadEntryPoints(renderer);
 
@@ -9774,6 +15527,27 @@ static Refresh_Device* VULKAN_CreateDevice(
 	renderer->headless = presentationParameters->deviceWindowHandle == NULL;
 	renderer->usesExternalDevice = 0;
 
+	if (presentationParameters->framesInFlight == 0)
+	{
+		renderer->framesInFlight = DEFAULT_FRAMES_IN_FLIGHT;
+	}
+	else if (	presentationParameters->framesInFlight < 2 ||
+			presentationParameters->framesInFlight > MAX_FRAMES_IN_FLIGHT	)
+	{
+		Refresh_LogWarn(
+			"framesInFlight must be between 2 and %d, clamping",
+			MAX_FRAMES_IN_FLIGHT
+		);
+		renderer->framesInFlight = SDL_min(
+			SDL_max(presentationParameters->framesInFlight, 2),
+			MAX_FRAMES_IN_FLIGHT
+		);
+	}
+	else
+	{
+		renderer->framesInFlight = presentationParameters->framesInFlight;
+	}
+
 	/*
 	 * Create the WSI vkSurface
 	 */
@@ -9815,6 +15589,125 @@ static Refresh_Device* VULKAN_CreateDevice(
 		return NULL;
 	}
 
+	/* Optional extensions are appended after the required ones */
+	enabledDeviceExtensionNames = SDL_stack_alloc(const char*, deviceExtensionCount + 4);
+	SDL_memcpy(
+		enabledDeviceExtensionNames,
+		deviceExtensionNames,
+		sizeof(const char*) * deviceExtensionCount
+	);
+	enabledDeviceExtensionCount = deviceExtensionCount;
+
+	renderer->supportsMemoryBudget = VULKAN_INTERNAL_CheckDeviceExtensions(
+		renderer,
+		renderer->physicalDevice,
+		&memoryBudgetExtensionName,
+		1
+	);
+	if (renderer->supportsMemoryBudget)
+	{
+		enabledDeviceExtensionNames[enabledDeviceExtensionCount++] =
+			memoryBudgetExtensionName;
+	}
+
+	renderer->supportsMultiDraw = VULKAN_INTERNAL_CheckDeviceExtensions(
+		renderer,
+		renderer->physicalDevice,
+		&multiDrawExtensionName,
+		1
+	);
+	if (renderer->supportsMultiDraw)
+	{
+		multiDrawFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MULTI_DRAW_FEATURES_EXT;
+		multiDrawFeatures.pNext = NULL;
+
+		features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR;
+		features.pNext = &multiDrawFeatures;
+
+		renderer->vkGetPhysicalDeviceFeatures2KHR(
+			renderer->physicalDevice,
+			&features
+		);
+
+		renderer->supportsMultiDraw = multiDrawFeatures.multiDraw;
+	}
+	if (renderer->supportsMultiDraw)
+	{
+		enabledDeviceExtensionNames[enabledDeviceExtensionCount++] =
+			multiDrawExtensionName;
+	}
+
+	renderer->supportsBindless = 0;
+	if (presentationParameters->bindless)
+	{
+		if (VULKAN_INTERNAL_CheckDeviceExtensions(
+			renderer,
+			renderer->physicalDevice,
+			bindlessExtensionNames,
+			SDL_arraysize(bindlessExtensionNames)
+		)) {
+			descriptorIndexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+			descriptorIndexingFeatures.pNext = NULL;
+
+			features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR;
+			features.pNext = &descriptorIndexingFeatures;
+
+			renderer->vkGetPhysicalDeviceFeatures2KHR(
+				renderer->physicalDevice,
+				&features
+			);
+
+			/* The global set is bound after the four graphics sets */
+			renderer->supportsBindless = (
+				descriptorIndexingFeatures.shaderSampledImageArrayNonUniformIndexing &&
+				descriptorIndexingFeatures.descriptorBindingSampledImageUpdateAfterBind &&
+				descriptorIndexingFeatures.descriptorBindingUpdateUnusedWhilePending &&
+				descriptorIndexingFeatures.descriptorBindingPartiallyBound &&
+				descriptorIndexingFeatures.runtimeDescriptorArray &&
+				renderer->physicalDeviceProperties.properties.limits.maxBoundDescriptorSets >= 5
+			);
+		}
+
+		if (renderer->supportsBindless)
+		{
+			enabledDeviceExtensionNames[enabledDeviceExtensionCount++] =
+				bindlessExtensionNames[0];
+			enabledDeviceExtensionNames[enabledDeviceExtensionCount++] =
+				bindlessExtensionNames[1];
+
+			descriptorIndexingProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES_EXT;
+			descriptorIndexingProperties.pNext = NULL;
+
+			properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+			properties.pNext = &descriptorIndexingProperties;
+
+			renderer->vkGetPhysicalDeviceProperties2KHR(
+				renderer->physicalDevice,
+				&properties
+			);
+
+			/* Per-stage limits also count the per-pipeline sampler sets */
+			renderer->bindlessTextureIndices.capacity = SDL_min(
+				BINDLESS_TEXTURE_COUNT,
+				SDL_min(
+					descriptorIndexingProperties.maxDescriptorSetUpdateAfterBindSampledImages,
+					descriptorIndexingProperties.maxPerStageDescriptorUpdateAfterBindSampledImages - MAX_TOTAL_SAMPLERS
+				)
+			);
+			renderer->bindlessSamplerIndices.capacity = SDL_min(
+				BINDLESS_SAMPLER_COUNT,
+				SDL_min(
+					descriptorIndexingProperties.maxDescriptorSetUpdateAfterBindSamplers,
+					descriptorIndexingProperties.maxPerStageDescriptorUpdateAfterBindSamplers - MAX_TOTAL_SAMPLERS
+				)
+			);
+		}
+		else
+		{
+			Refresh_LogWarn("Descriptor indexing is unsupported, bindless is disabled");
+		}
+	}
+
 	Refresh_LogInfo("Refresh Driver: Vulkan");
 	Refresh_LogInfo(
 		"Vulkan Device: %s",
@@ -9841,13 +15734,16 @@ static Refresh_Device* VULKAN_CreateDevice(
 
 	if (!VULKAN_INTERNAL_CreateLogicalDevice(
 		renderer,
-		deviceExtensionNames,
-		deviceExtensionCount
+		enabledDeviceExtensionNames,
+		enabledDeviceExtensionCount
 	)) {
 		Refresh_LogError("Failed to create logical device");
+		SDL_stack_free(enabledDeviceExtensionNames);
 		return NULL;
 	}
 
+	SDL_stack_free(enabledDeviceExtensionNames);
+
 	return VULKAN_INTERNAL_CreateDevice(renderer);
 }
 
@@ -9869,6 +15765,13 @@ static Refresh_Device* VULKAN_CreateDeviceUsingExternal(
 	renderer->debugMode = debugMode;
 	renderer->headless = 1;
 	renderer->usesExternalDevice = 1;
+	renderer->framesInFlight = DEFAULT_FRAMES_IN_FLIGHT;
+
+	/* We can't know which extensions the application enabled */
+	renderer->supportsMemoryBudget = 0;
+	renderer->supportsMultiDrawIndirect = 0;
+	renderer->supportsMultiDraw = 0;
+	renderer->supportsBindless = 0;
 
 	VULKAN_INTERNAL_LoadEntryPoints(renderer);
 